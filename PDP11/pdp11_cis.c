@@ -88,6 +88,7 @@
 */
 
 #include "pdp11_defs.h"
+#include "pdp11_dstr.h"
 
 /* Opcode bits */
 
@@ -159,17 +160,6 @@
 #define GET_SIGN_B(ir)  GET_BIT((ir), 7)
 #define GET_Z(ir)       ((ir) == 0)
 
-/* Decimal string structure */
-
-#define DSTRLNT         4
-#define DSTRMAX         (DSTRLNT - 1)
-#define MAXDVAL         429496730                       /* 2^32 / 10 */
-
-typedef struct {
-    uint32              sign;
-    uint32              val[DSTRLNT];
-    } DSTR;
-
 static DSTR Dstr0 = { 0, {0, 0, 0, 0} };
 
 extern int32 isenable, dsenable;
@@ -178,16 +168,6 @@ extern int32 R[8], trap_req;
 
 int32 ReadDstr (int32 *dscr, DSTR *dec, int32 flag);
 void WriteDstr (int32 *dscr, DSTR *dec, int32 flag);
-int32 AddDstr (DSTR *src1, DSTR *src2, DSTR *dst, int32 cin);
-void SubDstr (DSTR *src1, DSTR *src2, DSTR *dst);
-int32 CmpDstr (DSTR *src1, DSTR *src2);
-int32 TestDstr (DSTR *dsrc);
-int32 LntDstr (DSTR *dsrc, int32 nz);
-uint32 NibbleLshift (DSTR *dsrc, int32 sc);
-uint32 NibbleRshift (DSTR *dsrc, int32 sc, uint32 cin);
-int32 WordLshift (DSTR *dsrc, int32 sc);
-void WordRshift (DSTR *dsrc, int32 sc);
-void CreateTable (DSTR *dsrc, DSTR mtable[10]);
 t_bool cis_int_test (int32 cycles, int32 oldpc, t_stat *st);
 int32 movx_setup (int32 op, int32 *arg);
 void movx_cleanup (int32 op);
@@ -334,10 +314,9 @@ int32 match, limit, mvlnt, shift;
 int32 spc, ldivd, ldivr;
 int32 arg[6];                                           /* operands */
 int32 old_PC;
-uint32 nc, digit, result;
+uint32 result;
 t_stat st;
-static DSTR accum, src1, src2, dst;
-static DSTR mptable[10];
+static DSTR src1, src2, dst;
 static DSTR Dstr1 = { 0, {0x10, 0, 0, 0} };
 
 old_PC = (PC - 2) & 0177777;                            /* original PC */
@@ -877,17 +856,7 @@ switch (op) {                                           /* case on opcode */
         dst = Dstr0;                                    /* clear result */
         if (ReadDstr (A1, &src1, op) && ReadDstr (A2, &src2, op)) {
             dst.sign = src1.sign ^ src2.sign;           /* sign of result */
-            accum = Dstr0;                              /* clear accum */
-            NibbleRshift (&src1, 1, 0);                 /* shift out sign */
-            CreateTable (&src1, mptable);               /* create *1, *2, ... */
-            for (i = 1; i < (DSTRLNT * 8); i++) {       /* 31 iterations */
-                digit = (src2.val[i / 8] >> ((i % 8) * 4)) & 0xF;
-                if (digit > 0)                          /* add in digit*mpcnd */
-                    AddDstr (&mptable[digit], &accum, &accum, 0);
-                nc = NibbleRshift (&accum, 1, 0);       /* ac right 4 */
-                NibbleRshift (&dst, 1, nc);             /* result right 4 */
-                }
-            V = TestDstr (&accum) != 0;                 /* if ovflo, set V */
+            V = MulDstr (&src1, &src2, &dst);           /* if ovflo, set V */
             }
         else V = 0;                                     /* result = 0 */
         C = 0;                                          /* C = 0 */
@@ -924,20 +893,7 @@ switch (op) {                                           /* case on opcode */
         NibbleRshift (&src1, 1, 0);                     /* right justify ops */
         NibbleRshift (&src2, 1, 0);
         if ((t = ldivd - ldivr) >= 0) {                 /* any divide to do? */
-            WordLshift (&src1, t / 8);                  /* align divr to divd */
-            NibbleLshift (&src1, t % 8);
-            CreateTable (&src1, mptable);               /* create *1, *2, ... */
-            for (i = 0; i <= t; i++) {                  /* divide loop */
-                for (digit = 9; digit > 0; digit--) {   /* find digit */
-                    if (CmpDstr (&src2, &mptable[digit]) >= 0) {
-                        SubDstr (&mptable[digit], &src2, &src2);
-                        dst.val[0] = dst.val[0] | digit;
-                        break;
-                        }                               /* end if */
-                    }                                   /* end for */
-                NibbleLshift (&src2, 1);                /* shift dividend */
-                NibbleLshift (&dst, 1);                 /* shift quotient */
-                }                                       /* end divide loop */
+            DivDstr (&src1, &src2, &dst, t);            /* divide magnitudes */
             dst.sign = src1.sign ^ src2.sign;           /* calculate sign */
             }                                           /* end if */
         V = C = 0;
@@ -1009,7 +965,7 @@ switch (op) {                                           /* case on opcode */
         else if (shift) {                               /* left shift? */
             if (WordLshift (&src1, shift / 8))          /* do word shifts */
                 V = 1;
-            if (NibbleLshift (&src1, shift % 8))        /* do nibble shifts */
+            if (NibbleLshift (&src1, shift % 8, 0))     /* do nibble shifts */
                 V = 1;
             }                                           /* end left shift */
         WriteDstr (A2, &src1, op);                      /* store result */
@@ -1078,17 +1034,8 @@ switch (op) {                                           /* case on opcode */
 
     case 053: case 073: case 0153: case 0173:
         ReadDstr (A1, &src1, op);                       /* get source */
-        V = result = 0;                                 /* clear V, result */
-        for (i = (DSTRLNT * 8) - 1; i > 0; i--) {       /* loop thru digits */
-            digit = (src1.val[i / 8] >> ((i % 8) * 4)) & 0xF;
-            if (digit || result || V) {                 /* skip initial 0's */
-                if (result >= MAXDVAL)
-                    V = 1;
-                result = (result * 10) + digit;
-                if (result < digit)
-                    V = 1;
-                }                                       /* end if */
-            }                                           /* end for */
+        V = 0;                                          /* clear V */
+        result = CvtDstrL (&src1, &V);                  /* convert magnitude */
         if (src1.sign)
             result = (~result + 1) & 0xFFFFFFFF;
         N = GET_SIGN_L (result);
@@ -1132,11 +1079,7 @@ switch (op) {                                           /* case on opcode */
         dst = Dstr0;                                    /* clear result */
         if ((dst.sign = GET_SIGN_L (result)))
             result = (~result + 1) & 0xFFFFFFFF;
-        for (i = 1; (i < (DSTRLNT * 8)) && result; i++) {
-            digit = result % 10;
-            result = result / 10;
-            dst.val[i / 8] = dst.val[i / 8] | (digit << ((i % 8) * 4));
-            }
+        CvtLDstr (result, &dst);                        /* convert magnitude */
         V = C = 0;
         WriteDstr (A1, &dst, op);                       /* write result */
         return SCPE_OK;
@@ -1296,265 +1239,6 @@ else {
 return;
 }
 
-/* Add decimal string magnitudes
-
-   Arguments:
-        s1      =       source1 decimal string
-        s2      =       source2 decimal string
-        ds      =       destination decimal string
-        cy      =       carry in
-   Output       =       1 if carry, 0 if no carry
-
-   This algorithm courtesy Anton Chernoff, circa 1992 or even earlier.
-
-   We trace the history of a pair of adjacent digits to see how the
-   carry is fixed; each parenthesized item is a 4b digit.
-
-   Assume we are adding:
-
-        (a)(b)  I
-   +    (x)(y)  J
-
-   First compute I^J:
-
-        (a^x)(b^y)      TMP
-
-   Note that the low bit of each digit is the same as the low bit of
-   the sum of the digits, ignoring the carry, since the low bit of the
-   sum is the xor of the bits.
-
-   Now compute I+J+66 to get decimal addition with carry forced left
-   one digit:
-
-        (a+x+6+carry mod 16)(b+y+6 mod 16)      SUM
-
-   Note that if there was a carry from b+y+6, then the low bit of the
-   left digit is different from the expected low bit from the xor.
-   If we xor this SUM into TMP, then the low bit of each digit is 1
-   if there was a carry, and 0 if not.  We need to subtract 6 from each
-   digit that did not have a carry, so take ~(SUM ^ TMP) & 0x11, shift
-   it right 4 to the digits that are affected, and subtract 6*adjustment
-   (actually, shift it right 3 and subtract 3*adjustment).
-*/
-
-int32 AddDstr (DSTR *s1, DSTR *s2, DSTR *ds, int32 cy)
-{
-int32 i;
-uint32 sm1, sm2, tm1, tm2, tm3, tm4;
-
-for (i = 0; i < DSTRLNT; i++) {                         /* loop low to high */
-    tm1 = s1->val[i] ^ (s2->val[i] + cy);               /* xor operands */
-    sm1 = s1->val[i] + (s2->val[i] + cy);               /* sum operands */
-    sm2 = sm1 + 0x66666666;                             /* force carry out */
-    cy = ((sm1 < s1->val[i]) || (sm2 < sm1));           /* check for overflow */
-    tm2 = tm1 ^ sm2;                                    /* get carry flags */
-    tm3 = (tm2 >> 3) | (cy << 29);                      /* compute adjustment */
-    tm4 = 0x22222222 & ~tm3;                            /* clear where carry */
-    ds->val[i] = sm2 - (3 * tm4);                       /* final result */
-    }
-return cy;
-}
-
-/* Subtract decimal string magnitudes
-
-   Arguments:
-        s1      =       source1 decimal string
-        s2      =       source2 decimal string
-        ds      =       destination decimal string
-   Outputs:             s2 - s1 in ds
-
-   Note: the routine assumes that s1 <= s2
-
-*/
-
-void SubDstr (DSTR *s1, DSTR *s2, DSTR *ds)
-{
-int32 i;
-DSTR complX;
-
-for (i = 0; i < DSTRLNT; i++)
-    complX.val[i] = 0x99999999 - s1->val[i];
-AddDstr (&complX, s2, ds, 1);                           /* s1 + ~s2 + 1 */
-return;
-}
-
-/* Compare decimal string magnitudes
-
-   Arguments:
-        s1      =       source1 decimal string
-        s2      =       source2 decimal string
-   Output       =       1 if >, 0 if =, -1 if <
-*/
-
-int32 CmpDstr (DSTR *s1, DSTR *s2)
-{
-int32 i;
-
-for (i = DSTRMAX; i >=0; i--) {
-    if (s1->val[i] > s2->val[i])
-        return 1;
-    if (s1->val[i] < s2->val[i])
-        return -1;
-    }
-return 0;
-}
-
-/* Test decimal string for zero
-
-   Arguments:
-        dsrc    =       decimal string structure
-
-   Returns the non-zero length of the string, in int32 units
-   If the string is zero, the sign is cleared
-*/
-
-int32 TestDstr (DSTR *dsrc)
-{
-int32 i;
-
-for (i = DSTRMAX; i >= 0; i--) {
-    if (dsrc->val[i])
-        return (i + 1);
-    }
-dsrc->sign = 0;
-return 0;
-}
-
-/* Get exact length of decimal string
-
-   Arguments:
-        dsrc    =       decimal string structure
-        nz      =       result from TestDstr
-*/
-
-int32 LntDstr (DSTR *dsrc, int32 nz)
-{
-int32 i;
-
-if (nz == 0)
-    return 0;
-for (i = 7; i >= 0; i--) {
-    if ((dsrc->val[nz - 1] >> (i * 4)) & 0xF)
-        break;
-    }
-return ((nz - 1) * 8) + i;
-}
-
-/* Create table of multiples
-
-   Arguments:
-        dsrc    =       base decimal string structure
-        mtable[10] =    array of decimal string structures
-
-   Note that dsrc has a high order zero nibble; this
-   guarantees that the largest multiple won't overflow.
-   Also note that mtable[0] is not filled in.
-*/
-
-void CreateTable (DSTR *dsrc, DSTR mtable[10])
-{
-int32 (i);
-
-mtable[1] = *dsrc;
-for (i = 2; i < 10; i++)
-    AddDstr (&mtable[1], &mtable[i-1], &mtable[i], 0);
-return;
-}
-
-/* Word shift right
-
-   Arguments:
-        dsrc    =       decimal string structure
-        sc      =       shift count
-*/
-
-void WordRshift (DSTR *dsrc, int32 sc)
-{
-int32 i;
-
-if (sc) {
-    for (i = 0; i < DSTRLNT; i++) {
-        if ((i + sc) < DSTRLNT)
-            dsrc->val[i] = dsrc->val[i + sc];
-        else dsrc->val[i] = 0;
-        }
-    }
-return;
-}
-
-/* Word shift left
-
-   Arguments:
-        dsrc    =       decimal string structure
-        sc      =       shift count
-*/
-
-int32 WordLshift (DSTR *dsrc, int32 sc)
-{
-int32 i, c;
-
-c = 0;
-if (sc) {
-    for (i = DSTRMAX; i >= 0; i--) {
-        if (i >= sc)
-            dsrc->val[i] = dsrc->val[i - sc];
-        else {
-            c |= dsrc->val[i];
-            dsrc->val[i] = 0;
-            }
-        }
-    }
-return c;
-}               
-
-/* Nibble shift decimal string right
-
-   Arguments:
-        dsrc    =       decimal string structure
-        sc      =       shift count
-        cin     =       carry in
-*/
-
-uint32 NibbleRshift (DSTR *dsrc, int32 sc, uint32 cin)
-{
-int32 i, s, nc;
-
-if ((s = sc * 4)) {
-    for (i = DSTRMAX; i >= 0; i--) {
-        nc = (dsrc->val[i] << (32 - s)) & 0xFFFFFFFF;
-        dsrc->val[i] = ((dsrc->val[i] >> s) |
-            cin) & 0xFFFFFFFF;
-        cin = nc;
-        }
-    return cin;
-    }
-return 0;
-}
-
-/* Nibble shift decimal string left
-
-   Arguments:
-        dsrc    =       decimal string structure
-        sc      =       shift count
-*/
-
-uint32 NibbleLshift (DSTR *dsrc, int32 sc)
-{
-int32 i, s;
-uint32 nc, cin;
-
-cin = 0;
-if ((s = sc * 4)) {
-    for (i = 0; i < DSTRLNT; i++) {
-        nc = dsrc->val[i] >> (32 - s);
-        dsrc->val[i] = ((dsrc->val[i] << s) | cin) & 0xFFFFFFFF;
-        cin = nc;
-        }
-    return cin;
-    }
-return 0;
-}
-
 /* Common setup routine for MOVC class instructions */
 
 int32 movx_setup (int32 op, int32 *arg)
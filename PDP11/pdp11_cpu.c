@@ -205,6 +205,15 @@
       as isenable and dsenable for ispace and dspace, respectively, and
       must be recalculated whenever MMR0, MMR3, or PSW<cm> changes.
 
+      The 6b mode, space, and page prefix of the pseudo virtual address
+      indexes a cache of relocations, one entry per APR.  An entry holds
+      the physical base of the page and the range of in-bounds
+      displacements, so a reference that hits is relocated without
+      examining the PAR/PDR.  Entries are loaded by the full relocation
+      routines and are invalidated when the APR, MMR0<mme>, or MMR3<m22e>
+      changes.  Because the mode is part of the index, mode changes do
+      not invalidate the cache.
+
    2. Traps and interrupts.  Variable trap_req bit-encodes all possible
       traps.  In addition, an interrupt pending bit is encoded as the
       lowest priority trap.  Traps are processed by trap_vec and trap_clear,
@@ -253,6 +262,16 @@
 #define HIST_VLD        1                               /* make PC odd */
 #define HIST_ILNT       4                               /* max inst length */
 
+#define RTB_RD          1                               /* reloc cache: read */
+#define RTB_WR          2                               /* write */
+
+typedef struct {
+    int32               lo;                             /* first valid displ */
+    int32               lnt;                            /* valid displs - 1 */
+    int32               pa;                             /* pa of displ 0 */
+    int32               acc;                            /* access allowed */
+    } RELOCTB;
+
 typedef struct {
     uint16              pc;
     uint16              psw;
@@ -293,6 +312,7 @@ int32 MMR3 = 0;                                         /* MMR3 - 22b status */
 int32 cpu_bme = 0;                                      /* bus map enable */
 int32 cpu_astop = 0;                                    /* address stop */
 int32 isenable = 0, dsenable = 0;                       /* i, d space flags */
+RELOCTB reloc_tb[64];                                   /* reloc cache */
 int32 stop_trap = 1;                                    /* stop on trap */
 int32 stop_vecabort = 1;                                /* stop on vec abort */
 int32 stop_spabort = 1;                                 /* stop on SP abort */
@@ -309,6 +329,9 @@ int32 hst_p = 0;                                        /* history pointer */
 int32 hst_lnt = 0;                                      /* history length */
 InstHistory *hst = NULL;                                /* instruction history */
 int32 dsmask[4] = { MMR3_KDS, MMR3_SDS, 0, MMR3_UDS };  /* dspace enables */
+#if defined (__GNUC__)
+uint8 cpu_dtab[1u << 10];                               /* dispatch indices */
+#endif
 int16 inst_pc;                                          /* PC of current instr */
 int32 inst_psw;                                         /* PSW at instr. start */
 int16 reg_mods;                                         /* reg deltas */
@@ -336,6 +359,11 @@ void relocR_test (int32 va, int32 apridx);
 void relocW_test (int32 va, int32 apridx);
 t_bool PLF_test (int32 va, int32 apr);
 void reloc_abort (int32 err, int32 apridx);
+void reloc_load (int32 apridx);
+void reloc_flush (void);
+#if defined (__GNUC__)
+void cpu_build_dtab (void);
+#endif
 int32 ReadE (int32 addr);
 int32 ReadW (int32 addr);
 int32 ReadB (int32 addr);
@@ -699,6 +727,49 @@ t_stat sim_instr (void)
 int abortval, i;
 volatile int32 trapea;                                  /* used by setjmp */
 InstHistory *hst_ent = NULL;
+#if defined (__GNUC__)
+static void *cpu_disp[] = {
+    /* opcode 00, IR<11:6> */
+    &&op_npn, &&op_jmp, &&op_rts, &&op_swab,            /* 000 - 003 */
+    &&op_br_f, &&op_br_f, &&op_br_b, &&op_br_b,         /* 004 - 007 */
+    &&op_bne_f, &&op_bne_f, &&op_bne_b, &&op_bne_b,     /* 010 - 013 */
+    &&op_beq_f, &&op_beq_f, &&op_beq_b, &&op_beq_b,     /* 014 - 017 */
+    &&op_bge_f, &&op_bge_f, &&op_bge_b, &&op_bge_b,     /* 020 - 023 */
+    &&op_blt_f, &&op_blt_f, &&op_blt_b, &&op_blt_b,     /* 024 - 027 */
+    &&op_bgt_f, &&op_bgt_f, &&op_bgt_b, &&op_bgt_b,     /* 030 - 033 */
+    &&op_ble_f, &&op_ble_f, &&op_ble_b, &&op_ble_b,     /* 034 - 037 */
+    &&op_jsr, &&op_jsr, &&op_jsr, &&op_jsr,             /* 040 - 043 */
+    &&op_jsr, &&op_jsr, &&op_jsr, &&op_jsr,             /* 044 - 047 */
+    &&op_clr, &&op_com, &&op_inc, &&op_dec,             /* 050 - 053 */
+    &&op_neg, &&op_adc, &&op_sbc, &&op_tst,             /* 054 - 057 */
+    &&op_ror, &&op_rol, &&op_asr, &&op_asl,             /* 060 - 063 */
+    &&op_mark, &&op_mfpi, &&op_mtpi, &&op_sxt,          /* 064 - 067 */
+    &&op_csm, &&op_ill, &&op_tstset, &&op_wrtlck,       /* 070 - 073 */
+    &&op_ill, &&op_ill, &&op_ill, &&op_ill,             /* 074 - 077 */
+    /* opcode 10, IR<11:6> */
+    &&op_bpl_f, &&op_bpl_f, &&op_bpl_b, &&op_bpl_b,     /* 000 - 003 */
+    &&op_bmi_f, &&op_bmi_f, &&op_bmi_b, &&op_bmi_b,     /* 004 - 007 */
+    &&op_bhi_f, &&op_bhi_f, &&op_bhi_b, &&op_bhi_b,     /* 010 - 013 */
+    &&op_blos_f, &&op_blos_f, &&op_blos_b, &&op_blos_b, /* 014 - 017 */
+    &&op_bvc_f, &&op_bvc_f, &&op_bvc_b, &&op_bvc_b,     /* 020 - 023 */
+    &&op_bvs_f, &&op_bvs_f, &&op_bvs_b, &&op_bvs_b,     /* 024 - 027 */
+    &&op_bcc_f, &&op_bcc_f, &&op_bcc_b, &&op_bcc_b,     /* 030 - 033 */
+    &&op_bcs_f, &&op_bcs_f, &&op_bcs_b, &&op_bcs_b,     /* 034 - 037 */
+    &&op_emt, &&op_emt, &&op_emt, &&op_emt,             /* 040 - 043 */
+    &&op_trap, &&op_trap, &&op_trap, &&op_trap,         /* 044 - 047 */
+    &&op_clrb, &&op_comb, &&op_incb, &&op_decb,         /* 050 - 053 */
+    &&op_negb, &&op_adcb, &&op_sbcb, &&op_tstb,         /* 054 - 057 */
+    &&op_rorb, &&op_rolb, &&op_asrb, &&op_aslb,         /* 060 - 063 */
+    &&op_mtps, &&op_mfpd, &&op_mtpd, &&op_mfps,         /* 064 - 067 */
+    &&op_illb, &&op_illb, &&op_illb, &&op_illb,         /* 070 - 073 */
+    &&op_illb, &&op_illb, &&op_illb, &&op_illb,         /* 074 - 077 */
+    /* other opcodes, IR<15:12> */
+    NULL, &&op_mov, &&op_cmp, &&op_bit,                 /* 00 - 03 */
+    &&op_bic, &&op_bis, &&op_add, &&op_eis,             /* 04 - 07 */
+    NULL, &&op_movb, &&op_cmpb, &&op_bitb,              /* 10 - 13 */
+    &&op_bicb, &&op_bisb, &&op_sub, &&op_fp             /* 14 - 17 */
+    };
+#endif
 
 sim_vm_pc_value = &pdp11_pc_value;
 
@@ -725,6 +796,7 @@ for (i = 0; i < 6; i++)
 SP = STACKFILE[cm];
 isenable = calc_is (cm);
 dsenable = calc_ds (cm);
+reloc_flush ();                                         /* APRs may be changed */
 put_PIRQ (PIRQ);                                        /* rewrite PIRQ */
 STKLIM = STKLIM & STKLIM_RW;                            /* clean up STKLIM */
 MMR0 = MMR0 | MMR0_IC;                                  /* usually on */
@@ -977,6 +1049,9 @@ while (reason == 0)  {
             hst_p = 0;
         }
     PC = (PC + 2) & 0177777;                            /* incr PC, mod 65k */
+#if defined (__GNUC__)
+    goto *cpu_disp[cpu_dtab[IR >> 6]];                  /* threaded dispatch */
+#endif
     switch ((IR >> 12) & 017) {                         /* decode IR<15:12> */
 
 /* Opcode 0: no operands, specials, branches, JSR, SOPs */
@@ -984,6 +1059,7 @@ while (reason == 0)  {
     case 000:
         switch ((IR >> 6) & 077) {                      /* decode IR<11:6> */
         case 000:                                       /* no operand */
+        op_npn:
             if (IR >= 000010) {                         /* 000010 - 000077 */
                 setTRAP (TRAP_ILL);                     /* illegal */
                 break;
@@ -1020,6 +1096,7 @@ while (reason == 0)  {
                         int_req[i] = 0;
                     trap_req = trap_req & ~TRAP_INT;
                     dsenable = calc_ds (cm);
+                    reloc_flush ();                     /* mmgt now off */
                     }
                 break;
             case 6:                                     /* RTT */
@@ -1057,6 +1134,7 @@ while (reason == 0)  {
             break;                                      /* end case no ops */
 
         case 001:                                       /* JMP */
+        op_jmp:
             if (dstreg)
                 setTRAP (CPUT (HAS_JREG4)? TRAP_PRV: TRAP_ILL);
             else {
@@ -1071,6 +1149,7 @@ while (reason == 0)  {
             break;                                      /* end JMP */
 
         case 002:                                       /* RTS et al*/
+        op_rts:
             if (IR < 000210) {                          /* RTS */
                 dstspec = dstspec & 07;
                 if (hst_ent)
@@ -1116,6 +1195,7 @@ while (reason == 0)  {
             break;                                      /* end case RTS et al */
 
         case 003:                                       /* SWAB */
+        op_swab:
             dst = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = ((dst & 0377) << 8) | ((dst >> 8) & 0377);
             N = GET_SIGN_B (dst & 0377);
@@ -1131,78 +1211,92 @@ while (reason == 0)  {
             break;                                      /* end SWAB */
 
         case 004: case 005:                             /* BR */
+        op_br_f:
             BRANCH_F (IR);
             break;
 
         case 006: case 007:                             /* BR */
+        op_br_b:
             BRANCH_B (IR);
             break;
 
         case 010: case 011:                             /* BNE */
+        op_bne_f:
             if (Z == 0) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 012: case 013:                             /* BNE */
+        op_bne_b:
             if (Z == 0) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 014: case 015:                             /* BEQ */
+        op_beq_f:
             if (Z) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 016: case 017:                             /* BEQ */
+        op_beq_b:
             if (Z) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 020: case 021:                             /* BGE */
+        op_bge_f:
             if ((N ^ V) == 0) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 022: case 023:                             /* BGE */
+        op_bge_b:
             if ((N ^ V) == 0) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 024: case 025:                             /* BLT */
+        op_blt_f:
             if (N ^ V) {
                 BRANCH_F (IR);
                 }
             break;
 
         case 026: case 027:                             /* BLT */
+        op_blt_b:
             if (N ^ V) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 030: case 031:                             /* BGT */
+        op_bgt_f:
             if ((Z | (N ^ V)) == 0) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 032: case 033:                             /* BGT */
+        op_bgt_b:
             if ((Z | (N ^ V)) == 0) { BRANCH_B (IR); }
             break;
 
         case 034: case 035:                             /* BLE */
+        op_ble_f:
             if (Z | (N ^ V)) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 036: case 037:                             /* BLE */
+        op_ble_b:
             if (Z | (N ^ V)) {
                 BRANCH_B (IR);
                 }
@@ -1210,6 +1304,7 @@ while (reason == 0)  {
 
         case 040: case 041: case 042: case 043:         /* JSR */
         case 044: case 045: case 046: case 047:
+        op_jsr:
             if (dstreg)
                 setTRAP (CPUT (HAS_JREG4)? TRAP_PRV: TRAP_ILL);
             else {
@@ -1233,6 +1328,7 @@ while (reason == 0)  {
             break;                                      /* end JSR */
 
         case 050:                                       /* CLR */
+        op_clr:
             N = V = C = 0;
             Z = 1;
             if (hst_ent)
@@ -1243,6 +1339,7 @@ while (reason == 0)  {
             break;
 
         case 051:                                       /* COM */
+        op_com:
             dst = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = dst ^ 0177777;
             N = GET_SIGN_W (dst);
@@ -1257,6 +1354,7 @@ while (reason == 0)  {
             break;
 
         case 052:                                       /* INC */
+        op_inc:
             dst = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = (dst + 1) & 0177777;
             N = GET_SIGN_W (dst);
@@ -1270,6 +1368,7 @@ while (reason == 0)  {
             break;
 
         case 053:                                       /* DEC */
+        op_dec:
             dst = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = (dst - 1) & 0177777;
             N = GET_SIGN_W (dst);
@@ -1283,6 +1382,7 @@ while (reason == 0)  {
             break;
 
         case 054:                                       /* NEG */
+        op_neg:
             dst = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = (-dst) & 0177777;
             N = GET_SIGN_W (dst);
@@ -1297,6 +1397,7 @@ while (reason == 0)  {
             break;
 
         case 055:                                       /* ADC */
+        op_adc:
             dst = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = (dst + C) & 0177777;
             N = GET_SIGN_W (dst);
@@ -1311,6 +1412,7 @@ while (reason == 0)  {
             break;
 
         case 056:                                       /* SBC */
+        op_sbc:
             dst = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = (dst - C) & 0177777;
             N = GET_SIGN_W (dst);
@@ -1325,6 +1427,7 @@ while (reason == 0)  {
             break;
 
         case 057:                                       /* TST */
+        op_tst:
             dst = dstreg? R[dstspec]: ReadW (GeteaW (dstspec));
             if (hst_ent)
                 hst_ent->dst = dst;
@@ -1334,6 +1437,7 @@ while (reason == 0)  {
             break;
 
         case 060:                                       /* ROR */
+        op_ror:
             src = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = (src >> 1) | (C << 15);
             N = GET_SIGN_W (dst);
@@ -1348,6 +1452,7 @@ while (reason == 0)  {
             break;
 
         case 061:                                       /* ROL */
+        op_rol:
             src = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = ((src << 1) | C) & 0177777;
             N = GET_SIGN_W (dst);
@@ -1362,6 +1467,7 @@ while (reason == 0)  {
             break;
 
         case 062:                                       /* ASR */
+        op_asr:
             src = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = (src >> 1) | (src & 0100000);
             N = GET_SIGN_W (dst);
@@ -1376,6 +1482,7 @@ while (reason == 0)  {
             break;
 
         case 063:                                       /* ASL */
+        op_asl:
             src = dstreg? R[dstspec]: ReadMW (GeteaW (dstspec));
             dst = (src << 1) & 0177777;
             N = GET_SIGN_W (dst);
@@ -1395,6 +1502,7 @@ while (reason == 0)  {
 */
 
         case 064:                                       /* MARK */
+        op_mark:
             if (CPUT (HAS_MARK)) {
                 i = (PC + dstspec + dstspec) & 0177777;
                 JMP_PC (R[5]);
@@ -1405,6 +1513,7 @@ while (reason == 0)  {
             break;
 
         case 065:                                       /* MFPI */
+        op_mfpi:
             if (CPUT (HAS_MXPY)) {
                 if (dstreg) {
                     if ((dstspec == 6) && (cm != pm))
@@ -1432,6 +1541,7 @@ while (reason == 0)  {
             break;
 
         case 066:                                       /* MTPI */
+        op_mtpi:
             if (CPUT (HAS_MXPY)) {
                 dst = ReadW (SP | dsenable);
                 N = GET_SIGN_W (dst);
@@ -1453,6 +1563,7 @@ while (reason == 0)  {
             break;
 
         case 067:                                       /* SXT */
+        op_sxt:
             if (CPUT (HAS_SXS)) {
                 dst = N? 0177777: 0;
                 Z = N ^ 1;
@@ -1467,6 +1578,7 @@ while (reason == 0)  {
             break;
 
         case 070:                                       /* CSM */
+        op_csm:
             if (CPUT (HAS_CSM) && (MMR3 & MMR3_CSM) && (cm != MD_KER)) {
                 dst = dstreg? R[dstspec]: ReadW (GeteaW (dstspec));
                 PSW = get_PSW () & ~PSW_CC;             /* PSW, cc = 0 */
@@ -1486,6 +1598,7 @@ while (reason == 0)  {
             break;
 
         case 072:                                       /* TSTSET */
+        op_tstset:
             if (CPUT (HAS_TSWLK) && !dstreg) {
                 dst = ReadMW (GeteaW (dstspec));
                 N = GET_SIGN_W (dst);
@@ -1501,6 +1614,7 @@ while (reason == 0)  {
             break;
 
         case 073:                                       /* WRTLCK */
+        op_wrtlck:
             if (CPUT (HAS_TSWLK) && !dstreg) {
                 N = GET_SIGN_W (R[0]);
                 Z = GET_Z (R[0]);
@@ -1513,6 +1627,7 @@ while (reason == 0)  {
             break;
 
         default:
+        op_ill:
             setTRAP (TRAP_ILL);
             break;
             }                                           /* end switch SOPs */
@@ -1530,6 +1645,7 @@ while (reason == 0)  {
 */
 
     case 001:                                           /* MOV */
+    op_mov:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             ea = GeteaW (dstspec);
             dst = R[srcspec];
@@ -1552,6 +1668,7 @@ while (reason == 0)  {
         break;
 
     case 002:                                           /* CMP */
+    op_cmp:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadW (GeteaW (dstspec));
             src = R[srcspec];
@@ -1572,6 +1689,7 @@ while (reason == 0)  {
         break;
 
     case 003:                                           /* BIT */
+    op_bit:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadW (GeteaW (dstspec));
             src = R[srcspec];
@@ -1591,6 +1709,7 @@ while (reason == 0)  {
         break;
 
     case 004:                                           /* BIC */
+    op_bic:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadMW (GeteaW (dstspec));
             src = R[srcspec];
@@ -1613,6 +1732,7 @@ while (reason == 0)  {
         break;
 
     case 005:                                           /* BIS */
+    op_bis:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadMW (GeteaW (dstspec));
             src = R[srcspec];
@@ -1635,6 +1755,7 @@ while (reason == 0)  {
         break;
 
     case 006:                                           /* ADD */
+    op_add:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadMW (GeteaW (dstspec));
             src = R[srcspec];
@@ -1675,6 +1796,7 @@ while (reason == 0)  {
 */
 
     case 007:
+    op_eis:
         srcspec = srcspec & 07;
         switch ((IR >> 9) & 07)  {                      /* decode IR<11:9> */
 
@@ -1884,110 +2006,129 @@ while (reason == 0)  {
         switch ((IR >> 6) & 077) {                      /* decode IR<11:6> */
 
         case 000: case 001:                             /* BPL */
+        op_bpl_f:
             if (N == 0) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 002: case 003:                             /* BPL */
+        op_bpl_b:
             if (N == 0) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 004: case 005:                             /* BMI */
+        op_bmi_f:
             if (N) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 006: case 007:                             /* BMI */
+        op_bmi_b:
             if (N) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 010: case 011:                             /* BHI */
+        op_bhi_f:
             if ((C | Z) == 0) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 012: case 013:                             /* BHI */
+        op_bhi_b:
             if ((C | Z) == 0) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 014: case 015:                             /* BLOS */
+        op_blos_f:
             if (C | Z) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 016: case 017:                             /* BLOS */
+        op_blos_b:
             if (C | Z) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 020: case 021:                             /* BVC */
+        op_bvc_f:
             if (V == 0) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 022: case 023:                             /* BVC */
+        op_bvc_b:
             if (V == 0) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 024: case 025:                             /* BVS */
+        op_bvs_f:
             if (V) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 026: case 027:                             /* BVS */
+        op_bvs_b:
             if (V) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 030: case 031:                             /* BCC */
+        op_bcc_f:
             if (C == 0) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 032: case 033:                             /* BCC */
+        op_bcc_b:
             if (C == 0) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 034: case 035:                             /* BCS */
+        op_bcs_f:
             if (C) {
                 BRANCH_F (IR);
                 } 
             break;
 
         case 036: case 037:                             /* BCS */
+        op_bcs_b:
             if (C) {
                 BRANCH_B (IR);
                 }
             break;
 
         case 040: case 041: case 042: case 043:         /* EMT */
+        op_emt:
             setTRAP (TRAP_EMT);
             break;
 
         case 044: case 045: case 046: case 047:         /* TRAP */
+        op_trap:
             setTRAP (TRAP_TRAP);
             break;
 
         case 050:                                       /* CLRB */
+        op_clrb:
             N = V = C = 0;
             Z = 1;
             if (dstreg)
@@ -2001,6 +2142,7 @@ while (reason == 0)  {
             break;
 
         case 051:                                       /* COMB */
+        op_comb:
             dst = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = (dst ^ 0377) & 0377;
             N = GET_SIGN_B (dst);
@@ -2018,6 +2160,7 @@ while (reason == 0)  {
             break;
 
         case 052:                                       /* INCB */
+        op_incb:
             dst = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = (dst + 1) & 0377;
             N = GET_SIGN_B (dst);
@@ -2034,6 +2177,7 @@ while (reason == 0)  {
             break;
 
         case 053:                                       /* DECB */
+        op_decb:
             dst = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = (dst - 1) & 0377;
             N = GET_SIGN_B (dst);
@@ -2050,6 +2194,7 @@ while (reason == 0)  {
             break;
 
         case 054:                                       /* NEGB */
+        op_negb:
             dst = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = (-dst) & 0377;
             N = GET_SIGN_B (dst);
@@ -2067,6 +2212,7 @@ while (reason == 0)  {
             break;
 
         case 055:                                       /* ADCB */
+        op_adcb:
             dst = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = (dst + C) & 0377;
             N = GET_SIGN_B (dst);
@@ -2084,6 +2230,7 @@ while (reason == 0)  {
             break;
 
         case 056:                                       /* SBCB */
+        op_sbcb:
             dst = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = (dst - C) & 0377;
             N = GET_SIGN_B (dst);
@@ -2101,6 +2248,7 @@ while (reason == 0)  {
             break;
 
         case 057:                                       /* TSTB */
+        op_tstb:
             dst = dstreg? R[dstspec] & 0377: ReadB (GeteaB (dstspec));
             if (hst_ent)
                 hst_ent->dst = dst;
@@ -2110,6 +2258,7 @@ while (reason == 0)  {
             break;
 
         case 060:                                       /* RORB */
+        op_rorb:
             src = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = ((src & 0377) >> 1) | (C << 7);
             N = GET_SIGN_B (dst);
@@ -2127,6 +2276,7 @@ while (reason == 0)  {
             break;
 
         case 061:                                       /* ROLB */
+        op_rolb:
             src = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = ((src << 1) | C) & 0377;
             N = GET_SIGN_B (dst);
@@ -2144,6 +2294,7 @@ while (reason == 0)  {
             break;
 
         case 062:                                       /* ASRB */
+        op_asrb:
             src = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = ((src & 0377) >> 1) | (src & 0200);
             N = GET_SIGN_B (dst);
@@ -2161,6 +2312,7 @@ while (reason == 0)  {
             break;
 
         case 063:                                       /* ASLB */
+        op_aslb:
             src = dstreg? R[dstspec]: ReadMB (GeteaB (dstspec));
             dst = (src << 1) & 0377;
             N = GET_SIGN_B (dst);
@@ -2184,6 +2336,7 @@ while (reason == 0)  {
 */
 
         case 064:                                       /* MTPS */
+        op_mtps:
             if (CPUT (HAS_MXPS)) {
                 dst = dstreg? R[dstspec]: ReadB (GeteaB (dstspec));
                 if (cm == MD_KER) {
@@ -2199,6 +2352,7 @@ while (reason == 0)  {
             break;
 
         case 065:                                       /* MFPD */
+        op_mfpd:
             if (CPUT (HAS_MXPY)) {
                 if (dstreg) {
                     if ((dstspec == 6) && (cm != pm))
@@ -2223,6 +2377,7 @@ while (reason == 0)  {
             break;
 
         case 066:                                       /* MTPD */
+        op_mtpd:
             if (CPUT (HAS_MXPY)) {
                 dst = ReadW (SP | dsenable);
                 N = GET_SIGN_W (dst);
@@ -2245,6 +2400,7 @@ while (reason == 0)  {
             break;
 
         case 067:                                       /* MFPS */
+        op_mfps:
             if (CPUT (HAS_MXPS)) {
                 dst = get_PSW () & 0377;
                 N = GET_SIGN_B (dst);
@@ -2258,6 +2414,7 @@ while (reason == 0)  {
             break;
 
         default:
+        op_illb:
             setTRAP (TRAP_ILL);
             break;
             }                                           /* end switch SOPs */
@@ -2270,6 +2427,7 @@ while (reason == 0)  {
 */
 
     case 011:                                           /* MOVB */
+    op_movb:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             ea = GeteaB (dstspec);
             dst = R[srcspec] & 0377;
@@ -2292,6 +2450,7 @@ while (reason == 0)  {
         break;
 
     case 012:                                           /* CMPB */
+    op_cmpb:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadB (GeteaB (dstspec));
             src = R[srcspec] & 0377;
@@ -2312,6 +2471,7 @@ while (reason == 0)  {
         break;
 
     case 013:                                           /* BITB */
+    op_bitb:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadB (GeteaB (dstspec));
             src = R[srcspec] & 0377;
@@ -2331,6 +2491,7 @@ while (reason == 0)  {
         break;
 
     case 014:                                           /* BICB */
+    op_bicb:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadMB (GeteaB (dstspec));
             src = R[srcspec];
@@ -2353,6 +2514,7 @@ while (reason == 0)  {
         break;
 
     case 015:                                           /* BISB */
+    op_bisb:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadMB (GeteaB (dstspec));
             src = R[srcspec];
@@ -2375,6 +2537,7 @@ while (reason == 0)  {
         break;
 
     case 016:                                           /* SUB */
+    op_sub:
         if (CPUT (IS_SDSD) && srcreg && !dstreg) {      /* R,not R */
             src2 = ReadMW (GeteaW (dstspec));
             src = R[srcspec];
@@ -2400,6 +2563,7 @@ while (reason == 0)  {
 /* Opcode 17: floating point */
 
     case 017:
+    op_fp:
         if (CPUO (OPT_FPP))
             fp11 (IR);                  /* call fpp */
         else setTRAP (TRAP_ILL);
@@ -2419,6 +2583,35 @@ set_r_display (rs, cm);
 return reason;
 }
 
+#if defined (__GNUC__)
+
+/* Build threaded dispatch table
+
+   The table gives, for each value of IR<15:6>, the index in cpu_disp of
+   the case in the decode switch that executes it; the decode never
+   looks at IR<5:0> before reaching a case.  Opcodes 00 and 10 are
+   indexed by IR<11:6>, the other opcodes by IR<15:12>.  The model
+   and option checks stay in the case code, which selects the trap that
+   an unimplemented instruction takes on each model, so the table is
+   the same for every model.
+*/
+
+void cpu_build_dtab (void)
+{
+uint32 op;                                              /* IR<15:6> */
+
+for (op = 0; op < (1u << 10); op++) {
+    if ((op >> 6) == 000)                               /* opcode 00? */
+        cpu_dtab[op] = op & 077;
+    else if ((op >> 6) == 010)                          /* opcode 10? */
+        cpu_dtab[op] = 0100 | (op & 077);
+    else cpu_dtab[op] = 0200 | (op >> 6);               /* others */
+    }
+return;
+}
+
+#endif
+
 /* Effective address calculations
 
    Inputs:
@@ -2829,6 +3022,7 @@ return;
    with an appropriate trap code.
 
    Notes:
+   - References that hit in the relocation cache are done in-line
    - The 'normal' read codes (010, 110) are done in-line; all
      others in a subroutine
    - APRFILE[UNUSED] is all zeroes, forcing non-resident abort
@@ -2838,7 +3032,11 @@ return;
 int32 relocR (int32 va)
 {
 int32 apridx, apr, pa;
+RELOCTB *tb = &reloc_tb[(va >> VA_V_APF) & 077];
 
+if ((tb->acc & RTB_RD) &&                               /* cache hit? */
+    (((uint32) ((va & VA_DF) - tb->lo)) <= ((uint32) tb->lnt)))
+    return tb->pa + (va & VA_DF);
 if (MMR0 & MMR0_MME) {                                  /* if mmgt */
     apridx = (va >> VA_V_APF) & 077;                    /* index into APR */
     apr = APRFILE[apridx];                              /* with va<18:13> */
@@ -2858,6 +3056,7 @@ else {
     if (pa >= 0160000)
         pa = 017600000 | pa;
     }
+reloc_load ((va >> VA_V_APF) & 077);                    /* load cache */
 return pa;
 }
 
@@ -2936,6 +3135,7 @@ return;
    with an appropriate trap code.
 
    Notes:
+   - References that hit in the relocation cache are done in-line
    - The 'normal' write code (110) is done in-line; all others
      in a subroutine
    - APRFILE[UNUSED] is all zeroes, forcing non-resident abort
@@ -2945,7 +3145,11 @@ return;
 int32 relocW (int32 va)
 {
 int32 apridx, apr, pa;
+RELOCTB *tb = &reloc_tb[(va >> VA_V_APF) & 077];
 
+if ((tb->acc & RTB_WR) &&                               /* cache hit? */
+    (((uint32) ((va & VA_DF) - tb->lo)) <= ((uint32) tb->lnt)))
+    return tb->pa + (va & VA_DF);
 if (MMR0 & MMR0_MME) {                                  /* if mmgt */
     apridx = (va >> VA_V_APF) & 077;                    /* index into APR */
     apr = APRFILE[apridx];                              /* with va<18:13> */
@@ -2966,6 +3170,7 @@ else {
     if (pa >= 0160000)
         pa = 017600000 | pa;
     }
+reloc_load ((va >> VA_V_APF) & 077);                    /* load cache */
 return pa;
 }
 
@@ -3019,6 +3224,80 @@ reloc_abort (err, apridx);
 return;
 }
 
+/* Load relocation cache entry
+
+   Inputs:
+        apridx  =       APR index, va<18:13>
+   Outputs: none
+
+   Notes:
+   - Called after a reference to the page has been relocated
+   - Reads are allowed from pages with access code 2 or 6; writes
+     only to pages with access code 6 that are already marked written,
+     so that every cached reference behaves like the in-line case
+   - Pages whose in-bounds displacements do not relocate linearly
+     (18b wraparound, or straddling the 18b I/O page) are not cached
+*/
+
+void reloc_load (int32 apridx)
+{
+int32 apr, plf, lo, hi, base, acc;
+RELOCTB *tb = &reloc_tb[apridx];
+
+if (MMR0 & MMR0_MME) {                                  /* if mmgt */
+    apr = APRFILE[apridx];
+    acc = 0;
+    if ((apr & PDR_PRD) == 2)                           /* readable? */
+        acc = RTB_RD;
+    if ((apr & (PDR_ACF|PDR_W)) == (6|PDR_W))           /* written r/w? */
+        acc = acc | RTB_WR;
+    plf = (apr & PDR_PLF) >> 2;                         /* extr page length */
+    if (apr & PDR_ED) {                                 /* expand down? */
+        lo = plf;
+        hi = VA_DF;
+        }
+    else {
+        lo = 0;
+        hi = plf | (VA_DF & ~VA_BN);
+        }
+    base = (apr >> 10) & 017777700;
+    if ((base + hi) > PAMASK)                           /* wraps? */
+        acc = 0;
+    else if ((MMR3 & MMR3_M22E) == 0) {                 /* 18b? */
+        if ((base + hi) > 0777777)                      /* wraps? */
+            acc = 0;
+        else if ((base + lo) >= 0760000)                /* all I/O page? */
+            base = 017000000 | base;
+        else if ((base + hi) >= 0760000)                /* straddles? */
+            acc = 0;
+        }
+    }
+else {                                                  /* mmgt off */
+    acc = RTB_RD | RTB_WR;
+    lo = 0;
+    hi = VA_DF;
+    base = (apridx & 07) << VA_V_APF;
+    if (base >= 0160000)
+        base = 017600000 | base;
+    }
+tb->lo = lo;
+tb->lnt = hi - lo;
+tb->pa = base;
+tb->acc = acc;
+return;
+}
+
+/* Flush relocation cache */
+
+void reloc_flush (void)
+{
+int32 i;
+
+for (i = 0; i < 64; i++)
+    reloc_tb[i].acc = 0;
+return;
+}
+
 /* Relocate virtual address, console access
 
    Inputs:
@@ -3109,6 +3388,8 @@ switch ((pa >> 1) & 3) {                                /* decode pa<2:1> */
         if (access == WRITEB)
             data = (pa & 1)? (MMR0 & 0377) | (data << 8): (MMR0 & ~0377) | data;
         data = data & cpu_tab[cpu_model].mm0;
+        if ((MMR0 ^ data) & MMR0_MME)                   /* mmgt on/off? */
+            reloc_flush ();
         MMR0 = (MMR0 & ~MMR0_WR) | (data & MMR0_WR);
         return SCPE_OK;
 
@@ -3127,7 +3408,10 @@ t_stat MMR3_wr (int32 data, int32 pa, int32 access)     /* MMR3 */
 {
 if (pa & 1)
     return SCPE_OK;
-MMR3 = data & cpu_tab[cpu_model].mm3;
+data = data & cpu_tab[cpu_model].mm3;
+if ((MMR3 ^ data) & MMR3_M22E)                          /* 18b/22b change? */
+    reloc_flush ();
+MMR3 = data;
 cpu_bme = (MMR3 & MMR3_BME) && (cpu_opt & OPT_UBM);
 dsenable = calc_ds (cm);
 return SCPE_OK;
@@ -3187,6 +3471,7 @@ if (left)
         (((uint32) (data & cpu_tab[cpu_model].par)) << 16)) & ~(PDR_A|PDR_W);
 else APRFILE[idx] = ((APRFILE[idx] & ~0177777) |
     (data & cpu_tab[cpu_model].pdr)) & ~(PDR_A|PDR_W);
+reloc_tb[idx].acc = 0;                                  /* invalidate cache */
 return SCPE_OK;
 }
 
@@ -3350,6 +3635,7 @@ MMR0 = 0;
 MMR1 = 0;
 MMR2 = 0;
 MMR3 = 0;
+reloc_flush ();
 trap_req = 0;
 wait_state = 0;
 if (M == NULL) {                    /* First time init */
@@ -3357,6 +3643,9 @@ if (M == NULL) {                    /* First time init */
     if (M == NULL)
         return SCPE_MEM;
     sim_set_pchar (0, "01000023640"); /* ESC, CR, LF, TAB, BS, BEL, ENQ */
+#if defined (__GNUC__)
+    cpu_build_dtab ();
+#endif
     sim_brk_dflt = SWMASK ('E');
     sim_brk_types = sim_brk_dflt|SWMASK ('P')|
                     SWMASK ('R')|SWMASK ('S')|
@@ -0,0 +1,529 @@
+/* pdp11_dstr.h: decimal string arithmetic for PDP-11 and VAX CIS
+
+   Copyright (c) 1993-2016, Robert M Supnik
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+   ROBERT M SUPNIK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+   CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   Except as contained in this notice, the name of Robert M Supnik shall not be
+   used in advertising or otherwise to promote the sale, use or other dealings
+   in this Software without prior written authorization from Robert M Supnik.
+
+   This module contains the decimal string arithmetic used by both the
+   PDP-11 CIS (pdp11_cis.c) and the VAX CIS (vax_cis.c).  The including
+   module supplies the string read and write routines, which differ in
+   operand formats, access checks and condition codes.
+
+   A decimal string is held as 31 packed digits plus a sign nibble in the
+   low order nibble, in four longwords.  The arithmetic routines treat the
+   string as two quadwords and process sixteen digits at a time.
+*/
+
+#ifndef PDP11_DSTR_H_
+#define PDP11_DSTR_H_   0
+
+/* Decimal string structure */
+
+#define DSTRLNT         4
+#define DSTRMAX         (DSTRLNT - 1)
+
+typedef struct {
+    uint32              sign;
+    uint32              val[DSTRLNT];
+    } DSTR;
+
+#define DSTR_GETQ(d,i)  ((((t_uint64) (d)->val[(i) * 2 + 1]) << 32) | \
+                        ((t_uint64) (d)->val[(i) * 2]))
+#define DSTR_PUTQ(d,i,v) (d)->val[(i) * 2] = (uint32) (v), \
+                        (d)->val[(i) * 2 + 1] = (uint32) ((v) >> 32)
+#define DSTR_DIGIT(d,i) (((d)->val[(i) / 8] >> (((i) % 8) * 4)) & 0xF)
+
+/* Add sixteen decimal digits
+
+   Arguments:
+        a       =       first operand
+        b       =       second operand
+        cy      =       pointer to carry in/carry out
+
+   This algorithm courtesy Anton Chernoff, circa 1992 or even earlier.
+
+   We trace the history of a pair of adjacent digits to see how the
+   carry is fixed; each parenthesized item is a 4b digit.
+
+   Assume we are adding:
+
+        (a)(b)  I
+   +    (x)(y)  J
+
+   First compute I^J:
+
+        (a^x)(b^y)      TMP
+
+   Note that the low bit of each digit is the same as the low bit of
+   the sum of the digits, ignoring the carry, since the low bit of the
+   sum is the xor of the bits.
+
+   Now compute I+J+66 to get decimal addition with carry forced left
+   one digit:
+
+        (a+x+6+carry mod 16)(b+y+6 mod 16)      SUM
+
+   Note that if there was a carry from b+y+6, then the low bit of the
+   left digit is different from the expected low bit from the xor.
+   If we xor this SUM into TMP, then the low bit of each digit is 1
+   if there was a carry, and 0 if not.  We need to subtract 6 from each
+   digit that did not have a carry, so take ~(SUM ^ TMP) & 0x11, shift
+   it right 4 to the digits that are affected, and subtract 6*adjustment
+   (actually, shift it right 3 and subtract 3*adjustment).
+*/
+
+static t_uint64 AddDstrQ (t_uint64 a, t_uint64 b, int32 *cy)
+{
+t_uint64 sm1, sm2, tm1, tm2, tm3, tm4;
+
+b = b + *cy;                                            /* add carry in */
+tm1 = a ^ b;                                            /* xor operands */
+sm1 = a + b;                                            /* sum operands */
+sm2 = sm1 + 0x6666666666666666;                         /* force carry out */
+*cy = ((sm1 < a) || (sm2 < sm1));                       /* check for overflow */
+tm2 = tm1 ^ sm2;                                        /* get carry flags */
+tm3 = (tm2 >> 3) | (((t_uint64) *cy) << 61);            /* compute adjustment */
+tm4 = 0x2222222222222222 & ~tm3;                        /* clear where carry */
+return sm2 - (3 * tm4);                                 /* final result */
+}
+
+/* Add decimal string magnitudes
+
+   Arguments:
+        s1      =       src1 decimal string
+        s2      =       src2 decimal string
+        ds      =       dest decimal string
+        cy      =       carry in
+   Output       =       1 if carry, 0 if no carry
+*/
+
+static int32 AddDstr (DSTR *s1, DSTR *s2, DSTR *ds, int32 cy)
+{
+t_uint64 lo, hi;
+
+lo = AddDstrQ (DSTR_GETQ (s1, 0), DSTR_GETQ (s2, 0), &cy);
+hi = AddDstrQ (DSTR_GETQ (s1, 1), DSTR_GETQ (s2, 1), &cy);
+DSTR_PUTQ (ds, 0, lo);
+DSTR_PUTQ (ds, 1, hi);
+return cy;
+}
+
+/* Subtract decimal string magnitudes
+
+   Arguments:
+        s1      =       src1 decimal string
+        s2      =       src2 decimal string
+        ds      =       dest decimal string
+   Outputs:             s2 - s1 in ds
+
+   Note: the routine assumes that s1 <= s2
+
+*/
+
+static void SubDstr (DSTR *s1, DSTR *s2, DSTR *ds)
+{
+int32 cy = 1;                                           /* s1 + ~s2 + 1 */
+t_uint64 lo, hi;
+
+lo = AddDstrQ (0x9999999999999999 - DSTR_GETQ (s1, 0),  /* 10's comp s1 */
+    DSTR_GETQ (s2, 0), &cy);
+hi = AddDstrQ (0x9999999999999999 - DSTR_GETQ (s1, 1),
+    DSTR_GETQ (s2, 1), &cy);
+DSTR_PUTQ (ds, 0, lo);
+DSTR_PUTQ (ds, 1, hi);
+return;
+}
+
+/* Compare decimal string magnitudes
+
+   Arguments:
+        s1      =       src1 decimal string
+        s2      =       src2 decimal string
+   Output       =       1 if >, 0 if =, -1 if <
+*/
+
+static int32 CmpDstr (DSTR *s1, DSTR *s2)
+{
+t_uint64 a = DSTR_GETQ (s1, 1);
+t_uint64 b = DSTR_GETQ (s2, 1);
+
+if (a == b) {                                           /* hi equal? try lo */
+    a = DSTR_GETQ (s1, 0);
+    b = DSTR_GETQ (s2, 0);
+    }
+if (a > b)
+    return 1;
+if (a < b)
+    return -1;
+return 0;
+}
+
+/* Test decimal string for zero
+
+   Arguments:
+        dsrc    =       decimal string structure
+
+   Returns the non-zero length of the string, in int32 units
+   If the string is zero, the sign is cleared
+*/
+
+static int32 TestDstr (DSTR *dsrc)
+{
+int32 i;
+
+for (i = DSTRMAX; i >= 0; i--) {
+    if (dsrc->val[i])
+        return (i + 1);
+    }
+dsrc->sign = 0;
+return 0;
+}
+
+/* Get exact length of decimal string
+
+   Arguments:
+        dsrc    =       decimal string structure
+        nz      =       result from TestDstr
+*/
+
+static int32 LntDstr (DSTR *dsrc, int32 nz)
+{
+int32 i;
+
+if (nz == 0)
+    return 0;
+for (i = 7; i >= 0; i--) {
+    if ((dsrc->val[nz - 1] >> (i * 4)) & 0xF)
+        break;
+    }
+return ((nz - 1) * 8) + i;
+}
+
+/* Create table of multiples
+
+   Arguments:
+        dsrc    =       base decimal string structure
+        mtable[10] =    array of decimal string structures
+
+   Note that dsrc has a high order zero nibble; this
+   guarantees that the largest multiple won't overflow
+   Also note that mtable[0] is not filled in
+*/
+
+static void CreateTable (DSTR *dsrc, DSTR mtable[10])
+{
+int32 i;
+
+mtable[1] = *dsrc;
+for (i = 2; i < 10; i++)
+    AddDstr (&mtable[1], &mtable[i-1], &mtable[i], 0);
+return;
+}
+
+/* Word shift right
+
+   Arguments:
+        dsrc    =       decimal string structure
+        sc      =       shift count
+*/
+
+static void WordRshift (DSTR *dsrc, int32 sc)
+{
+int32 i;
+
+if (sc != 0) {
+    for (i = 0; i < DSTRLNT; i++) {
+        if ((i + sc) < DSTRLNT)
+            dsrc->val[i] = dsrc->val[i + sc];
+        else dsrc->val[i] = 0;
+        }
+    }
+return;
+}
+
+/* Word shift left
+
+   Arguments:
+        dsrc    =       decimal string structure
+        sc      =       shift count
+*/
+
+static int32 WordLshift (DSTR *dsrc, int32 sc)
+{
+int32 i, c, zc;
+
+c = 0;
+if (sc != 0) {
+    for (i = DSTRMAX; i >= 0; i--) {                    /* work hi to low */
+        if ((i + sc) <= DSTRMAX)                        /* move in range? */
+            dsrc->val[i + sc] = dsrc->val[i];
+        else c |= dsrc->val[i];                         /* no, count as ovflo */
+        }
+    zc = (sc >= DSTRLNT)? DSTRLNT: sc;                  /* cap fill */
+    for (i = 0; i < zc; i++)                            /* fill with 0s */
+        dsrc->val[i] = 0;
+    }
+return c;
+}
+
+/* Nibble shift decimal string right
+
+   Arguments:
+        dsrc    =       decimal string structure
+        sc      =       shift count (0 to 7)
+        cin     =       carry in
+*/
+
+static uint32 NibbleRshift (DSTR *dsrc, int32 sc, uint32 cin)
+{
+int32 s;
+uint32 nc;
+t_uint64 lo, hi;
+
+if ((s = sc * 4) != 0) {
+    lo = DSTR_GETQ (dsrc, 0);
+    hi = DSTR_GETQ (dsrc, 1);
+    nc = (uint32) (lo << (32 - s));                     /* bits shifted out */
+    lo = (lo >> s) | (hi << (64 - s));
+    hi = (hi >> s) | (((t_uint64) cin) << 32);
+    DSTR_PUTQ (dsrc, 0, lo);
+    DSTR_PUTQ (dsrc, 1, hi);
+    return nc;
+    }
+return 0;
+}
+
+/* Nibble shift decimal string left
+
+   Arguments:
+        dsrc    =       decimal string structure
+        sc      =       shift count (0 to 7)
+        cin     =       carry in
+*/
+
+static uint32 NibbleLshift (DSTR *dsrc, int32 sc, uint32 cin)
+{
+int32 s;
+uint32 nc;
+t_uint64 lo, hi;
+
+if ((s = sc * 4) != 0) {
+    lo = DSTR_GETQ (dsrc, 0);
+    hi = DSTR_GETQ (dsrc, 1);
+    nc = (uint32) (hi >> (64 - s));                     /* bits shifted out */
+    hi = (hi << s) | (lo >> (64 - s));
+    lo = (lo << s) | cin;
+    DSTR_PUTQ (dsrc, 0, lo);
+    DSTR_PUTQ (dsrc, 1, hi);
+    return nc;
+    }
+return 0;
+}
+
+/* Multiply decimal string magnitudes
+
+   Arguments:
+        s1      =       multiplicand decimal string, non-zero
+        s2      =       multiplier decimal string, non-zero
+        ds      =       product decimal string
+   Output       =       1 if the product overflows 31 digits
+
+   The multiplicand is shifted to remove the sign nibble.  The product
+   is developed in a double length accumulator, one multiplier digit
+   at a time from the low order end, shifting right a digit per step.
+   Once the highest non-zero multiplier digit has been added in, the
+   remaining steps would only shift, so they are done as one shift.
+*/
+
+static int32 MulDstr (DSTR *s1, DSTR *s2, DSTR *ds)
+{
+int32 i, d, m, cy, sc;
+t_uint64 ac[4];
+DSTR mptable[10];
+
+NibbleRshift (s1, 1, 0);                                /* shift out sign */
+CreateTable (s1, mptable);                              /* create *1, *2, ... */
+for (m = (DSTRLNT * 8) - 1; m > 0; m--) {               /* find high digit */
+    if (DSTR_DIGIT (s2, m))
+        break;
+    }
+ac[0] = ac[1] = ac[2] = ac[3] = 0;                      /* result, accum */
+for (i = 1; i <= m; i++) {
+    d = DSTR_DIGIT (s2, i);
+    if (d > 0) {                                        /* add in digit*mpcnd */
+        cy = 0;
+        ac[2] = AddDstrQ (DSTR_GETQ (&mptable[d], 0), ac[2], &cy);
+        ac[3] = AddDstrQ (DSTR_GETQ (&mptable[d], 1), ac[3], &cy);
+        }
+    ac[0] = (ac[0] >> 4) | (ac[1] << 60);               /* ac, result right 4 */
+    ac[1] = (ac[1] >> 4) | (ac[2] << 60);
+    ac[2] = (ac[2] >> 4) | (ac[3] << 60);
+    ac[3] = ac[3] >> 4;
+    }
+for (sc = ((DSTRLNT * 8) - 1 - m) * 4; sc >= 64; sc -= 64) {
+    ac[0] = ac[1];                                      /* remaining shifts */
+    ac[1] = ac[2];
+    ac[2] = ac[3];
+    ac[3] = 0;
+    }
+if (sc != 0) {
+    ac[0] = (ac[0] >> sc) | (ac[1] << (64 - sc));
+    ac[1] = (ac[1] >> sc) | (ac[2] << (64 - sc));
+    ac[2] = (ac[2] >> sc) | (ac[3] << (64 - sc));
+    ac[3] = ac[3] >> sc;
+    }
+DSTR_PUTQ (ds, 0, ac[0]);
+DSTR_PUTQ (ds, 1, ac[1]);
+return ((ac[2] | ac[3]) != 0);                          /* ovflo if accum != 0 */
+}
+
+/* Divide decimal string magnitudes
+
+   Arguments:
+        s1      =       divisor decimal string, right justified
+        s2      =       dividend decimal string, right justified
+        ds      =       quotient decimal string, zero
+        t       =       dividend length - divisor length, >= 0
+
+   The divisor is aligned with the dividend, and each quotient digit
+   is found by a binary search of the table of divisor multiples.
+*/
+
+static void DivDstr (DSTR *s1, DSTR *s2, DSTR *ds, int32 t)
+{
+int32 i, d, lo, hi, cy;
+t_uint64 r0, r1, q0, q1;
+DSTR mptable[10];
+
+WordLshift (s1, t / 8);                                 /* align divr to divd */
+NibbleLshift (s1, t % 8, 0);
+CreateTable (s1, mptable);                              /* create *1, *2, ... */
+r0 = DSTR_GETQ (s2, 0);                                 /* remainder */
+r1 = DSTR_GETQ (s2, 1);
+q0 = DSTR_GETQ (ds, 0);                                 /* quotient */
+q1 = DSTR_GETQ (ds, 1);
+for (i = 0; i <= t; i++) {                              /* divide loop */
+    for (lo = 0, hi = 9; lo < hi; ) {                   /* find digit */
+        t_uint64 m0, m1;
+
+        d = (lo + hi + 1) / 2;
+        m0 = DSTR_GETQ (&mptable[d], 0);
+        m1 = DSTR_GETQ (&mptable[d], 1);
+        if ((r1 > m1) || ((r1 == m1) && (r0 >= m0)))    /* rem >= multiple? */
+            lo = d;
+        else hi = d - 1;
+        }
+    if (lo > 0) {                                       /* subtract multiple */
+        cy = 1;
+        r0 = AddDstrQ (0x9999999999999999 - DSTR_GETQ (&mptable[lo], 0), r0, &cy);
+        r1 = AddDstrQ (0x9999999999999999 - DSTR_GETQ (&mptable[lo], 1), r1, &cy);
+        q0 = q0 | lo;
+        }
+    r1 = (r1 << 4) | (r0 >> 60);                        /* shift dividend */
+    r0 = r0 << 4;
+    q1 = (q1 << 4) | (q0 >> 60);                        /* shift quotient */
+    q0 = q0 << 4;
+    }
+DSTR_PUTQ (s2, 0, r0);
+DSTR_PUTQ (s2, 1, r1);
+DSTR_PUTQ (ds, 0, q0);
+DSTR_PUTQ (ds, 1, q1);
+return;
+}
+
+/* Convert eight packed digits to binary */
+
+static uint32 CvtDstrB (uint32 bcd)
+{
+bcd = (bcd & 0x0F0F0F0F) + (((bcd >> 4) & 0x0F0F0F0F) * 10);
+bcd = (bcd & 0x00FF00FF) + (((bcd >> 8) & 0x00FF00FF) * 100);
+return (bcd & 0xFFFF) + ((bcd >> 16) * 10000);
+}
+
+/* Convert binary less than 10^8 to eight packed digits
+
+   The value is split into two four digit lanes, each lane into two
+   digit lanes (multiplying by 5243 / 2^19 divides by 100 for values
+   below 43699), and each of those into digits (multiplying by
+   103 / 2^10 divides by 10 for values below 179).
+*/
+
+static uint32 CvtBDstr (uint32 bin)
+{
+t_uint64 t, q, tens;
+
+t = (((t_uint64) (bin / 10000)) << 32) | (bin % 10000);
+q = ((t * 5243) >> 19) & 0x0000007F0000007F;           /* 2 x 4 digits */
+t = (q << 16) | (t - (q * 100));                        /* 4 x 2 digits */
+tens = ((t * 103) >> 10) & 0x000F000F000F000F;
+t = (tens << 4) | (t - (tens * 10));                    /* 4 x 2 packed */
+t = (t | (t >> 8)) & 0x0000FFFF0000FFFF;
+return (uint32) (t | (t >> 16));
+}
+
+/* Convert decimal string magnitude to longword
+
+   Arguments:
+        src     =       decimal string structure
+        V       =       pointer to overflow flag
+   Output       =       magnitude, modulo 2^32
+
+   *V is set if the magnitude is 2^32 or larger, and otherwise
+   left unchanged.
+*/
+
+static uint32 CvtDstrL (DSTR *src, int32 *V)
+{
+t_uint64 lo = DSTR_GETQ (src, 0);
+t_uint64 hi = DSTR_GETQ (src, 1);
+t_uint64 b0, b1, b2, b3;
+
+lo = (lo >> 4) | (hi << 60);                            /* drop sign nibble */
+hi = hi >> 4;
+b0 = CvtDstrB ((uint32) lo);                            /* 4 x 8 digits */
+b1 = CvtDstrB ((uint32) (lo >> 32));
+b2 = CvtDstrB ((uint32) hi);
+b3 = CvtDstrB ((uint32) (hi >> 32));
+b0 = (b1 * 100000000) + b0;                             /* low 16 digits */
+if ((b2 | b3) || (b0 > 0xFFFFFFFF))                     /* >= 2^32? */
+    *V = 1;
+return (uint32) (((((b3 * 100000000) + b2) * 10000000000000000) + b0) & 0xFFFFFFFF);
+}
+
+/* Convert longword to decimal string magnitude
+
+   Arguments:
+        val     =       magnitude
+        dst     =       decimal string structure, zero
+*/
+
+static void CvtLDstr (uint32 val, DSTR *dst)
+{
+t_uint64 t;
+
+t = (((t_uint64) CvtBDstr (val / 100000000)) << 32) |   /* 10 digits */
+    CvtBDstr (val % 100000000);
+DSTR_PUTQ (dst, 0, t << 4);                             /* above sign */
+return;
+}
+
+#endif
@@ -0,0 +1,385 @@
+/* pdp11_dstr_test.c: decimal string arithmetic equivalence test
+
+   Copyright (c) 2026, The simh developers
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+   THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+   CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   This program checks the quadword decimal string routines in pdp11_dstr.h,
+   which the PDP-11 and VAX CIS share, against the longword routines and the
+   MULP, DIVP, CVTPL and CVTLP digit loops the two CIS modules used before.
+   The old code is kept here, with ref_ names, as the reference.  Random
+   strings of valid digits, of random length and with runs of zeroes and
+   nines to exercise carries, are run through both and any difference in
+   results, carries or overflow is reported.
+
+   Build with "make dstrtest" and run as
+
+        dstrtest {count}
+
+   The exit status is non-zero if any mismatch is found.
+*/
+
+#include "sim_defs.h"
+#include "pdp11_dstr.h"
+
+#define MAXDVAL         429496730                       /* 2^32 / 10 */
+
+static const DSTR Dstr_zero = { 0, {0, 0, 0, 0} };
+
+/* Reference routines: the longword decimal string code */
+
+static int32 ref_AddDstr (DSTR *s1, DSTR *s2, DSTR *ds, int32 cy)
+{
+int32 i;
+uint32 sm1, sm2, tm1, tm2, tm3, tm4;
+
+for (i = 0; i < DSTRLNT; i++) {                         /* loop low to high */
+    tm1 = s1->val[i] ^ (s2->val[i] + cy);               /* xor operands */
+    sm1 = s1->val[i] + (s2->val[i] + cy);               /* sum operands */
+    sm2 = sm1 + 0x66666666;                             /* force carry out */
+    cy = ((sm1 < s1->val[i]) || (sm2 < sm1));           /* check for overflow */
+    tm2 = tm1 ^ sm2;                                    /* get carry flags */
+    tm3 = (tm2 >> 3) | (cy << 29);                      /* compute adjustment */
+    tm4 = 0x22222222 & ~tm3;                            /* clear where carry */
+    ds->val[i] = (sm2 - (3 * tm4)) & 0xFFFFFFFF;        /* final result */
+    }
+return cy;
+}
+
+static void ref_SubDstr (DSTR *s1, DSTR *s2, DSTR *ds)
+{
+int32 i;
+DSTR complX;
+
+for (i = 0; i < DSTRLNT; i++)                           /* 10's comp s2 */
+    complX.val[i] = 0x99999999 - s1->val[i];
+ref_AddDstr (&complX, s2, ds, 1);                       /* s1 + ~s2 + 1 */
+}
+
+static int32 ref_CmpDstr (DSTR *s1, DSTR *s2)
+{
+int32 i;
+
+for (i = DSTRMAX; i >=0; i--) {
+    if (s1->val[i] > s2->val[i])
+        return 1;
+    if (s1->val[i] < s2->val[i])
+        return -1;
+    }
+return 0;
+}
+
+static int32 ref_TestDstr (DSTR *dsrc)
+{
+int32 i;
+
+for (i = DSTRMAX; i >= 0; i--) {
+    if (dsrc->val[i])
+        return (i + 1);
+    }
+dsrc->sign = 0;
+return 0;
+}
+
+static int32 ref_LntDstr (DSTR *dsrc, int32 nz)
+{
+int32 i;
+
+if (nz == 0)
+    return 0;
+for (i = 7; i >= 0; i--) {
+    if ((dsrc->val[nz - 1] >> (i * 4)) & 0xF)
+        break;
+    }
+return ((nz - 1) * 8) + i;
+}
+
+static void ref_CreateTable (DSTR *dsrc, DSTR mtable[10])
+{
+int32 i;
+
+mtable[1] = *dsrc;
+for (i = 2; i < 10; i++)
+    ref_AddDstr (&mtable[1], &mtable[i-1], &mtable[i], 0);
+}
+
+static int32 ref_WordLshift (DSTR *dsrc, int32 sc)
+{
+int32 i, c, zc;
+
+c = 0;
+if (sc != 0) {
+    for (i = DSTRMAX; i >= 0; i--) {                    /* work hi to low */
+        if ((i + sc) <= DSTRMAX)                        /* move in range? */
+            dsrc->val[i + sc] = dsrc->val[i];
+        else c |= dsrc->val[i];                         /* no, count as ovflo */
+        }
+    zc = (sc >= DSTRLNT)? DSTRLNT: sc;                  /* cap fill */
+    for (i = 0; i < zc; i++)                            /* fill with 0s */
+        dsrc->val[i] = 0;
+    }
+return c;
+}
+
+static uint32 ref_NibbleRshift (DSTR *dsrc, int32 sc, uint32 cin)
+{
+int32 i, s;
+uint32 nc;
+
+if ((s = sc * 4) != 0) {
+    for (i = DSTRMAX; i >= 0; i--) {
+        nc = (dsrc->val[i] << (32 - s)) & 0xFFFFFFFF;
+        dsrc->val[i] = ((dsrc->val[i] >> s) | cin) & 0xFFFFFFFF;
+        cin = nc;
+        }
+    return cin;
+    }
+return 0;
+}
+
+static uint32 ref_NibbleLshift (DSTR *dsrc, int32 sc, uint32 cin)
+{
+int32 i, s;
+uint32 nc;
+
+if ((s = sc * 4) != 0) {
+    for (i = 0; i < DSTRLNT; i++) {
+        nc = dsrc->val[i] >> (32 - s);
+        dsrc->val[i] = ((dsrc->val[i] << s) | cin) & 0xFFFFFFFF;
+        cin = nc;
+        }
+    return cin;
+    }
+return 0;
+}
+
+/* Reference MULP, DIVP, CVTPL and CVTLP loops */
+
+static int32 ref_MulDstr (DSTR *src1, DSTR *src2, DSTR *dst)
+{
+int32 i, d;
+uint32 nc;
+DSTR accum, mptable[10];
+
+accum = Dstr_zero;                                      /* clear accum */
+ref_NibbleRshift (src1, 1, 0);                          /* shift out sign */
+ref_CreateTable (src1, mptable);                        /* create *1, *2, ... */
+for (i = 1; i < (DSTRLNT * 8); i++) {                   /* 31 iterations */
+    d = (src2->val[i / 8] >> ((i % 8) * 4)) & 0xF;
+    if (d > 0)                                          /* add in digit*mpcnd */
+        ref_AddDstr (&mptable[d], &accum, &accum, 0);
+    nc = ref_NibbleRshift (&accum, 1, 0);               /* ac right 4 */
+    ref_NibbleRshift (dst, 1, nc);                      /* result right 4 */
+    }
+return ref_TestDstr (&accum) != 0;                      /* if ovflo, set V */
+}
+
+static void ref_DivDstr (DSTR *src1, DSTR *src2, DSTR *dst, int32 t)
+{
+int32 i, d;
+DSTR mptable[10];
+
+ref_WordLshift (src1, t / 8);                           /* align divr to divd */
+ref_NibbleLshift (src1, t % 8, 0);
+ref_CreateTable (src1, mptable);                        /* create *1, *2, ... */
+for (i = 0; i <= t; i++) {                              /* divide loop */
+    for (d = 9; d > 0; d--) {                           /* find digit */
+        if (ref_CmpDstr (src2, &mptable[d]) >= 0) {
+            ref_SubDstr (&mptable[d], src2, src2);
+            dst->val[0] = dst->val[0] | d;
+            break;
+            }
+        }
+    ref_NibbleLshift (src2, 1, 0);                      /* shift dividend */
+    ref_NibbleLshift (dst, 1, 0);                       /* shift quotient */
+    }
+}
+
+static uint32 ref_CvtDstrL (DSTR *src1, int32 *V)
+{
+int32 i;
+uint32 d, result = 0;
+
+for (i = (DSTRLNT * 8) - 1; i > 0; i--) {               /* loop thru digits */
+    d = (src1->val[i / 8] >> ((i % 8) * 4)) & 0xF;
+    if (d || result || *V) {                            /* skip initial 0's */
+        if (result >= MAXDVAL)
+            *V = 1;
+        result = ((result * 10) + d) & 0xFFFFFFFF;
+        if (result < d)
+            *V = 1;
+        }
+    }
+return result;
+}
+
+static void ref_CvtLDstr (uint32 result, DSTR *dst)
+{
+int32 i;
+uint32 d;
+
+for (i = 1; (i < (DSTRLNT * 8)) && result; i++) {
+    d = result % 10;
+    result = result / 10;
+    dst->val[i / 8] = dst->val[i / 8] | (d << ((i % 8) * 4));
+    }
+}
+
+/* Random operands */
+
+static t_uint64 rand_state = 88172645463325252ULL;
+
+static t_uint64 rand64 (void)
+{
+rand_state ^= rand_state << 13;                         /* xorshift64 */
+rand_state ^= rand_state >> 7;
+rand_state ^= rand_state << 17;
+return rand_state;
+}
+
+/* Random decimal string, as ReadDstr leaves it: up to 31 valid digits
+   above a zero sign nibble.  Digits are drawn from all ten values, or
+   mostly nines, or mostly zeroes, so carries ripple across longwords. */
+
+static void rand_dstr (DSTR *d)
+{
+t_uint64 x = rand64 ();
+int32 i, lnt = (int32) (x % 32), mode = (int32) ((x >> 8) & 3);
+uint32 dig;
+
+*d = Dstr_zero;
+for (i = 1; i <= lnt; i++) {
+    x = rand64 ();
+    if ((mode == 1) && (x & 7))                         /* mostly nines */
+        dig = 9;
+    else if ((mode == 2) && (x & 7))                    /* mostly zeroes */
+        dig = 0;
+    else dig = (uint32) ((x >> 8) % 10);
+    d->val[i / 8] |= dig << ((i % 8) * 4);
+    }
+d->sign = (uint32) ((x >> 16) & 1);
+ref_TestDstr (d);                                       /* clean -0 */
+}
+
+static long bad = 0;
+
+static void check (const char *name, t_bool ok, DSTR *a, DSTR *b)
+{
+if (ok)
+    return;
+if (bad++ < 20)
+    printf ("%s mismatch: %08X %08X %08X %08X, %08X %08X %08X %08X\n", name,
+            a->val[3], a->val[2], a->val[1], a->val[0],
+            b->val[3], b->val[2], b->val[1], b->val[0]);
+}
+
+#define SAME(x,y)       (memcmp ((x), (y), sizeof (DSTR)) == 0)
+
+int main (int argc, char *argv[])
+{
+long count = (argc > 1)? atol (argv[1]): 1000000;
+long i;
+int32 sc, t, c1, c2, v1, v2, l1, l2;
+uint32 n1, n2, val;
+DSTR a, b, r1, r2, x1, x2, y1, y2;
+
+for (i = 0; i < count; i++) {
+    rand_dstr (&a);
+    rand_dstr (&b);
+
+    r1 = r2 = Dstr_zero;                                /* add */
+    c1 = ref_AddDstr (&a, &b, &r1, (int32) (i & 1));
+    c2 = AddDstr (&a, &b, &r2, (int32) (i & 1));
+    check ("AddDstr", SAME (&r1, &r2) && (c1 == c2), &a, &b);
+
+    if (ref_CmpDstr (&a, &b) <= 0) {                    /* subtract */
+        ref_SubDstr (&a, &b, &r1);
+        SubDstr (&a, &b, &r2);
+        }
+    else {
+        ref_SubDstr (&b, &a, &r1);
+        SubDstr (&b, &a, &r2);
+        }
+    check ("SubDstr", SAME (&r1, &r2), &a, &b);
+
+    check ("CmpDstr", ref_CmpDstr (&a, &b) == CmpDstr (&a, &b), &a, &b);
+    check ("CmpDstr", CmpDstr (&a, &a) == 0, &a, &a);
+
+    x1 = x2 = a;                                        /* test, length */
+    l1 = ref_TestDstr (&x1);
+    l2 = TestDstr (&x2);
+    check ("TestDstr", SAME (&x1, &x2) && (l1 == l2), &a, &a);
+    check ("LntDstr", ref_LntDstr (&x1, l1) == LntDstr (&x2, l2), &a, &a);
+
+    sc = (int32) (rand64 () % 8);                       /* nibble shifts */
+    val = (uint32) rand64 ();
+    x1 = x2 = a;
+    n1 = ref_NibbleRshift (&x1, sc, val & ~(0xFFFFFFFF >> (sc * 4)));
+    n2 = NibbleRshift (&x2, sc, val & ~(0xFFFFFFFF >> (sc * 4)));
+    check ("NibbleRshift", SAME (&x1, &x2) && (n1 == n2), &a, &x2);
+    x1 = x2 = a;
+    n1 = ref_NibbleLshift (&x1, sc, sc? (val >> (32 - (sc * 4))): 0);
+    n2 = NibbleLshift (&x2, sc, sc? (val >> (32 - (sc * 4))): 0);
+    check ("NibbleLshift", SAME (&x1, &x2) && (n1 == n2), &a, &x2);
+
+    sc = (int32) (rand64 () % (DSTRLNT + 1));           /* word shift */
+    x1 = x2 = a;
+    c1 = ref_WordLshift (&x1, sc);
+    c2 = WordLshift (&x2, sc);
+    check ("WordLshift", SAME (&x1, &x2) && (c1 == c2), &a, &x2);
+
+    if (ref_TestDstr (&a) && ref_TestDstr (&b)) {       /* MULP */
+        x1 = x2 = a;
+        r1 = r2 = Dstr_zero;
+        v1 = ref_MulDstr (&x1, &b, &r1);
+        v2 = MulDstr (&x2, &b, &r2);
+        check ("MulDstr", SAME (&r1, &r2) && (v1 == v2), &a, &b);
+        }
+
+    l1 = ref_LntDstr (&a, ref_TestDstr (&a));           /* DIVP */
+    if (l1 != 0) {
+        l2 = ref_LntDstr (&b, ref_TestDstr (&b));
+        x1 = x2 = a;
+        y1 = y2 = b;
+        ref_NibbleRshift (&x1, 1, 0);                   /* right justify ops */
+        ref_NibbleRshift (&y1, 1, 0);
+        NibbleRshift (&x2, 1, 0);
+        NibbleRshift (&y2, 1, 0);
+        r1 = r2 = Dstr_zero;
+        if ((t = l2 - l1) >= 0) {
+            ref_DivDstr (&x1, &y1, &r1, t);
+            DivDstr (&x2, &y2, &r2, t);
+            }
+        check ("DivDstr", SAME (&r1, &r2), &a, &b);
+        }
+
+    v1 = v2 = 0;                                        /* CVTPL */
+    n1 = ref_CvtDstrL (&a, &v1);
+    n2 = CvtDstrL (&a, &v2);
+    check ("CvtDstrL", (n1 == n2) && (v1 == v2), &a, &a);
+
+    val = (uint32) rand64 ();                           /* CVTLP */
+    val = val >> (rand64 () % 32);
+    r1 = r2 = Dstr_zero;
+    ref_CvtLDstr (val, &r1);
+    CvtLDstr (val, &r2);
+    check ("CvtLDstr", SAME (&r1, &r2), &r1, &r2);
+    }
+printf ("%ld mismatches in %ld operand pairs\n", bad, count);
+return (bad != 0);
+}
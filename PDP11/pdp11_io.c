@@ -213,6 +213,75 @@ else uba_last = (IOPAGEBASE + off) & PAMASK;            /* yes, use fixed */
 return uba_last;
 }
 
+/* Length of the next piece of a mapped transfer: the bytes from ba, short
+   of lim, which lie in one map page and map to memory starting at ma.
+   Zero if ma itself is nonexistent.
+*/
+
+static uint32 Map_Lnt (uint32 ba, uint32 lim, uint32 ma)
+{
+uint32 lnt = UBM_PAGSIZE - UBM_GETOFF (ba);             /* rest of map page */
+
+if (lnt > (lim - ba))                                   /* past end of xfer? */
+    lnt = lim - ba;
+if (ADDR_IS_MEM (ma + lnt - 1))                         /* all in memory? */
+    return lnt;
+if (ADDR_IS_MEM (ma))                                   /* no, up to NXM */
+    return (uint32) (MEMSIZE - ma);
+return 0;
+}
+
+/* Block moves between memory and an I/O buffer
+
+   Word moves use even lengths and ignore bit <0> of the address, as
+   RdMemW and WrMemW do.  M holds words in host order, so a word buffer
+   is a straight copy; a byte buffer is too if the host is little endian.
+*/
+
+static void Mem_ReadB (uint32 pa, uint32 lnt, uint8 *buf)
+{
+#if !defined (UC15)
+if (sim_end) {                                          /* little endian? */
+    memcpy (buf, ((uint8 *) M) + pa, lnt);
+    return;
+    }
+#endif
+for ( ; lnt; pa++, lnt--)                               /* by bytes */
+    *buf++ = (uint8) RdMemB (pa);
+}
+
+static void Mem_ReadW (uint32 pa, uint32 lnt, uint16 *buf)
+{
+#if !defined (UC15)
+memcpy (buf, M + (pa >> 1), lnt);
+#else
+for ( ; lnt; pa = pa + 2, lnt = lnt - 2)                /* by words */
+    *buf++ = (uint16) RdMemW (pa);
+#endif
+}
+
+static void Mem_WriteB (uint32 pa, uint32 lnt, const uint8 *buf)
+{
+#if !defined (UC15)
+if (sim_end) {                                          /* little endian? */
+    memcpy (((uint8 *) M) + pa, buf, lnt);
+    return;
+    }
+#endif
+for ( ; lnt; pa++, lnt--)                               /* by bytes */
+    WrMemB (pa, ((uint16) *buf++));
+}
+
+static void Mem_WriteW (uint32 pa, uint32 lnt, const uint16 *buf)
+{
+#if !defined (UC15)
+memcpy (M + (pa >> 1), buf, lnt);
+#else
+for ( ; lnt; pa = pa + 2, lnt = lnt - 2)                /* by words */
+    WrMemW (pa, *buf++);
+#endif
+}
+
 /* I/O buffer routines, aligned access
 
    Map_ReadB    -       fetch byte buffer from memory
@@ -231,11 +300,14 @@ return uba_last;
      trimmed to 18b.
    - In a Qbus configuration, the map is always disabled.
      Device addresses are trimmed to 22b.
+
+   Memory is moved a map page at a time; the residual count on an NXM
+   is the same as if the transfer had gone byte by byte (word by word).
 */
 
 int32 Map_ReadB (uint32 ba, int32 bc, uint8 *buf)
 {
-uint32 alim, lim, ma;
+uint32 alim, lim, ma, lnt;
 
 if (ba >= IOPAGEBASE) {
     int32 value;
@@ -252,11 +324,15 @@ if (ba >= IOPAGEBASE) {
 ba = ba & BUSMASK;                                      /* trim address */
 lim = ba + bc;
 if (cpu_bme) {                                          /* map enabled? */
-    for ( ; ba < lim; ba++) {                           /* by bytes */
+    while (ba < lim) {                                  /* by map pages */
         ma = Map_Addr (ba);                             /* map addr */
-        if (!ADDR_IS_MEM (ma))                          /* NXM? err */
+        lnt = Map_Lnt (ba, lim, ma);                    /* length in memory */
+        if (lnt == 0)                                   /* NXM? err */
             return (lim - ba);
-        *buf++ = (uint8) RdMemB (ma);                   /* get byte */
+        Mem_ReadB (ma, lnt, buf);
+        uba_last = ma + lnt - 1;                        /* last mapped */
+        ba = ba + lnt;
+        buf = buf + lnt;
         }
     return 0;
     }
@@ -266,16 +342,14 @@ else {                                                  /* physical */
     else if (ADDR_IS_MEM (ba))                          /* no, strt ok? */
         alim = MEMSIZE;
     else return bc;                                     /* no, err */
-    for ( ; ba < alim; ba++) {                          /* by bytes */
-        *buf++ = (uint8) RdMemB (ba);                   /* get byte */
-        }
+    Mem_ReadB (ba, alim - ba, buf);
     return (lim - alim);
     }
 }
 
 int32 Map_ReadW (uint32 ba, int32 bc, uint16 *buf)
 {
-uint32 alim, lim, ma;
+uint32 alim, lim, ma, lnt;
 
 if (ba >= IOPAGEBASE) {
     int32 value;
@@ -293,11 +367,15 @@ if (ba >= IOPAGEBASE) {
 ba = (ba & BUSMASK) & ~01;                              /* trim, align addr */
 lim = ba + (bc & ~01);
 if (cpu_bme) {                                          /* map enabled? */
-    for (; ba < lim; ba = ba + 2) {                     /* by words */
+    while (ba < lim) {                                  /* by map pages */
         ma = Map_Addr (ba);                             /* map addr */
-        if (!ADDR_IS_MEM (ma))                          /* NXM? err */
+        lnt = Map_Lnt (ba, lim, ma & ~01);              /* length in memory */
+        if (lnt == 0)                                   /* NXM? err */
             return (lim - ba);
-        *buf++ = (uint16) RdMemW (ma);
+        Mem_ReadW (ma, lnt, buf);
+        uba_last = ma + lnt - 2;                        /* last mapped */
+        ba = ba + lnt;
+        buf = buf + (lnt >> 1);
         }
     return 0;
     }
@@ -307,16 +385,14 @@ else {                                                  /* physical */
     else if (ADDR_IS_MEM (ba))                          /* no, strt ok? */
         alim = MEMSIZE;
     else return bc;                                     /* no, err */
-    for ( ; ba < alim; ba = ba + 2) {                   /* by words */
-        *buf++ = (uint16) RdMemW (ba);
-        }
+    Mem_ReadW (ba, alim - ba, buf);
     return (lim - alim);
     }
 }
 
 int32 Map_WriteB (uint32 ba, int32 bc, const uint8 *buf)
 {
-uint32 alim, lim, ma;
+uint32 alim, lim, ma, lnt;
 
 if (ba >= IOPAGEBASE) {
     while (bc) {
@@ -330,11 +406,15 @@ if (ba >= IOPAGEBASE) {
 ba = ba & BUSMASK;                                      /* trim address */
 lim = ba + bc;
 if (cpu_bme) {                                          /* map enabled? */
-    for ( ; ba < lim; ba++) {                           /* by bytes */
+    while (ba < lim) {                                  /* by map pages */
         ma = Map_Addr (ba);                             /* map addr */
-        if (!ADDR_IS_MEM (ma))                          /* NXM? err */
+        lnt = Map_Lnt (ba, lim, ma);                    /* length in memory */
+        if (lnt == 0)                                   /* NXM? err */
             return (lim - ba);
-        WrMemB (ma, ((uint16) *buf++));
+        Mem_WriteB (ma, lnt, buf);
+        uba_last = ma + lnt - 1;                        /* last mapped */
+        ba = ba + lnt;
+        buf = buf + lnt;
         }
     return 0;
     }
@@ -344,16 +424,14 @@ else {                                                  /* physical */
     else if (ADDR_IS_MEM (ba))                          /* no, strt ok? */
         alim = MEMSIZE;
     else return bc;                                     /* no, err */
-    for ( ; ba < alim; ba++) {                          /* by bytes */
-        WrMemB (ba, ((uint16) *buf++));
-        }
+    Mem_WriteB (ba, alim - ba, buf);
     return (lim - alim);
     }
 }
 
 int32 Map_WriteW (uint32 ba, int32 bc, const uint16 *buf)
 {
-uint32 alim, lim, ma;
+uint32 alim, lim, ma, lnt;
 
 if (ba >= IOPAGEBASE) {
     if ((ba & 1) || (bc & 1))
@@ -369,11 +447,15 @@ if (ba >= IOPAGEBASE) {
 ba = (ba & BUSMASK) & ~01;                              /* trim, align addr */
 lim = ba + (bc & ~01);
 if (cpu_bme) {                                          /* map enabled? */
-    for (; ba < lim; ba = ba + 2) {                     /* by words */
+    while (ba < lim) {                                  /* by map pages */
         ma = Map_Addr (ba);                             /* map addr */
-        if (!ADDR_IS_MEM (ma))                          /* NXM? err */
+        lnt = Map_Lnt (ba, lim, ma & ~01);              /* length in memory */
+        if (lnt == 0)                                   /* NXM? err */
             return (lim - ba);
-        WrMemW (ma, *buf++);
+        Mem_WriteW (ma, lnt, buf);
+        uba_last = ma + lnt - 2;                        /* last mapped */
+        ba = ba + lnt;
+        buf = buf + (lnt >> 1);
         }
     return 0;
     }
@@ -383,9 +465,7 @@ else {                                                  /* physical */
     else if (ADDR_IS_MEM (ba))                          /* no, strt ok? */
         alim = MEMSIZE;
     else return bc;                                     /* no, err */
-    for ( ; ba < alim; ba = ba + 2) {                   /* by words */
-        WrMemW (ba, *buf++);
-        }
+    Mem_WriteW (ba, alim - ba, buf);
     return (lim - alim);
     }
 }
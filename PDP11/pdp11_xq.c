@@ -277,6 +277,10 @@ t_stat xq_show_sanity (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
 t_stat xq_set_sanity (UNIT* uptr, int32 val, CONST char* cptr, void* desc);
 t_stat xq_show_throttle (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
 t_stat xq_set_throttle (UNIT* uptr, int32 val, CONST char* cptr, void* desc);
+t_stat xq_show_coalesce (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
+t_stat xq_set_coalesce (UNIT* uptr, int32 val, CONST char* cptr, void* desc);
+t_stat xq_show_capture (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
+t_stat xq_set_capture (UNIT* uptr, int32 val, CONST char* cptr, void* desc);
 t_stat xq_show_lockmode (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
 t_stat xq_set_lockmode (UNIT* uptr, int32 val, CONST char* cptr, void* desc);
 t_stat xq_show_poll (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
@@ -285,6 +289,7 @@ t_stat xq_show_leds (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
 t_stat xq_process_xbdl(CTLR* xq);
 t_stat xq_dispatch_xbdl(CTLR* xq);
 t_stat xq_process_turbo_rbdl(CTLR* xq);
+void xq_process_receive_batch(CTLR* xq);
 t_stat xq_process_turbo_xbdl(CTLR* xq);
 void xq_start_receiver(CTLR* xq);
 void xq_stop_receiver(CTLR* xq);
@@ -414,6 +419,8 @@ REG xqa_reg[] = {
   { GRDATA ( IDTMR, xqa.idtmr, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( VECTOR, xqa_dib.vec, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( MUST_POLL, xqa.must_poll, XQ_RDX, 32, 0), REG_HRO},
+  { GRDATA ( CPKTS, xqa.coalesce_packets, XQ_RDX, 32, 0), REG_HRO},
+  { GRDATA ( CTIME, xqa.coalesce_time, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( SANT_ENAB, xqa.sanity.enabled, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( SANT_QSECS, xqa.sanity.quarter_secs, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( SANT_TIMR, xqa.sanity.timer, XQ_RDX, 32, 0), REG_HRO},
@@ -478,6 +485,8 @@ REG xqb_reg[] = {
   { GRDATA ( IDTMR, xqb.idtmr, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( VECTOR, xqb_dib.vec, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( MUST_POLL, xqb.must_poll, XQ_RDX, 32, 0), REG_HRO},
+  { GRDATA ( CPKTS, xqb.coalesce_packets, XQ_RDX, 32, 0), REG_HRO},
+  { GRDATA ( CTIME, xqb.coalesce_time, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( SANT_ENAB, xqb.sanity.enabled, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( SANT_QSECS, xqb.sanity.quarter_secs, XQ_RDX, 32, 0), REG_HRO},
   { GRDATA ( SANT_TIMR, xqb.sanity.timer, XQ_RDX, 32, 0), REG_HRO},
@@ -515,6 +524,12 @@ MTAB xq_mod[] = {
     &xq_set_sanity, &xq_show_sanity, NULL, "Sanity timer" },
   { MTAB_XTD|MTAB_VDV|MTAB_VALR, 0, "THROTTLE", "THROTTLE=DISABLED|TIME=n{;BURST=n{;DELAY=n}}",
     &xq_set_throttle, &xq_show_throttle, NULL, "Display transmit throttle configuration" },
+  { MTAB_XTD|MTAB_VDV|MTAB_VALR, 0, "COALESCE", "COALESCE=DISABLED|PACKETS=n{;TIME=n}",
+    &xq_set_coalesce, &xq_show_coalesce, NULL, "Display receive interrupt coalescing configuration" },
+  { MTAB_XTD|MTAB_VDV|MTAB_VALR|MTAB_NC, 0, "CAPTURE", "CAPTURE=file{;SNAPLEN=n}{;RING=n}",
+    &xq_set_capture, &xq_show_capture, NULL, "Capture LAN traffic to a pcapng file" },
+  { MTAB_XTD|MTAB_VDV, 1, NULL, "NOCAPTURE",
+    &xq_set_capture, NULL, NULL, "Stop capturing LAN traffic" },
   { MTAB_XTD|MTAB_VDV|MTAB_VALR, 0, "DEQNALOCK", "DEQNALOCK={ON|OFF}",
     &xq_set_lockmode, &xq_show_lockmode, NULL, "DEQNA-Lock mode" },
   { MTAB_XTD|MTAB_VDV,           0, "LEDS", NULL,
@@ -948,6 +963,49 @@ t_stat xq_set_throttle (UNIT* uptr, int32 val, CONST char* cptr, void* desc)
   return SCPE_OK;
 }
 
+t_stat xq_show_coalesce (FILE* st, UNIT* uptr, int32 val, CONST void* desc)
+{
+  CTLR* xq = xq_unit2ctlr(uptr);
+
+  if (xq->var->coalesce_packets <= 1)
+    fprintf(st, "coalesce=disabled");
+  else
+    fprintf(st, "coalesce=packets=%d;time=%d", xq->var->coalesce_packets, xq->var->coalesce_time);
+  return SCPE_OK;
+}
+
+t_stat xq_set_coalesce (UNIT* uptr, int32 val, CONST char* cptr, void* desc)
+{
+  CTLR* xq = xq_unit2ctlr(uptr);
+  t_stat r;
+
+  r = eth_coalesce_scan (&xq->var->coalesce_packets, &xq->var->coalesce_time, cptr);
+  if (r != SCPE_OK)
+    return r;
+  if (xq->var->etherface)
+    eth_set_coalesce (xq->var->etherface, xq->var->coalesce_packets, xq->var->coalesce_time);
+  return SCPE_OK;
+}
+
+t_stat xq_show_capture (FILE* st, UNIT* uptr, int32 val, CONST void* desc)
+{
+  CTLR* xq = xq_unit2ctlr(uptr);
+
+  return eth_show_capture(st, xq->var->etherface);
+}
+
+t_stat xq_set_capture (UNIT* uptr, int32 val, CONST char* cptr, void* desc)
+{
+  CTLR* xq = xq_unit2ctlr(uptr);
+
+  if (val)                                  /* NOCAPTURE */
+    cptr = NULL;
+  else
+    if ((!cptr) || (!*cptr))
+      return SCPE_ARG;
+  return eth_set_capture(xq->var->etherface, cptr);
+}
+
 t_stat xq_show_lockmode (FILE* st, UNIT* uptr, int32 val, CONST void* desc)
 {
   CTLR* xq = xq_unit2ctlr(uptr);
@@ -1301,6 +1359,18 @@ t_stat xq_process_rbdl(CTLR* xq)
   return SCPE_OK;
 }
 
+/*
+** deliver the queued receive packets to the host as a single batch
+** (and thus at most a single receive interrupt)
+*/
+void xq_process_receive_batch(CTLR* xq)
+{
+  int queued = xq->var->ReadQ.count;
+
+  xq_process_rbdl(xq);
+  eth_coalesce_batch(xq->var->etherface, queued - xq->var->ReadQ.count, xq->var->ReadQ.count);
+}
+
 t_stat xq_process_mop(CTLR* xq)
 {
   uint32 address;
@@ -2734,8 +2804,9 @@ t_stat xq_svc(UNIT* uptr)
     t_stat status;
 
     /* First pump any queued packets into the system */
-    if ((xq->var->ReadQ.count > 0) && ((xq->var->mode == XQ_T_DELQA_PLUS) || (~xq->var->csr & XQ_CSR_RL)))
-      xq_process_rbdl(xq);
+    if ((xq->var->ReadQ.count > 0) && ((xq->var->mode == XQ_T_DELQA_PLUS) || (~xq->var->csr & XQ_CSR_RL)) &&
+        !eth_coalesce_hold (xq->var->etherface, xq->var->ReadQ.count, uptr))
+      xq_process_receive_batch(xq);
 
     /* Now read and queue packets that have arrived */
     /* This is repeated as long as they are available */
@@ -2745,8 +2816,9 @@ t_stat xq_svc(UNIT* uptr)
     } while (status);
 
     /* Now pump any still queued packets into the system */
-    if ((xq->var->ReadQ.count > 0) && ((xq->var->mode == XQ_T_DELQA_PLUS) || (~xq->var->csr & XQ_CSR_RL)))
-      xq_process_rbdl(xq);
+    if ((xq->var->ReadQ.count > 0) && ((xq->var->mode == XQ_T_DELQA_PLUS) || (~xq->var->csr & XQ_CSR_RL)) &&
+        !eth_coalesce_hold (xq->var->etherface, xq->var->ReadQ.count, uptr))
+      xq_process_receive_batch(xq);
   }
 
   /* resubmit service timer */
@@ -2876,6 +2948,7 @@ t_stat xq_attach(UNIT* uptr, CONST char* cptr)
     return status;
   }
   eth_set_throttle (xq->var->etherface, xq->var->throttle_time, xq->var->throttle_burst, xq->var->throttle_delay);
+  eth_set_coalesce (xq->var->etherface, xq->var->coalesce_packets, xq->var->coalesce_time);
   if (xq->var->poll == 0) {
     status = eth_set_async(xq->var->etherface, xq->var->coalesce_latency_ticks);
     if (status != SCPE_OK) {
@@ -3281,6 +3354,46 @@ const char helpString[] =
     " the TIME gap that will cause a delay in sending subsequent packets.\n"
     " DELAY specifies the number of milliseconds which a throttled packet will\n"
     " be delayed prior to its transmission.\n"
+    "\n"
+     /****************************************************************************/
+    "3 COALESCE\n"
+    " Each packet received by a DELQA-T/DELQA/DEQNA device normally produces\n"
+    " its own receive interrupt.  On a busy LAN the simulated operating system\n"
+    " can spend much of its time servicing those interrupts.  Receive interrupt\n"
+    " coalescing holds arriving packets until either a batch of them has been\n"
+    " collected or the first of them has waited a specified time.  The whole\n"
+    " batch is then placed in the host's receive buffers and a single receive\n"
+    " interrupt is posted.\n"
+    "\n"
+    " Coalescing is configured with the SET XQ COALESCE commands:\n"
+    "\n"
+    "+sim> SET XQ COALESCE=DISABLED\n"
+    "+sim> SET XQ COALESCE=PACKETS=n;TIME=t\n"
+    "\n"
+    " PACKETS specifies the number of packets (up to 64) in a batch.\n"
+    " TIME specifies the number of microseconds of simulated time which a\n"
+    " partial batch will be held before it is delivered (default 500).\n"
+    "\n"
+    " The number of batches delivered, the average and maximum batch size,\n"
+    " the average and maximum time packets were held and the receive\n"
+    " throughput are displayed by SHOW XQ STATS.\n"
+    "\n"
+     /****************************************************************************/
+    "3 CAPTURE\n"
+    " The frames sent and received by an attached device can be captured to a\n"
+    " pcapng format file which can be examined with Wireshark or tcpdump:\n"
+    "\n"
+    "+sim> SET XQ CAPTURE=file.pcapng\n"
+    "+sim> SET XQ CAPTURE=file.pcapng;SNAPLEN=n;RING=r\n"
+    "+sim> SET XQ NOCAPTURE\n"
+    "\n"
+    " SNAPLEN specifies the number of bytes of each frame which are saved\n"
+    " (default is the whole frame).  RING specifies the number of frames which\n"
+    " can be waiting to be written to the file (default 1024).  Frames are\n"
+    " written to the file by a separate thread so capturing has very little\n"
+    " effect on simulator performance.  If the ring ever fills, frames are\n"
+    " dropped from the capture (not from the simulated LAN).  The capture\n"
+    " counters are displayed by SHOW XQ STATS.\n"
     "\n"
      /****************************************************************************/
     "2 Attach\n"
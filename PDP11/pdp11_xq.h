@@ -308,6 +308,8 @@ struct xq_device {
   ETH_QUE           ReadQ;
   int32             idtmr;                              /* countdown for ID Timer */
   uint32            must_poll;                          /* receiver must poll instead of counting on asynch polls */
+  uint32            coalesce_packets;                   /* receive batch size which triggers an interrupt */
+  uint32            coalesce_time;                      /* usecs to hold a partial receive batch */
   t_bool            initialized;                        /* flag for one time initializations */
 };
 
@@ -117,6 +117,10 @@ t_stat xu_show_type (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
 t_stat xu_set_type (UNIT* uptr, int32 val, CONST char* cptr, void* desc);
 t_stat xu_show_throttle (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
 t_stat xu_set_throttle (UNIT* uptr, int32 val, CONST char* cptr, void* desc);
+t_stat xu_show_coalesce (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
+t_stat xu_set_coalesce (UNIT* uptr, int32 val, CONST char* cptr, void* desc);
+t_stat xu_show_capture (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
+t_stat xu_set_capture (UNIT* uptr, int32 val, CONST char* cptr, void* desc);
 int32 xu_int (void);
 t_stat xu_ex (t_value *vptr, t_addr addr, UNIT *uptr, int32 sw);
 t_stat xu_dep (t_value val, t_addr addr, UNIT *uptr, int32 sw);
@@ -127,6 +131,7 @@ void xub_write_callback(int status);
 void xu_setint (CTLR* xu);
 void xu_clrint (CTLR* xu);
 void xu_process_receive(CTLR* xu);
+void xu_process_receive_batch(CTLR* xu);
 void xu_dump_rxring(CTLR* xu);
 void xu_dump_txring(CTLR* xu);
 t_stat xu_show_filters (FILE* st, UNIT* uptr, int32 val, CONST void* desc);
@@ -179,6 +184,12 @@ MTAB xu_mod[] = {
     &xu_set_type, &xu_show_type, NULL, "Display the controller type" },
   { MTAB_XTD|MTAB_VDV|MTAB_VALR, 0, "THROTTLE", "THROTTLE=DISABLED|TIME=n{;BURST=n{;DELAY=n}}",
     &xu_set_throttle, &xu_show_throttle, NULL, "Display transmit throttle configuration" },
+  { MTAB_XTD|MTAB_VDV|MTAB_VALR, 0, "COALESCE", "COALESCE=DISABLED|PACKETS=n{;TIME=n}",
+    &xu_set_coalesce, &xu_show_coalesce, NULL, "Display receive interrupt coalescing configuration" },
+  { MTAB_XTD|MTAB_VDV|MTAB_VALR|MTAB_NC, 0, "CAPTURE", "CAPTURE=file{;SNAPLEN=n}{;RING=n}",
+    &xu_set_capture, &xu_show_capture, NULL, "Capture LAN traffic to a pcapng file" },
+  { MTAB_XTD|MTAB_VDV, 1, NULL, "NOCAPTURE",
+    &xu_set_capture, NULL, NULL, "Stop capturing LAN traffic" },
   { 0 },
 };
 
@@ -192,6 +203,8 @@ REG xua_reg[] = {
   { GRDATA ( TYPE,    xua.type,     XU_RDX, 32, 0), REG_FIT },
   { FLDATA ( INT,     xua.irq, 0) },
   { GRDATA ( IDTMR,   xua.idtmr,    XU_RDX, 32, 0), REG_HRO},
+  { GRDATA ( CPKTS,   xua.coalesce_packets, XU_RDX, 32, 0), REG_HRO},
+  { GRDATA ( CTIME,   xua.coalesce_time, XU_RDX, 32, 0), REG_HRO},
   { BRDATA ( SETUP,   &xua.setup,   XU_RDX, 8, sizeof(xua.setup)), REG_HRO},
   { BRDATA ( STATS,   &xua.stats,   XU_RDX, 8, sizeof(xua.stats)), REG_HRO},
   { GRDATA ( CSR0,    xua.pcsr0,    XU_RDX, 16, 0), REG_FIT },
@@ -269,6 +282,8 @@ REG xub_reg[] = {
   { GRDATA ( TYPE,    xub.type,     XU_RDX, 32, 0), REG_FIT },
   { FLDATA ( INT,     xub.irq, 0) },
   { GRDATA ( IDTMR,   xub.idtmr,    XU_RDX, 32, 0), REG_HRO},
+  { GRDATA ( CPKTS,   xub.coalesce_packets, XU_RDX, 32, 0), REG_HRO},
+  { GRDATA ( CTIME,   xub.coalesce_time, XU_RDX, 32, 0), REG_HRO},
   { BRDATA ( SETUP,   &xub.setup,   XU_RDX, 8, sizeof(xua.setup)), REG_HRO},
   { BRDATA ( STATS,   &xub.stats,   XU_RDX, 8, sizeof(xua.stats)), REG_HRO},
   { GRDATA ( CSR0,    xub.pcsr0,    XU_RDX, 16, 0), REG_FIT },
@@ -410,6 +425,7 @@ t_stat xu_show_stats (FILE* st, UNIT* uptr, int32 val, CONST void* desc)
   fprintf(st, fmt, "Xmit frames(multicast):",  stats->mftrans);
   fprintf(st, fmt, "Xmit dbytes(multicast):",  stats->mtbytes);
   fprintf(st, fmt, "Loopback forward Frames:", stats->loopf);
+  eth_show_dev(st, xu->var->etherface);
   return SCPE_OK;
 }
 
@@ -528,6 +544,49 @@ t_stat xu_set_throttle (UNIT* uptr, int32 val, CONST char* cptr, void* desc)
   return SCPE_OK;
 }
 
+t_stat xu_show_coalesce (FILE* st, UNIT* uptr, int32 val, CONST void* desc)
+{
+  CTLR* xu = xu_unit2ctlr(uptr);
+
+  if (xu->var->coalesce_packets <= 1)
+    fprintf(st, "coalesce=disabled");
+  else
+    fprintf(st, "coalesce=packets=%d;time=%d", xu->var->coalesce_packets, xu->var->coalesce_time);
+  return SCPE_OK;
+}
+
+t_stat xu_set_coalesce (UNIT* uptr, int32 val, CONST char* cptr, void* desc)
+{
+  CTLR* xu = xu_unit2ctlr(uptr);
+  t_stat r;
+
+  r = eth_coalesce_scan (&xu->var->coalesce_packets, &xu->var->coalesce_time, cptr);
+  if (r != SCPE_OK)
+    return r;
+  if (xu->var->etherface)
+    eth_set_coalesce (xu->var->etherface, xu->var->coalesce_packets, xu->var->coalesce_time);
+  return SCPE_OK;
+}
+
+t_stat xu_show_capture (FILE* st, UNIT* uptr, int32 val, CONST void* desc)
+{
+  CTLR* xu = xu_unit2ctlr(uptr);
+
+  return eth_show_capture(st, xu->var->etherface);
+}
+
+t_stat xu_set_capture (UNIT* uptr, int32 val, CONST char* cptr, void* desc)
+{
+  CTLR* xu = xu_unit2ctlr(uptr);
+
+  if (val)                                  /* NOCAPTURE */
+    cptr = NULL;
+  else
+    if ((!cptr) || (!*cptr))
+      return SCPE_ARG;
+  return eth_set_capture(xu->var->etherface, cptr);
+}
+
 /*============================================================================*/
 
 void upd_stat16(uint16* stat, uint16 add)
@@ -713,8 +772,9 @@ t_stat xu_svc(UNIT* uptr)
   CTLR* xu = xu_unit2ctlr(uptr);
 
   /* First pump any queued packets into the system */
-  if ((xu->var->ReadQ.count > 0) && ((xu->var->pcsr1 & PCSR1_STATE) == STATE_RUNNING))
-    xu_process_receive(xu);
+  if ((xu->var->ReadQ.count > 0) && ((xu->var->pcsr1 & PCSR1_STATE) == STATE_RUNNING) &&
+      !eth_coalesce_hold (xu->var->etherface, xu->var->ReadQ.count, uptr))
+    xu_process_receive_batch(xu);
 
   /* Now read and queue packets that have arrived */
   /* This is repeated as long as they are available and we have room */
@@ -726,8 +786,9 @@ t_stat xu_svc(UNIT* uptr)
   } while (queue_size != xu->var->ReadQ.count);
 
   /* Now pump any still queued packets into the system */
-  if ((xu->var->ReadQ.count > 0) && ((xu->var->pcsr1 & PCSR1_STATE) == STATE_RUNNING))
-    xu_process_receive(xu);
+  if ((xu->var->ReadQ.count > 0) && ((xu->var->pcsr1 & PCSR1_STATE) == STATE_RUNNING) &&
+      !eth_coalesce_hold (xu->var->etherface, xu->var->ReadQ.count, uptr))
+    xu_process_receive_batch(xu);
 
   /* resubmit service timer if controller not halted */
   switch (xu->var->pcsr1 & PCSR1_STATE) {
@@ -1188,6 +1249,15 @@ int32 xu_command(CTLR* xu)
   return PCSR0_DNI;
 }
 
+/* Deliver the queued receive packets to the host as a single batch. */
+void xu_process_receive_batch(CTLR* xu)
+{
+  int queued = xu->var->ReadQ.count;
+
+  xu_process_receive(xu);
+  eth_coalesce_batch(xu->var->etherface, queued - xu->var->ReadQ.count, xu->var->ReadQ.count);
+}
+
 /* Transfer received packets into receive ring. */
 void xu_process_receive(CTLR* xu)
 {
@@ -1769,6 +1839,7 @@ t_stat xu_attach(UNIT* uptr, CONST char* cptr)
     return status;
   }
   eth_set_throttle (xu->var->etherface, xu->var->throttle_time, xu->var->throttle_burst, xu->var->throttle_delay);
+  eth_set_coalesce (xu->var->etherface, xu->var->coalesce_packets, xu->var->coalesce_time);
   if (SCPE_OK != eth_check_address_conflict (xu->var->etherface, &xu->var->mac)) {
     char buf[32];
 
@@ -1917,6 +1988,13 @@ fprintf (st, "The controller defaults to a relatively unique MAC address in the
 fprintf (st, "08-00-2B-00-00-00 thru 08-00-2B-FF-FF-FF, which should be sufficient\n");
 fprintf (st, "for most network environments.  If desired, the simulated MAC address\n");
 fprintf (st, "can be directly set.\n");
+fprintf (st, "\nReceive interrupt coalescing (SET XU COALESCE=PACKETS=n;TIME=usecs) holds\n");
+fprintf (st, "arriving packets until n have been collected or the first has waited usecs\n");
+fprintf (st, "microseconds of simulated time, then delivers them with a single interrupt.\n");
+fprintf (st, "Batch and latency counters are displayed by SHOW XU STATS.\n");
+fprintf (st, "\nThe traffic of an attached controller can be captured to a pcapng file\n");
+fprintf (st, "(SET XU CAPTURE=file{;SNAPLEN=n}{;RING=n}) and the capture stopped with\n");
+fprintf (st, "SET XU NOCAPTURE.\n");
 fprintf (st, "To access the network, the simulated Ethernet controller must be attached to a\n");
 fprintf (st, "real Ethernet interface.\n\n");
 eth_attach_help(st, dptr, uptr, flag, cptr);
@@ -131,6 +131,8 @@ struct xu_device {
   ETH_QUE           ReadQ;
   ETH_MAC           load_server;                        /* load server address */
   int               idtmr;                              /* countdown for ID Timer */
+  uint32            coalesce_packets;                   /* receive batch size which triggers an interrupt */
+  uint32            coalesce_time;                      /* usecs to hold a partial receive batch */
   struct xu_setup   setup;
   struct xu_stats   stats;                              /* reportable network statistics */
 
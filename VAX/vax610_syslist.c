@@ -73,7 +73,7 @@ DEVICE *sim_devices[] = {
     &vh_dev,
     &cr_dev,
     &lpt_dev,
-#if defined(USE_SIM_VIDEO) && defined(HAVE_LIBSDL)
+#if defined(USE_SIM_VIDEO) && (defined(HAVE_LIBSDL) || defined(USE_HEADLESS_VIDEO))
     &vc_dev,
     &lk_dev,
     &vs_dev,
@@ -478,6 +478,7 @@ if (qba_map_addr (qa, &ma)) {                           /* map addr */
         int32 t = M[ma >> 2];
         val = ((val & mask) << sc) | (t & ~(mask << sc));
         }
+    ICD_INVAL (ma);
     M[ma >> 2] = val;
     }
 else mem_err = 1;
@@ -55,11 +55,7 @@
 
 #if defined (FULL_VAX)
 
-/* Decimal string structure */
-
-#define DSTRLNT         4
-#define DSTRMAX         (DSTRLNT - 1)
-#define MAXDVAL         429496730                       /* 2^32 / 10 */
+#include "pdp11_dstr.h"
 
 #define C_SPACE         0x20                            /* ASCII chars */
 #define C_PLUS          0x2B
@@ -67,28 +63,13 @@
 #define C_ZERO          0x30
 #define C_NINE          0x39
 
-typedef struct {
-    uint32              sign;
-    uint32              val[DSTRLNT];
-    } DSTR;
-
 static DSTR Dstr_zero = { 0, {0, 0, 0, 0} };
 static DSTR Dstr_one = { 0, {0x10, 0, 0, 0} };
 
 int32 ReadDstr (int32 lnt, int32 addr, DSTR *dec, int32 acc);
 int32 WriteDstr (int32 lnt, int32 addr, DSTR *dec, int32 v, int32 acc);
 int32 SetCCDstr (int32 lnt, DSTR *src, int32 pslv);
-int32 AddDstr (DSTR *src1, DSTR *src2, DSTR *dst, int32 cin);
-void SubDstr (DSTR *src1, DSTR *src2, DSTR *dst);
-int32 CmpDstr (DSTR *src1, DSTR *src2);
-int32 TestDstr (DSTR *dsrc);
 void ProbeDstr (int32 lnt, int32 addr, int32 acc);
-int32 LntDstr (DSTR *dsrc, int32 nz);
-uint32 NibbleLshift (DSTR *dsrc, int32 sc, uint32 cin);
-uint32 NibbleRshift (DSTR *dsrc, int32 sc, uint32 cin);
-int32 WordLshift (DSTR *dsrc, int32 sc);
-void WordRshift (DSTR *dsrc, int32 sc);
-void CreateTable (DSTR *dsrc, DSTR mtable[10]);
 int32 do_crc_4b (int32 crc, int32 tbl, int32 acc);
 int32 edit_read_src (int32 inc, int32 acc);
 void edit_adv_src (int32 inc);
@@ -104,10 +85,9 @@ int32 i, j, c, t, pop, rpt, V;
 int32 match, fill, sign, shift;
 int32 ldivd, ldivr;
 int32 lenl, lenp;
-uint32 nc, d, result;
+uint32 d, result;
 t_stat r;
-DSTR accum, src1, src2, dst;
-DSTR mptable[10];
+DSTR src1, src2, dst;
 
 switch (opc) {                                          /* case on opcode */
 
@@ -515,17 +495,7 @@ switch (opc) {                                          /* case on opcode */
         if (ReadDstr (op[0], op[1], &src1, acc) &&      /* read src1, src2 */
             ReadDstr (op[2], op[3], &src2, acc)) {      /* if both > 0 */
             dst.sign = src1.sign ^ src2.sign;           /* sign of result */
-            accum = Dstr_zero;                          /* clear accum */
-            NibbleRshift (&src1, 1, 0);                 /* shift out sign */
-            CreateTable (&src1, mptable);               /* create *1, *2, ... */
-            for (i = 1; i < (DSTRLNT * 8); i++) {       /* 31 iterations */
-                d = (src2.val[i / 8] >> ((i % 8) * 4)) & 0xF;
-                if (d > 0)                              /* add in digit*mpcnd */
-                    AddDstr (&mptable[d], &accum, &accum, 0);
-                nc = NibbleRshift (&accum, 1, 0);       /* ac right 4 */
-                NibbleRshift (&dst, 1, nc);             /* result right 4 */
-                }
-            V = TestDstr (&accum) != 0;                 /* if ovflo, set V */
+            V = MulDstr (&src1, &src2, &dst);           /* if ovflo, set V */
             }
         else V = 0;                                     /* result = 0 */
         cc = WriteDstr (op[4], op[5], &dst, V, acc);    /* store result */
@@ -574,20 +544,7 @@ switch (opc) {                                          /* case on opcode */
         NibbleRshift (&src2, 1, 0);
         if ((t = ldivd - ldivr) >= 0) {                 /* any divide to do? */
             dst.sign = src1.sign ^ src2.sign;           /* calculate sign */
-            WordLshift (&src1, t / 8);                  /* align divr to divd */
-            NibbleLshift (&src1, t % 8, 0);
-            CreateTable (&src1, mptable);               /* create *1, *2, ... */
-            for (i = 0; i <= t; i++) {                  /* divide loop */
-                for (d = 9; d > 0; d--) {               /* find digit */
-                    if (CmpDstr (&src2, &mptable[d]) >= 0) {
-                        SubDstr (&mptable[d], &src2, &src2);
-                        dst.val[0] = dst.val[0] | d;
-                        break;
-                        }                               /* end if */
-                    }                                   /* end for */
-                NibbleLshift (&src2, 1, 0);             /* shift dividend */
-                NibbleLshift (&dst, 1, 0);              /* shift quotient */
-                }                                       /* end divide loop */
+            DivDstr (&src1, &src2, &dst, t);            /* divide magnitudes */
             }                                           /* end if */
         cc = WriteDstr (op[4], op[5], &dst, 0, acc);    /* store result */
         R[0] = 0;
@@ -712,17 +669,8 @@ switch (opc) {                                          /* case on opcode */
         if ((PSL & PSL_FPD) || (op[0] > 31))
             RSVD_OPND_FAULT;
         ReadDstr (op[0], op[1], &src1, acc);            /* get source */
-        V = result = 0;                                 /* clear V, result */
-        for (i = (DSTRLNT * 8) - 1; i > 0; i--) {       /* loop thru digits */
-            d = (src1.val[i / 8] >> ((i % 8) * 4)) & 0xF;
-            if (d || result || V) {                     /* skip initial 0's */
-                if (result >= MAXDVAL)
-                    V = 1;
-                result = ((result * 10) + d) & LMASK;
-                if (result < d)
-                    V = 1;
-                }                                       /* end if */
-            }                                           /* end for */
+        V = 0;                                          /* clear V */
+        result = CvtDstrL (&src1, &V);                  /* convert magnitude */
         if (src1.sign)                                  /* negative? */
             result = (~result + 1) & LMASK;
         if (src1.sign ^ ((result & LSIGN) != 0))        /* test for overflow */
@@ -766,11 +714,7 @@ switch (opc) {                                          /* case on opcode */
             dst.sign = 1;
             result = (~result + 1) & LMASK;
             }
-        for (i = 1; (i < (DSTRLNT * 8)) && result; i++) {
-            d = result % 10;
-            result = result / 10;
-            dst.val[i / 8] = dst.val[i / 8] | (d << ((i % 8) * 4));
-            }
+        CvtLDstr (result, &dst);                        /* convert magnitude */
         cc = WriteDstr (op[1], op[2], &dst, 0, acc);    /* write result */
         R[0] = 0;
         R[1] = 0;
@@ -1319,265 +1263,6 @@ Read ((addr + lnt) & LMASK, L_BYTE, acc);
 return;
 }
 
-/* Add decimal string magnitudes
-
-   Arguments:
-        s1      =       src1 decimal string
-        s2      =       src2 decimal string
-        ds      =       dest decimal string
-        cy      =       carry in
-   Output       =       1 if carry, 0 if no carry
-
-   This algorithm courtesy Anton Chernoff, circa 1992 or even earlier.
-
-   We trace the history of a pair of adjacent digits to see how the
-   carry is fixed; each parenthesized item is a 4b digit.
-
-   Assume we are adding:
-
-        (a)(b)  I
-   +    (x)(y)  J
-
-   First compute I^J:
-
-        (a^x)(b^y)      TMP
-
-   Note that the low bit of each digit is the same as the low bit of
-   the sum of the digits, ignoring the carry, since the low bit of the
-   sum is the xor of the bits.
-
-   Now compute I+J+66 to get decimal addition with carry forced left
-   one digit:
-
-        (a+x+6+carry mod 16)(b+y+6 mod 16)      SUM
-
-   Note that if there was a carry from b+y+6, then the low bit of the
-   left digit is different from the expected low bit from the xor.
-   If we xor this SUM into TMP, then the low bit of each digit is 1
-   if there was a carry, and 0 if not.  We need to subtract 6 from each
-   digit that did not have a carry, so take ~(SUM ^ TMP) & 0x11, shift
-   it right 4 to the digits that are affected, and subtract 6*adjustment
-   (actually, shift it right 3 and subtract 3*adjustment).
-*/
-
-int32 AddDstr (DSTR *s1, DSTR *s2, DSTR *ds, int32 cy)
-{
-int32 i;
-uint32 sm1, sm2, tm1, tm2, tm3, tm4;
-
-for (i = 0; i < DSTRLNT; i++) {                         /* loop low to high */
-    tm1 = s1->val[i] ^ (s2->val[i] + cy);               /* xor operands */
-    sm1 = s1->val[i] + (s2->val[i] + cy);               /* sum operands */
-    sm2 = sm1 + 0x66666666;                             /* force carry out */
-    cy = ((sm1 < s1->val[i]) || (sm2 < sm1));           /* check for overflow */
-    tm2 = tm1 ^ sm2;                                    /* get carry flags */
-    tm3 = (tm2 >> 3) | (cy << 29);                      /* compute adjustment */
-    tm4 = 0x22222222 & ~tm3;                            /* clear where carry */
-    ds->val[i] = (sm2 - (3 * tm4)) & LMASK;             /* final result */
-    }
-return cy;
-}
-
-/* Subtract decimal string magnitudes
-
-   Arguments:
-        s1      =       src1 decimal string
-        s2      =       src2 decimal string
-        ds      =       dest decimal string
-   Outputs:             s2 - s1 in ds
-
-   Note: the routine assumes that s1 <= s2
-
-*/
-
-void SubDstr (DSTR *s1, DSTR *s2, DSTR *ds)
-{
-int32 i;
-DSTR complX;
-
-for (i = 0; i < DSTRLNT; i++)                           /* 10's comp s2 */
-    complX.val[i] = 0x99999999 - s1->val[i];
-AddDstr (&complX, s2, ds, 1);                            /* s1 + ~s2 + 1 */
-return;
-}
-
-/* Compare decimal string magnitudes
-
-   Arguments:
-        s1      =       src1 decimal string
-        s2      =       src2 decimal string
-   Output       =       1 if >, 0 if =, -1 if <
-*/
-
-int32 CmpDstr (DSTR *s1, DSTR *s2)
-{
-int32 i;
-
-for (i = DSTRMAX; i >=0; i--) {
-    if (s1->val[i] > s2->val[i])
-        return 1;
-    if (s1->val[i] < s2->val[i])
-        return -1;
-    }
-return 0;
-}
-
-/* Test decimal string for zero
-
-   Arguments:
-        dsrc    =       decimal string structure
-
-   Returns the non-zero length of the string, in int32 units
-   If the string is zero, the sign is cleared
-*/
-
-int32 TestDstr (DSTR *dsrc)
-{
-int32 i;
-
-for (i = DSTRMAX; i >= 0; i--) {
-    if (dsrc->val[i])
-        return (i + 1);
-    }
-dsrc->sign = 0;
-return 0;
-}
-
-/* Get exact length of decimal string
-
-   Arguments:
-        dsrc    =       decimal string structure
-        nz      =       result from TestDstr
-*/
-
-int32 LntDstr (DSTR *dsrc, int32 nz)
-{
-int32 i;
-
-if (nz == 0)
-    return 0;
-for (i = 7; i >= 0; i--) {
-    if ((dsrc->val[nz - 1] >> (i * 4)) & 0xF)
-        break;
-    }
-return ((nz - 1) * 8) + i;
-}
-
-/* Create table of multiples
-
-   Arguments:
-        dsrc    =       base decimal string structure
-        mtable[10] =    array of decimal string structures
-
-   Note that dsrc has a high order zero nibble; this
-   guarantees that the largest multiple won't overflow
-   Also note that mtable[0] is not filled in
-*/
-
-void CreateTable (DSTR *dsrc, DSTR mtable[10])
-{
-int32 (i);
-
-mtable[1] = *dsrc;
-for (i = 2; i < 10; i++)
-    AddDstr (&mtable[1], &mtable[i-1], &mtable[i], 0);
-return;
-}
-
-/* Word shift right
-
-   Arguments:
-        dsrc    =       decimal string structure
-        sc      =       shift count
-*/
-
-void WordRshift (DSTR *dsrc, int32 sc)
-{
-int32 i;
-
-if (sc != 0) {
-    for (i = 0; i < DSTRLNT; i++) {
-        if ((i + sc) < DSTRLNT)
-            dsrc->val[i] = dsrc->val[i + sc];
-        else dsrc->val[i] = 0;
-        }
-    }
-return;
-}
-
-/* Word shift left
-
-   Arguments:
-        dsrc    =       decimal string structure
-        sc      =       shift count
-*/
-
-int32 WordLshift (DSTR *dsrc, int32 sc)
-{
-int32 i, c, zc;
-
-c = 0;
-if (sc != 0) {
-    for (i = DSTRMAX; i >= 0; i--) {                    /* work hi to low */
-        if ((i + sc) <= DSTRMAX)                        /* move in range? */
-            dsrc->val[i + sc] = dsrc->val[i];
-        else c |= dsrc->val[i];                         /* no, count as ovflo */
-        }
-    zc = (sc >= DSTRLNT)? DSTRLNT: sc;                  /* cap fill */
-    for (i = 0; i < zc; i++)                            /* fill with 0s */
-        dsrc->val[i] = 0;
-    }
-return c;
-}               
-
-/* Nibble shift decimal string right
-
-   Arguments:
-        dsrc    =       decimal string structure
-        sc      =       shift count
-        cin     =       carry in
-*/
-
-uint32 NibbleRshift (DSTR *dsrc, int32 sc, uint32 cin)
-{
-int32 i, s, nc;
-
-if ((s = sc * 4) != 0) {
-    for (i = DSTRMAX; i >= 0; i--) {
-        nc = (dsrc->val[i] << (32 - s)) & LMASK;
-        dsrc->val[i] = ((dsrc->val[i] >> s) |
-            cin) & LMASK;
-        cin = nc;
-        }
-    return cin;
-    }
-return 0;
-}
-
-/* Nibble shift decimal string left
-
-   Arguments:
-        dsrc    =       decimal string structure
-        sc      =       shift count
-        cin     =       carry in
-*/
-
-uint32 NibbleLshift (DSTR *dsrc, int32 sc, uint32 cin)
-{
-int32 i, s, nc;
-
-if ((s = sc * 4) != 0) {
-    for (i = 0; i < DSTRLNT; i++) {
-        nc = dsrc->val[i] >> (32 - s);
-        dsrc->val[i] = ((dsrc->val[i] << s) |
-            cin) & LMASK;
-        cin = nc;
-        }
-    return cin;
-    }
-return 0;
-}
-
 /* Do 4b of CRC calculation
 
    Arguments:
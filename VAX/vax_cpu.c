@@ -186,12 +186,18 @@
 
 #define UNIT_V_CONH     (UNIT_V_UF + 0)                 /* halt to console */
 #define UNIT_V_MSIZE    (UNIT_V_UF + 1)                 /* dummy */
+#define UNIT_V_NOICD    (UNIT_V_UF + 2)                 /* no decode cache */
 #define UNIT_CONH       (1u << UNIT_V_CONH)
 #define UNIT_MSIZE      (1u << UNIT_V_MSIZE)
+#define UNIT_NOICD      (1u << UNIT_V_NOICD)
 #define GET_CUR         acc = ACC_MASK (PSL_GETCUR (PSL))
 
 #define OPND_SIZE       16
 #define INST_SIZE       52
+#define ICD_SIZE        16384                           /* decode cache entries */
+#define ICD_MASK        (ICD_SIZE - 1)
+#define ICD_NVAL        14                              /* istream values/entry */
+#define ICD_INVPA       0xFFFFFFFF                      /* invalid entry tag */
 #define op0             opnd[0]
 #define op1             opnd[1]
 #define op2             opnd[2]
@@ -263,6 +269,7 @@ int32 cpu_astop = 0;
 int32 mchk_va, mchk_ref;                                /* mem ref param */
 int32 ibufl, ibufh;                                     /* prefetch buf */
 int32 ibcnt, ppc;                                       /* prefetch ctl */
+uint32 *icd_pgen = NULL;                                /* decode cache page gens */
 uint32 cpu_idle_mask = VAX_IDLE_VMS;                    /* idle mask */
 uint32 cpu_idle_type = 1;                               /* default VMS */
 int32 extra_bytes;                                      /* bytes referenced by current string instruction */
@@ -277,6 +284,20 @@ FILE *hst_log;                                          /* history log file */
 int32 hst_log_p;                                        /* history last log written pointer */
 int32 step_out_nest_level = 0;                          /* step to call return - nest level */
 
+typedef struct {
+    uint32      pa;                                     /* physical PC */
+    uint32      gen;                                    /* page generation */
+    int32       val[ICD_NVAL];                          /* istream values */
+    } ICD_ENT;
+
+static ICD_ENT *icd = NULL;                             /* decode cache */
+static ICD_ENT *icd_ent = NULL;                         /* entry being recorded */
+static int32 *icd_rp = NULL;                            /* replay pointer */
+static int32 *icd_wp = NULL;                            /* record pointer */
+static uint32 icd_pa;                                   /* physical PC of instr */
+t_uint64 icd_hit = 0;                                   /* decode cache hits */
+t_uint64 icd_miss = 0;                                  /* decode cache misses */
+
 const uint32 byte_mask[33] = { 0x00000000,
  0x00000001, 0x00000003, 0x00000007, 0x0000000F,
  0x0000001F, 0x0000003F, 0x0000007F, 0x000000FF,
@@ -319,6 +340,10 @@ t_stat cpu_show_idle (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 const char *cpu_description (DEVICE *dptr);
 int32 cpu_get_vsw (int32 sw);
 static SIM_INLINE int32 get_istr (int32 lnt, int32 acc);
+static SIM_INLINE void icd_lookup (void);
+static SIM_INLINE void icd_done (void);
+static t_stat icd_alloc (void);
+static void icd_flush (void);
 int32 ReadOcta (int32 va, int32 *opnd, int32 j, int32 acc);
 t_bool cpu_show_opnd (FILE *st, InstHistory *h, int32 line);
 t_stat cpu_show_hist_records (FILE *st, t_bool do_header, int32 start, int32 count);
@@ -412,12 +437,18 @@ REG cpu_reg[] = {
     { HRDATA (BADABO, badabo, 32), REG_HRO },
     { HRDATAD (WRU, sim_int_char, 8, "interrupt character") },
     { HRDATA (MODEL, sys_model, 32), REG_HRO },
+    { DRDATA (ICDHIT, icd_hit, 64), REG_HRO },
+    { DRDATA (ICDMISS, icd_miss, 64), REG_HRO },
     { NULL }
     };
 
 MTAB cpu_mod[] = {
     { UNIT_CONH, 0, "HALT to SIMH", "SIMHALT", NULL, NULL, NULL, "Set HALT to trap to simulator" },
     { UNIT_CONH, UNIT_CONH, "HALT to console", "CONHALT", NULL, NULL, NULL, "Set HALT to trap to console ROM" },
+    { UNIT_NOICD, 0, "decode cache", "DECODECACHE", NULL, NULL, NULL, "Enable decoded instruction cache" },
+    { UNIT_NOICD, UNIT_NOICD, "no decode cache", "NODECODECACHE", NULL, NULL, NULL, "Disable decoded instruction cache" },
+    { UNIT_NOHFP, 0, "host floating point", "HOSTFP", NULL, NULL, NULL, "Use host arithmetic for F and G floating" },
+    { UNIT_NOHFP, UNIT_NOHFP, "no host floating point", "NOHOSTFP", NULL, NULL, NULL, "Use only simulated F and G floating arithmetic" },
     { MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE={VMS|ULTRIX|ULTRIX-1.X|ULTRIXOLD|NETBSD|NETBSDOLD|OPENBSD|OPENBSDOLD|QUASIJARUS|32V|ELN}{:n}", &cpu_set_idle, &cpu_show_idle, NULL, "Display idle detection mode" },
     { MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL, NULL,  "Disables idle detection" },
     MEM_MODIFIERS,   /* Model specific memory modifiers from vaxXXX_defs.h */
@@ -484,6 +515,8 @@ int32 spec = 0, disp = 0, rn = 0, index = 0, numspec = 0;
 int32 vfldrp1 = 0, brdisp = 0, flg = 0, mstat = 0;
 uint32 va = 0, iad = 0;
 int32 opnd[OPND_SIZE];                                  /* operand queue */
+t_bool icd_on = (icd != NULL) &&                        /* decode cache on? */
+    !(cpu_unit.flags & UNIT_NOICD);
 
 if ((ret = build_dib_tab ()) != SCPE_OK)                /* build, chk dib_tab */
     return ret;
@@ -500,9 +533,11 @@ set_map_reg ();                                         /* set map reg */
 GET_CUR;                                                /* set access mask */
 SET_IRQL;                                               /* eval interrupts */
 FLUSH_ISTR;                                             /* clear prefetch */
+icd_rp = icd_wp = NULL;                                 /* not replaying */
 
 abortval = setjmp (save_env);                           /* set abort hdlr */
 if (abortval > 0) {                                     /* sim stop? */
+    icd_rp = icd_wp = NULL;                             /* abandon decode */
     PSL = PSL | cc;                                     /* put PSL together */
     pcq_r->qptr = pcq_p;                                /* update pc q ptr */
     if (hst_log) {                                      /* auto logging history? */
@@ -527,6 +562,7 @@ else if (abortval < 0) {                                /* mm or rsrv or int */
     recqptr = 0;                                        /* clear queue */
     delta = PC - fault_PC;                              /* save delta PC */
     SETPC (fault_PC);                                   /* restore PC */
+    icd_rp = icd_wp = NULL;                             /* abandon decode */
     switch (-abortval) {                                /* case on abort code */
 
     case SCB_RESIN:                                     /* rsrv inst fault */
@@ -707,6 +743,8 @@ for ( ;; ) {
 
     sim_interval = sim_interval - (1 + (extra_bytes>>5));/* count instr */
     extra_bytes = 0;                                    /* digest string count */
+    if (icd_on && ((PSL & PSL_FPD) == 0))               /* decode cache? */
+        icd_lookup ();
     GET_ISTR (opc, L_BYTE);                             /* get opcode */
     if (opc == 0xFD) {                                  /* 2 byte op? */
         GET_ISTR (opc, L_BYTE);                         /* get second byte */
@@ -1522,6 +1560,8 @@ for ( ;; ) {
                 }                                       /* end case spec */
             }                                           /* end for */
         }                                               /* end if not FPD */
+    if (icd_rp || icd_wp)                               /* decode cached? */
+        icd_done ();
 
 /* Optionally record instruction history */
 
@@ -3131,6 +3171,10 @@ for ( ;; ) {
    have enough bytes, enough prefetch words are fetched until there
    are.  A longword is only prefetched if data is needed from it,
    so any translation errors are real.
+
+   While the decode cache is replaying an instruction, the values are
+   taken from the cache entry instead; while it is recording one, the
+   values are saved in the entry as they are extracted.
 */
 
 static SIM_INLINE int32 get_istr (int32 lnt, int32 acc)
@@ -3138,6 +3182,10 @@ static SIM_INLINE int32 get_istr (int32 lnt, int32 acc)
 int32 bo = PC & 3;
 int32 sc, val, t;
 
+if (icd_rp) {                                           /* replaying? */
+    PC = PC + lnt;                                      /* incr PC */
+    return *icd_rp++;
+    }
 while ((bo + lnt) > ibcnt) {                            /* until enuf bytes */
     if ((ppc < 0) || (VA_GETOFF (ppc) == 0)) {          /* PPC inv, xpg? */
         ppc = Test ((PC + ibcnt) & ~03, RD, &t);        /* xlate PC */
@@ -3167,9 +3215,121 @@ if ((bo + lnt) >= 4) {                                  /* retire ibufl? */
     ibufl = ibufh;
     ibcnt = ibcnt - 4;
     }
+if (icd_wp) {                                           /* recording? */
+    if (icd_wp < &icd_ent->val[ICD_NVAL])
+        *icd_wp++ = val;
+    else icd_wp = NULL;                                 /* too long, abandon */
+    }
 return val;
 }
 
+/* Decoded instruction cache
+
+   The decode cache holds, for each physical PC, the values the instruction
+   stream supplied when the instruction at that address was last decoded:
+   the opcode, the specifier bytes and the displacements, immediates and
+   branch displacements.  On a hit, get_istr replays these values, so the
+   specifier flows neither extract bytes from the prefetch buffer nor
+   translate the PC at page crossings.
+
+   Entries are only made for instructions which lie entirely within one
+   page of memory, so the physical PC determines every byte of the
+   instruction and TB flushes or remapping never invalidate an entry.
+   Modifying the memory does.  Each memory page has a generation number
+   which is odd while entries for the page may exist.  Every write to
+   memory (ICD_INVAL) makes an odd generation even, orphaning the page's
+   entries, and costs a single test on pages which hold no cached code.
+
+   icd_lookup is called before the opcode is fetched.  It finds the
+   physical PC from the prefetch state (or a translation, which get_istr
+   would need anyway) and either starts replaying an entry or starts
+   recording into it.  icd_done is called after the specifiers have been
+   decoded; it validates a recorded entry, or after a replay points the
+   prefetch buffer at the next instruction.
+*/
+
+static SIM_INLINE void icd_lookup (void)
+{
+int32 pa, t;
+ICD_ENT *ep;
+
+if (ibcnt &&                                            /* prefetched, */
+    ((VA_GETOFF (ppc) == 0) || (VA_GETOFF (ppc) >= ibcnt)))/* one page? */
+    pa = ppc - ibcnt + (PC & 3);
+else if ((ibcnt == 0) && (ppc >= 0) && VA_GETOFF (ppc)) /* next lw in page? */
+    pa = ppc + (PC & 3);
+else {
+    pa = Test (PC, RD, &t);                             /* xlate PC */
+    if (pa < 0)                                         /* let get_istr fault */
+        return;
+    ppc = pa & ~03;                                     /* prime prefetch */
+    ibcnt = 0;
+    }
+if (!ADDR_IS_MEM (pa))                                  /* ROM, I/O space? */
+    return;
+ep = &icd[pa & ICD_MASK];
+icd_pa = (uint32) pa;
+if ((ep->pa == icd_pa) && (ep->gen == icd_pgen[icd_pa >> VA_N_OFF])) {
+    icd_rp = ep->val;                                   /* hit, replay */
+    icd_hit = icd_hit + 1;
+    }
+else {
+    ep->pa = ICD_INVPA;                                 /* miss, record */
+    ppc = pa & ~03;                                     /* from memory, not */
+    ibcnt = 0;                                          /* a stale prefetch */
+    icd_ent = ep;
+    icd_wp = ep->val;
+    icd_miss = icd_miss + 1;
+    }
+}
+
+static SIM_INLINE void icd_done (void)
+{
+if (icd_rp) {                                           /* replayed? */
+    ppc = (icd_pa + (PC - fault_PC)) & ~03;             /* phys PC of next */
+    ibcnt = 0;
+    icd_rp = NULL;
+    }
+else {                                                  /* recorded */
+    if (((fault_PC ^ (PC - 1)) & ~VA_M_OFF) == 0) {     /* within one page? */
+        uint32 *gp = &icd_pgen[icd_pa >> VA_N_OFF];
+
+        *gp = *gp | 1;                                  /* page holds code */
+        icd_ent->gen = *gp;
+        icd_ent->pa = icd_pa;                           /* entry valid */
+        }
+    icd_wp = NULL;
+    }
+}
+
+/* Allocate the decode cache, and its page generations for the current
+   memory size */
+
+static t_stat icd_alloc (void)
+{
+if (icd == NULL) {
+    icd = (ICD_ENT *) calloc (ICD_SIZE, sizeof (ICD_ENT));
+    if (icd == NULL)
+        return SCPE_MEM;
+    }
+free (icd_pgen);
+icd_pgen = (uint32 *) calloc ((((uint32) MEMSIZE) >> VA_N_OFF) + 1, sizeof (uint32));
+if (icd_pgen == NULL)
+    return SCPE_MEM;
+icd_flush ();
+return SCPE_OK;
+}
+
+/* Invalidate all decode cache entries (for memory loaded behind its back) */
+
+static void icd_flush (void)
+{
+uint32 i;
+
+for (i = 0; i < ICD_SIZE; i++)
+    icd[i].pa = ICD_INVPA;
+}
+
 /* Read octaword specifier */
 
 int32 ReadOcta (int32 va, int32 *opnd, int32 j, int32 acc)
@@ -3210,8 +3370,11 @@ if (M == NULL) {                        /* first time init? */
     M = (uint32 *) calloc (((uint32) MEMSIZE) >> 2, sizeof (uint32));
     if (M == NULL)
         return SCPE_MEM;
+    if (icd_alloc () != SCPE_OK)
+        return SCPE_MEM;
     auto_config(NULL, 0);               /* do an initial auto configure */
     }
+icd_flush ();                           /* clear decode cache */
 return build_dib_tab ();
 }
 
@@ -3330,6 +3493,8 @@ for (i = 0; i < clim; i = i + 4)
 free (M);
 M = nM;
 MEMSIZE = uval; 
+if (icd_alloc () != SCPE_OK)
+    return SCPE_MEM;
 reset_all (0);
 return SCPE_OK;
 }
@@ -3683,6 +3848,17 @@ cpu_model_help (st, dptr, uptr, flag, cptr);
 fprintf (st, "CPU options include the treatment of the HALT instruction.\n\n");
 fprintf (st, "   sim> SET CPU SIMHALT                 kernel HALT returns to simulator\n");
 fprintf (st, "   sim> SET CPU CONHALT                 kernel HALT returns to boot ROM console\n\n");
+fprintf (st, "The CPU remembers the decoded instruction stream of instructions it has\n");
+fprintf (st, "executed, keyed by physical address, and reuses it when an instruction is\n");
+fprintf (st, "executed again until the memory holding it is written.  The hidden registers\n");
+fprintf (st, "ICDHIT and ICDMISS count the instructions found and not found in this cache.\n\n");
+fprintf (st, "   sim> SET CPU DECODECACHE             enable decoded instruction cache\n");
+fprintf (st, "   sim> SET CPU NODECODECACHE           disable decoded instruction cache\n\n");
+fprintf (st, "F and G floating add, subtract, multiply and divide are done with the host's\n");
+fprintf (st, "IEEE double precision arithmetic when the result is certain to be identical\n");
+fprintf (st, "to the VAX result, and are simulated exactly otherwise.\n\n");
+fprintf (st, "   sim> SET CPU HOSTFP                  use host floating point when exact\n");
+fprintf (st, "   sim> SET CPU NOHOSTFP                always simulate floating point\n\n");
 fprintf (st, "The CPU also implements a command to display a virtual to physical address\n");
 fprintf (st, "translation:\n\n");
 fprintf (st, "   sim> SHOW {-kesu} CPU VIRTUAL=n      show translation for address n\n");
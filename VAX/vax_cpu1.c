@@ -780,6 +780,14 @@ return 0;                                               /* q can't be empty */
 #define MVC_FILL        3                               /* must be 3 */
 #define MVC_M_STATE     3
 #define MVC_V_CC        2
+#define STR_PGLEFT(x)   (VA_PAGSIZE - VA_GETOFF (x))    /* bytes to end of page */
+#define STR_PGUSED(x)   (VA_GETOFF ((x) - 1) + 1)       /* bytes below x in page */
+
+/* The string instructions first process their strings a page at a time
+   in host memory.  Each page is translated (and any fault taken) before
+   the registers are updated for the bytes in it, so a fault leaves the
+   registers describing exactly the bytes completed, as the element at a
+   time loops do.  Anything not in main memory is left to those loops. */
 
 /* MOVC3, MOVC5
 
@@ -859,6 +867,27 @@ else {
 switch (R[5] & MVC_M_STATE) {                           /* case on state */
 
     case MVC_FRWD:                                      /* move forward */
+        while (R[2] > 0) {                              /* page at a time */
+            int32 n = R[2];
+            uint32 spa, dpa;
+            uint8 *sp, *dp;
+
+            if (n > (int32) STR_PGLEFT (R[1]))
+                n = STR_PGLEFT (R[1]);
+            if (n > (int32) STR_PGLEFT (R[3]))
+                n = STR_PGLEFT (R[3]);
+            sp = HostB (R[1], RA, &spa);                /* src, dst in memory? */
+            dp = HostB (R[3], WA, &dpa);
+            if ((sp == NULL) || (dp == NULL) ||
+                ((dp > sp) && (dp < (sp + n))))         /* or aliased overlap? */
+                break;
+            ICD_INVAL (dpa);
+            memmove (dp, sp, n);
+            R[1] = R[1] + n;                            /* inc src addr */
+            R[3] = R[3] + n;                            /* inc dst addr */
+            R[2] = R[2] - n;                            /* dec move lnt */
+            extra_bytes = extra_bytes + (n >> 2);
+            }
         mlnt[0] = (4 - R[3]) & 3;                       /* length to align */
         if (mlnt[0] > R[2])                             /* cant exceed total */
             mlnt[0] = R[2];
@@ -877,6 +906,30 @@ switch (R[5] & MVC_M_STATE) {                           /* case on state */
         goto FILL;                                      /* check for fill */
 
     case MVC_BACK:                                      /* move backward */
+        while (R[2] > 0) {                              /* page at a time */
+            int32 n = R[2];
+            uint32 spa, dpa;
+            uint8 *sp, *dp;
+
+            if (n > (int32) STR_PGUSED (R[1]))
+                n = STR_PGUSED (R[1]);
+            if (n > (int32) STR_PGUSED (R[3]))
+                n = STR_PGUSED (R[3]);
+            sp = HostB (R[1] - 1, RA, &spa);            /* src, dst in memory? */
+            dp = HostB (R[3] - 1, WA, &dpa);
+            if ((sp == NULL) || (dp == NULL))
+                break;
+            sp = sp - (n - 1);                          /* start of chunk */
+            dp = dp - (n - 1);
+            if ((dp < sp) && ((dp + n) > sp))           /* aliased overlap? */
+                break;
+            ICD_INVAL (dpa);
+            memmove (dp, sp, n);
+            R[1] = R[1] - n;                            /* dec src addr */
+            R[3] = R[3] - n;                            /* dec dst addr */
+            R[2] = R[2] - n;                            /* dec move lnt */
+            extra_bytes = extra_bytes + (n >> 2);
+            }
         mlnt[0] = R[3] & 03;                            /* length to align */
         if (mlnt[0] > R[2])                             /* cant exceed total */
             mlnt[0] = R[2];
@@ -900,6 +953,22 @@ switch (R[5] & MVC_M_STATE) {                           /* case on state */
         if (R[4] <= 0)                                  /* any fill? */
             break;
         R[5] = R[5] | MVC_FILL;                         /* set state */
+        while (R[4] > 0) {                              /* page at a time */
+            int32 n = R[4];
+            uint32 dpa;
+            uint8 *dp;
+
+            if (n > (int32) STR_PGLEFT (R[3]))
+                n = STR_PGLEFT (R[3]);
+            dp = HostB (R[3], WA, &dpa);                /* dst in memory? */
+            if (dp == NULL)
+                break;
+            ICD_INVAL (dpa);
+            memset (dp, fill & BMASK, n);
+            R[3] = R[3] + n;                            /* inc dst addr */
+            R[4] = R[4] - n;                            /* dec fill lnt */
+            extra_bytes = extra_bytes + (n >> 2);
+            }
         mlnt[0] = (4 - R[3]) & 3;                       /* length to align */
         if (mlnt[0] > R[4])                             /* cant exceed total */
             mlnt[0] = R[4];
@@ -974,6 +1043,32 @@ else {
     PSL = PSL | PSL_FPD;
     }
 R[2] = R[2] & STR_LNMASK;                               /* mask src2len */
+while ((R[0] & STR_LNMASK) && R[2]) {                   /* page at a time */
+    int32 i, n = R[0] & STR_LNMASK;
+    uint32 pa1, pa2;
+    uint8 *p1, *p2;
+
+    if (n > R[2])
+        n = R[2];
+    if (n > (int32) STR_PGLEFT (R[1]))
+        n = STR_PGLEFT (R[1]);
+    if (n > (int32) STR_PGLEFT (R[3]))
+        n = STR_PGLEFT (R[3]);
+    p1 = HostB (R[1], RA, &pa1);                        /* src1, src2 in memory? */
+    p2 = HostB (R[3], RA, &pa2);
+    if ((p1 == NULL) || (p2 == NULL))
+        break;
+    if (memcmp (p1, p2, n) == 0)                        /* all equal? */
+        i = n;
+    else for (i = 0; p1[i] == p2[i]; i++) ;             /* find difference */
+    R[0] = R[0] - i;                                    /* i <= src1len */
+    R[1] = R[1] + i;
+    R[2] = R[2] - i;
+    R[3] = R[3] + i;
+    extra_bytes = extra_bytes + i;
+    if (i < n)                                          /* differ? */
+        break;
+    }
 for (s1 = s2 = 0; ((R[0] | R[2]) & STR_LNMASK) != 0; extra_bytes++) {
     if (R[0] & STR_LNMASK)                              /* src1? read */
         s1 = Read (R[1], L_BYTE, RA);
@@ -1024,6 +1119,28 @@ else {
     R[1] = opnd[2];                                     /* src addr */
     PSL = PSL | PSL_FPD;
     }
+while (R[0] & STR_LNMASK) {                             /* page at a time */
+    int32 i, n = R[0] & STR_LNMASK;
+    uint32 pa;
+    uint8 *p, *q;
+
+    if (n > (int32) STR_PGLEFT (R[1]))
+        n = STR_PGLEFT (R[1]);
+    p = HostB (R[1], RA, &pa);                          /* src in memory? */
+    if (p == NULL)
+        break;
+    if (skpc)                                           /* SKPC? */
+        for (i = 0; (i < n) && (p[i] == match); i++) ;
+    else {                                              /* LOCC */
+        q = (uint8 *) memchr (p, match, n);
+        i = q? (int32) (q - p): n;
+        }
+    R[0] = R[0] - i;                                    /* i <= src len */
+    R[1] = R[1] + i;
+    extra_bytes = extra_bytes + i;
+    if (i < n)                                          /* found? */
+        break;
+    }
 for ( ; (R[0] & STR_LNMASK) != 0; extra_bytes++ ) {    /* loop thru string */
     c = Read (R[1], L_BYTE, RA);                        /* get src byte */
     if ((c == match) ^ skpc)                            /* match & locc? */
@@ -1065,6 +1182,28 @@ else {
     R[0] = STR_PACK (mask, opnd[0]);                    /* srclen + FPD data */
     PSL = PSL | PSL_FPD;
     }
+while ((R[0] & STR_LNMASK) &&                           /* page at a time, */
+    (STR_PGLEFT (R[3]) >= 256)) {                       /* tbl in one page? */
+    int32 i, n = R[0] & STR_LNMASK;
+    uint32 pa, tpa;
+    uint8 *p, *tp;
+
+    if (n > (int32) STR_PGLEFT (R[1]))
+        n = STR_PGLEFT (R[1]);
+    p = HostB (R[1], RA, &pa);                          /* src in memory? */
+    if (p == NULL)
+        break;
+    tp = HostB (R[3] + p[0], RA, &tpa);                 /* tbl in memory? */
+    if (tp == NULL)
+        break;
+    tp = tp - p[0];
+    for (i = 0; (i < n) && ((((tp[p[i]] & mask) != 0) ^ spanc) == 0); i++) ;
+    R[0] = R[0] - i;                                    /* i <= src len */
+    R[1] = R[1] + i;
+    extra_bytes = extra_bytes + i;
+    if (i < n)                                          /* found? */
+        break;
+    }
 for ( ; (R[0] & STR_LNMASK) != 0; extra_bytes++ ) {    /* loop thru string */
     c = Read (R[1], L_BYTE, RA);                        /* get byte */
     t = Read (R[3] + c, L_BYTE, RA);                    /* get table ent */
@@ -148,6 +148,9 @@ extern jmp_buf save_env;
 #define H_GUARD         (15 - H_V_EXP)                  /* # guard bits */
 #define H_GETEXP(x)     (((x) >> H_V_EXP) & H_M_EXP)
 
+#define UNIT_V_NOHFP    (UNIT_V_UF + 3)                 /* CPU: no host fp */
+#define UNIT_NOHFP      (1u << UNIT_V_NOHFP)
+
 /* Memory management modes */
 
 #define KERN            0
@@ -625,6 +628,12 @@ enum opcodes {
 #define SETPC(d)        PC = (d), FLUSH_ISTR
 #define FLUSH_ISTR      ibcnt = 0, ppc = -1
 
+/* Decoded instruction cache - memory writes orphan the entries of a page
+   which holds cached instructions (odd generation) by making it even */
+
+#define ICD_INVAL(pa)   do { uint32 *_gp = &icd_pgen[((uint32) (pa)) >> VA_N_OFF]; \
+                            if (*_gp & 1) *_gp = *_gp + 1; } while (0)
+
 /* Character string instructions */
 
 #define STR_V_DPC       24                              /* delta PC */
@@ -806,6 +815,7 @@ extern int32 pcq[PCQ_SIZE];                             /* PC queue */
 extern int32 pcq_p;                                     /* PC queue ptr */
 extern int32 in_ie;                                     /* in exc, int */
 extern int32 ibcnt, ppc;                                /* prefetch ctl */
+extern uint32 *icd_pgen;                                /* decode cache page gens */
 extern int32 hlt_pin;                                   /* HLT pin intr */
 extern int32 mem_err;
 extern int32 crd_err;
@@ -58,6 +58,42 @@
 
 #include "vax_defs.h"
 #include <setjmp.h>
+#include <float.h>
+
+/* Host floating point is used only where 64b integers are available and
+   host double arithmetic is evaluated in IEEE double precision (not x87
+   extended precision) */
+
+#if defined (USE_INT64) && \
+    (defined (_M_X64) || (defined (FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)))
+#define USE_HFP         1
+
+#define HFP_ADD         0                               /* host fp operations */
+#define HFP_SUB         1
+#define HFP_MUL         2
+#define HFP_DIV         3
+#define HFP_FRAC        0x000FFFFFFFFFFFFF              /* IEEE fraction */
+#define HFP_V_EXP       52                              /* IEEE exponent */
+#define HFP_M_EXP       0x7FF
+#define HFP_FBIAS       (1023 - FD_BIAS - 1)            /* F to IEEE exp bias */
+#define HFP_GBIAS       2                               /* IEEE to G exp bias */
+#define HFP_V_FRND      28                              /* F round in IEEE */
+#define HFP_FRND        (((t_uint64) 1) << HFP_V_FRND)
+#define HFP_FGRD        ((HFP_FRND << 1) - 1)           /* F guard bits */
+#define HFP_GMIN        (G_BIAS - 400)                  /* G operand range */
+#define HFP_GMAX        (G_BIAS + 400)
+#define HFP_SIGN        0x8000000000000000              /* IEEE sign */
+#define HFP_P51         2251799813685248.0              /* 2**51 */
+
+t_bool hfp_opf (int32 s1, int32 s2, int32 op, int32 *res);
+t_bool hfp_opg (int32 *opnd, int32 op, int32 *res, int32 *rh);
+
+#else
+
+#define hfp_opf(s1,s2,op,res)           FALSE
+#define hfp_opg(opnd,op,res,rh)         FALSE
+
+#endif
 
 #if defined (USE_INT64)
 
@@ -615,6 +651,179 @@ if (r->exp <= 0) {                                      /* underflow? */
 return r->sign | (r->exp << G_V_EXP) | UF_GETGHI (r->frac);
 }
 
+#if defined (USE_HFP)
+
+/* Host floating point
+
+   F and G operands are converted to host IEEE doubles, operated on, and
+   converted back.  The simulated arithmetic above rounds the exact result
+   half away from zero, while the host rounds it to nearest even, so the
+   two differ only when the exact result lies halfway between two values.
+   The host result is used only when such a tie is ruled out:
+
+   - A double holds 29 more fraction bits than F.  The double result is
+     rounded to F here, unless it lies exactly on an F rounding tie.
+   - A double holds a G fraction exactly.  A quotient can never be a tie.
+     The error of a sum is computed exactly (TwoSum).  A product can be a
+     tie only if its exact value has 54 significant bits, which is checked
+     from the trailing zeroes of the operand fractions.
+
+   Reserved operands, divide by zero, and results which overflow or
+   underflow are left to the simulated arithmetic, which takes the faults.
+   G operands are limited to a range where nothing can overflow, underflow
+   or become denormal in the host.
+*/
+
+static SIM_INLINE t_bool hfp_getf (int32 val, double *d)
+{
+int32 exp = FD_GETEXP (val);
+t_uint64 bits;
+
+if (exp == 0) {                                         /* zero or rsvd op? */
+    *d = 0.0;
+    return ((val & FPSIGN) == 0);
+    }
+bits = (((t_uint64) (val & FPSIGN)) << 48) |           /* sign, exp, frac */
+    (((t_uint64) (exp + HFP_FBIAS)) << HFP_V_EXP) |
+    (((t_uint64) (((val & FD_FRACW) << 16) | ((val >> 16) & WMASK))) <<
+    (HFP_V_FRND + 1));
+memcpy (d, &bits, sizeof (bits));
+return TRUE;
+}
+
+static SIM_INLINE t_bool hfp_getg (int32 hi, int32 lo, t_uint64 *bits)
+{
+int32 exp = G_GETEXP (hi);
+
+if (exp == 0) {                                         /* zero or rsvd op? */
+    *bits = 0;
+    return ((hi & FPSIGN) == 0);
+    }
+if ((exp < HFP_GMIN) || (exp > HFP_GMAX))               /* out of range? */
+    return FALSE;
+*bits = UNSCRAM (hi, lo) - (((t_uint64) HFP_GBIAS) << HFP_V_EXP);
+return TRUE;
+}
+
+/* F floating operation, s2 op s1 */
+
+t_bool hfp_opf (int32 s1, int32 s2, int32 op, int32 *res)
+{
+double a, b, r;
+t_uint64 rb;
+int32 exp;
+
+if ((cpu_unit.flags & UNIT_NOHFP) ||                    /* disabled? */
+    !hfp_getf (s1, &a) || !hfp_getf (s2, &b))           /* or rsvd op? */
+    return FALSE;
+switch (op) {
+
+    case HFP_ADD:
+        r = b + a;
+        break;
+
+    case HFP_SUB:
+        r = b - a;
+        break;
+
+    case HFP_MUL:
+        r = b * a;
+        break;
+
+    default:
+        if (a == 0.0)                                   /* divide by zero? */
+            return FALSE;
+        r = b / a;
+        break;
+        }
+if (r == 0.0) {                                         /* result 0? */
+    *res = 0;
+    return TRUE;
+    }
+memcpy (&rb, &r, sizeof (rb));
+if ((rb & HFP_FGRD) == HFP_FRND)                        /* on a tie? */
+    return FALSE;
+rb = rb + HFP_FRND;                                     /* round */
+exp = (int32) ((rb >> HFP_V_EXP) & HFP_M_EXP) - HFP_FBIAS;
+if ((exp <= 0) || (exp > FD_M_EXP))                     /* ovflo or unflo? */
+    return FALSE;
+*res = (int32) (((uint32) (rb >> 48) & FPSIGN) | (exp << FD_V_EXP) |
+    ((uint32) (rb >> (HFP_V_FRND + 17)) & FD_FRACW) |
+    (((uint32) (rb >> (HFP_V_FRND + 1)) & WMASK) << 16));
+return TRUE;
+}
+
+/* G floating operation, s2 op s1 */
+
+t_bool hfp_opg (int32 *opnd, int32 op, int32 *res, int32 *rh)
+{
+double a, b, r, bv, err;
+t_uint64 ab, bb, rb, eb;
+int32 exp;
+
+if ((cpu_unit.flags & UNIT_NOHFP) ||                    /* disabled? */
+    !hfp_getg (opnd[0], opnd[1], &ab) ||                /* or rsvd op */
+    !hfp_getg (opnd[2], opnd[3], &bb))                  /* or out of range? */
+    return FALSE;
+if (op == HFP_SUB) {                                    /* sub? -s1 */
+    ab = ab ^ HFP_SIGN;
+    op = HFP_ADD;
+    }
+memcpy (&a, &ab, sizeof (a));
+memcpy (&b, &bb, sizeof (b));
+switch (op) {
+
+    case HFP_ADD:
+        r = b + a;
+        bv = r - a;                                     /* exact error */
+        err = (a - (r - bv)) + (b - bv);
+        if (err != 0.0) {                               /* inexact? */
+            memcpy (&rb, &r, sizeof (rb));
+            memcpy (&eb, &err, sizeof (eb));
+            eb = eb & ~HFP_SIGN;
+            exp = (int32) ((rb >> HFP_V_EXP) & HFP_M_EXP) - 53;
+            if ((eb == (((t_uint64) exp) << HFP_V_EXP)) || /* half an lsb? */
+                (((rb & HFP_FRAC) == 0) &&
+                 (eb == (((t_uint64) (exp - 1)) << HFP_V_EXP))))
+                return FALSE;
+            }
+        break;
+
+    case HFP_MUL:
+        r = b * a;
+        if (r != 0.0) {
+            t_uint64 ma = (ab & HFP_FRAC) | (HFP_FRAC + 1);
+            t_uint64 mb = (bb & HFP_FRAC) | (HFP_FRAC + 1);
+            double tz = ((double) (t_int64) (ma & (0 - ma))) *
+                ((double) (t_int64) (mb & (0 - mb)));
+
+            if ((tz == HFP_P51) || (tz == (2.0 * HFP_P51))) /* 54b result? */
+                return FALSE;
+            }
+        break;
+
+    default:
+        if (a == 0.0)                                   /* divide by zero? */
+            return FALSE;
+        r = b / a;
+        break;
+        }
+if (r == 0.0) {                                         /* result 0? */
+    *res = *rh = 0;
+    return TRUE;
+    }
+memcpy (&rb, &r, sizeof (rb));
+exp = (int32) ((rb >> HFP_V_EXP) & HFP_M_EXP) + HFP_GBIAS;
+if ((exp <= HFP_GBIAS) || (exp > G_M_EXP))              /* ovflo or unflo? */
+    return FALSE;
+rb = rb + (((t_uint64) HFP_GBIAS) << HFP_V_EXP);
+*rh = (int32) (((rb >> 16) & WMASK) | ((rb << 16) & 0xFFFF0000));
+*res = (int32) (((rb >> 48) & WMASK) | ((rb >> 16) & 0xFFFF0000));
+return TRUE;
+}
+
+#endif
+
 #else                                                   /* 32b code */
 
 #define WORDSWAP(x)     ((((x) & WMASK) << 16) | (((x) >> 16) & WMASK))
@@ -1391,7 +1600,10 @@ return rpackfd (&a, NULL);
 int32 op_addf (int32 *opnd, t_bool sub)
 {
 UFP a, b;
+int32 r;
 
+if (hfp_opf (opnd[0], opnd[1], sub? HFP_SUB: HFP_ADD, &r))
+    return r;
 unpackf (opnd[0], &a);                                  /* F format */
 unpackf (opnd[1], &b);
 if (sub)                                                /* sub? -s1 */
@@ -1415,7 +1627,10 @@ return rpackfd (&a, rh);
 int32 op_addg (int32 *opnd, int32 *rh, t_bool sub)
 {
 UFP a, b;
+int32 r;
 
+if (hfp_opg (opnd, sub? HFP_SUB: HFP_ADD, &r, rh))
+    return r;
 unpackg (opnd[0], opnd[1], &a);
 unpackg (opnd[2], opnd[3], &b);
 if (sub)                                                /* sub? -s1 */
@@ -1429,7 +1644,10 @@ return rpackg (&a, rh);                                 /* round and pack */
 int32 op_mulf (int32 *opnd)
 {
 UFP a, b;
-    
+int32 r;
+
+if (hfp_opf (opnd[0], opnd[1], HFP_MUL, &r))
+    return r;
 unpackf (opnd[0], &a);                                  /* F format */
 unpackf (opnd[1], &b);
 vax_fmul (&a, &b, 0, FD_BIAS, 0, 0);                    /* do multiply */
@@ -1449,7 +1667,10 @@ return rpackfd (&a, rh);                                /* round and pack */
 int32 op_mulg (int32 *opnd, int32 *rh)
 {
 UFP a, b;
+int32 r;
 
+if (hfp_opg (opnd, HFP_MUL, &r, rh))
+    return r;
 unpackg (opnd[0], opnd[1], &a);                         /* G format */
 unpackg (opnd[2], opnd[3], &b);
 vax_fmul (&a, &b, 1, G_BIAS, 0, 0);                     /* do multiply */
@@ -1461,7 +1682,10 @@ return rpackg (&a, rh);                                 /* round and pack */
 int32 op_divf (int32 *opnd)
 {
 UFP a, b;
+int32 r;
 
+if (hfp_opf (opnd[0], opnd[1], HFP_DIV, &r))
+    return r;
 unpackf (opnd[0], &a);                                  /* F format */
 unpackf (opnd[1], &b);
 vax_fdiv (&a, &b, 26, FD_BIAS);                         /* do divide */
@@ -1481,7 +1705,10 @@ return rpackfd (&b, rh);                                /* round and pack */
 int32 op_divg (int32 *opnd, int32 *rh)
 {
 UFP a, b;
+int32 r;
 
+if (hfp_opg (opnd, HFP_DIV, &r, rh))
+    return r;
 unpackg (opnd[0], opnd[1], &a);                         /* G format */
 unpackg (opnd[2], opnd[3], &b);
 vax_fdiv (&a, &b, 55, G_BIAS);                          /* do divide */
@@ -0,0 +1,266 @@
+/* vax_fpa_test.c: VAX host floating point differential test
+
+   Copyright (c) 2026, The simh developers
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+   THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+   CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   This program checks that the host floating point paths in vax_fpa.c
+   (hfp_opf and hfp_opg) give exactly the same results and faults as the
+   simulated F and G floating arithmetic.  vax_fpa.c is linked on its own,
+   with stubs for the few CPU and memory symbols it references, and random
+   operand pairs are run through ADDF/SUBF/MULF/DIVF and ADDG/SUBG/MULG/DIVG
+   once with the host path disabled (SET CPU NOHOSTFP) and once with it
+   enabled.  Operands are biased towards the awkward cases: zeroes, reserved
+   operands, short fractions, near cancellation and the edges of the
+   exponent range.
+
+   Build with "make vaxfpatest" and run as
+
+        vaxfpatest {count}
+
+   The exit status is non-zero if any mismatch is found.
+*/
+
+#include "vax_defs.h"
+#include "vax_mmu.h"
+#include <float.h>
+
+/* Stubs for the CPU state and memory interface used by vax_fpa.c */
+
+UNIT cpu_unit;
+int32 PSL, R[16], p1, mapen, mchk_va, mchk_ref;
+uint32 *M;
+TLBENT stlb[VA_TBSIZE], ptlb[VA_TBSIZE];
+jmp_buf save_env;
+
+int32 ReadIO (uint32 pa, int32 lnt) { return 0; }
+int32 ReadIOU (uint32 pa, int32 lnt) { return 0; }
+int32 ReadReg (uint32 pa, int32 lnt) { return 0; }
+int32 ReadRegU (uint32 pa, int32 lnt) { return 0; }
+
+TLBENT fill (uint32 va, int32 lnt, int32 acc, int32 *stat)
+{
+TLBENT zero_tlb;
+
+memset (&zero_tlb, 0, sizeof (zero_tlb));
+return zero_tlb;
+}
+
+/* Same test as vax_fpa.c uses to decide whether the host path exists */
+
+#if defined (USE_INT64) && \
+    (defined (_M_X64) || (defined (FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)))
+
+extern t_bool hfp_opf (int32 s1, int32 s2, int32 op, int32 *res);
+extern t_bool hfp_opg (int32 *opnd, int32 op, int32 *res, int32 *rh);
+
+#define OP_ADDF         0                               /* test operations */
+#define OP_SUBF         1
+#define OP_MULF         2
+#define OP_DIVF         3
+#define OP_ADDG         4
+#define OP_SUBG         5
+#define OP_MULG         6
+#define OP_DIVG         7
+#define RES_FILL        0x5A5A5A5A                      /* unwritten result */
+
+static const char *op_names[8] = {
+    "ADDF", "SUBF", "MULF", "DIVF", "ADDG", "SUBG", "MULG", "DIVG"
+    };
+
+static t_uint64 rand_state = 88172645463325252ULL;
+
+static t_uint64 rand64 (void)
+{
+rand_state ^= rand_state << 13;                         /* xorshift64 */
+rand_state ^= rand_state >> 7;
+rand_state ^= rand_state << 17;
+return rand_state;
+}
+
+/* Run one operation, with or without host floating point.  Returns 0 or
+   the fault (abort code * 16 + fault parameter). */
+
+static int32 run_op (int32 op, int32 *opnd, int32 *res, int32 *rh, t_bool hfp)
+{
+int32 abortval;
+
+cpu_unit.flags = hfp? 0: UNIT_NOHFP;
+*res = *rh = RES_FILL;
+p1 = 0;
+abortval = setjmp (save_env);
+if (abortval)
+    return abortval * 16 + p1;
+switch (op) {
+    case OP_ADDF: *res = op_addf (opnd, FALSE); break;
+    case OP_SUBF: *res = op_addf (opnd, TRUE); break;
+    case OP_MULF: *res = op_mulf (opnd); break;
+    case OP_DIVF: *res = op_divf (opnd); break;
+    case OP_ADDG: *res = op_addg (opnd, rh, FALSE); break;
+    case OP_SUBG: *res = op_addg (opnd, rh, TRUE); break;
+    case OP_MULG: *res = op_mulg (opnd, rh); break;
+    case OP_DIVG: *res = op_divg (opnd, rh); break;
+    }
+return 0;
+}
+
+/* Random F operand, with an exponent near 'near' most of the time */
+
+static int32 rand_f (int32 near)
+{
+t_uint64 x = rand64 ();
+int32 exp, frac, sign = (x & 1)? FPSIGN: 0;
+
+switch ((x >> 1) & 7) {
+    case 0:                                             /* any, incl 0 */
+        exp = (int32) ((x >> 8) & FD_M_EXP);
+        break;
+    case 1:                                             /* tiny */
+        exp = 1 + (int32) ((x >> 8) & 7);
+        break;
+    case 2:                                             /* huge */
+        exp = FD_M_EXP - 7 + (int32) ((x >> 8) & 7);
+        break;
+    default:                                            /* near the other */
+        exp = near + (int32) ((x >> 8) & 31) - 16;
+        if (exp < 1)
+            exp = 1;
+        if (exp > FD_M_EXP)
+            exp = FD_M_EXP;
+        break;
+        }
+frac = (int32) ((x >> 16) & 0x7FFFFF);
+switch ((x >> 40) & 3) {                                /* short fractions */
+    case 0:
+        frac &= ~((1 << ((x >> 44) % 23)) - 1);
+        break;
+    case 1:
+        frac &= 0x7F0000;
+        break;
+        }
+if (((x >> 50) & 63) == 0)                              /* zero or rsvd */
+    exp = 0;
+return sign | (exp << FD_V_EXP) | (frac >> 16) | ((frac & 0xFFFF) << 16);
+}
+
+/* Random G operand, with an exponent near 'near' most of the time */
+
+static void rand_g (int32 near, int32 *hi, int32 *lo)
+{
+t_uint64 x = rand64 ();
+t_uint64 frac = rand64 () & 0xFFFFFFFFFFFFF;
+t_uint64 val;
+int32 exp, sign = (x & 1)? FPSIGN: 0;
+
+switch ((x >> 1) & 7) {
+    case 0:                                             /* any, incl 0 */
+        exp = (int32) ((x >> 8) & G_M_EXP);
+        break;
+    case 1:                                             /* tiny */
+        exp = 1 + (int32) ((x >> 8) & 7);
+        break;
+    case 2:                                             /* huge */
+        exp = G_M_EXP - 7 + (int32) ((x >> 8) & 7);
+        break;
+    case 3:                                             /* host range edges */
+        exp = G_BIAS - 410 + (int32) ((x >> 8) & 31);
+        break;
+    case 4:
+        exp = G_BIAS + 390 + (int32) ((x >> 8) & 31);
+        break;
+    default:                                            /* near the other */
+        exp = near + (int32) ((x >> 8) & 63) - 32;
+        if (exp < 1)
+            exp = 1;
+        if (exp > G_M_EXP)
+            exp = G_M_EXP;
+        break;
+        }
+switch ((x >> 20) & 3) {                                /* short fractions */
+    case 0:
+        frac &= ~((((t_uint64) 1) << ((x >> 24) % 53)) - 1);
+        break;
+    case 1:
+        frac &= 0xF000000000000;
+        break;
+        }
+if (((x >> 50) & 63) == 0)                              /* zero or rsvd */
+    exp = 0;
+val = (((t_uint64) sign) << 48) | (((t_uint64) exp) << 52) | frac;
+*hi = (int32) (((val >> 48) & 0xFFFF) | ((val >> 16) & 0xFFFF0000));
+*lo = (int32) (((val >> 16) & 0xFFFF) | ((val << 16) & 0xFFFF0000));
+}
+
+int main (int argc, char *argv[])
+{
+long count = (argc > 1)? atol (argv[1]): 1000000;
+long i, bad = 0, cnt[8] = { 0 }, host[8] = { 0 };
+int32 op, near, f_exact, f_host, r_exact, rh_exact, r_host, rh_host, t, th;
+int32 opnd[4];
+
+for (i = 0; i < count; i++) {
+    op = (int32) (rand64 () & 7);
+    if (op <= OP_DIVF) {
+        opnd[0] = rand_f (FD_BIAS);
+        near = FD_GETEXP (opnd[0])? FD_GETEXP (opnd[0]): FD_BIAS;
+        opnd[1] = rand_f (near);
+        if ((rand64 () & 7) == 0)                       /* near cancellation */
+            opnd[1] = opnd[0] ^ (((int32) (rand64 () & 3)) << 16);
+        opnd[2] = opnd[3] = 0;
+        }
+    else {
+        rand_g (G_BIAS, &opnd[0], &opnd[1]);
+        near = G_GETEXP (opnd[0])? G_GETEXP (opnd[0]): G_BIAS;
+        rand_g (near, &opnd[2], &opnd[3]);
+        if ((rand64 () & 7) == 0) {                     /* near cancellation */
+            opnd[2] = opnd[0];
+            opnd[3] = opnd[1] ^ ((int32) (rand64 () & 0x30000));
+            }
+        }
+    f_exact = run_op (op, opnd, &r_exact, &rh_exact, FALSE);
+    f_host = run_op (op, opnd, &r_host, &rh_host, TRUE);
+    cnt[op]++;
+    cpu_unit.flags = 0;                                 /* count host hits */
+    if (op <= OP_DIVF)
+        host[op] += hfp_opf (opnd[0], opnd[1], op, &t);
+    else
+        host[op] += hfp_opg (opnd, op - OP_ADDG, &t, &th);
+    if ((f_exact != f_host) ||
+        (!f_exact && ((r_exact != r_host) ||
+                      ((op >= OP_ADDG) && (rh_exact != rh_host))))) {
+        if (bad++ < 20)
+            printf ("%s %08X %08X %08X %08X: simulated %d %08X %08X, host %d %08X %08X\n",
+                    op_names[op], opnd[0], opnd[1], opnd[2], opnd[3],
+                    f_exact, r_exact, rh_exact, f_host, r_host, rh_host);
+        }
+    }
+for (op = 0; op < 8; op++)
+    printf ("%s: %ld of %ld done on the host\n", op_names[op], host[op], cnt[op]);
+printf ("%ld mismatches in %ld operations\n", bad, count);
+return (bad != 0);
+}
+
+#else
+
+int main (int argc, char *argv[])
+{
+printf ("Host floating point is not used on this host\n");
+return 0;
+}
+
+#endif
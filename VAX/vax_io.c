@@ -103,6 +103,11 @@
 #define CQMAP_VLD       0x80000000                      /* valid */
 #define CQMAP_PAG       0x000FFFFF                      /* mem page */
 
+/* Bytes of an n byte transfer at ma which lie in the page of ma */
+
+#define QBA_PGLNT(ma,n) (((int32) (VA_PAGSIZE - VA_GETOFF (ma)) < (n))? \
+                            (int32) (VA_PAGSIZE - VA_GETOFF (ma)): (n))
+
 #define QB_VEC_MASK     0x1FC                           /* Interrupt Vector value mask */
 
 int32 int_req[IPL_HLVL] = { 0 };                        /* intr, IPL 14-17 */
@@ -576,6 +581,7 @@ if (ADDR_IS_MEM (ma)) {
         int32 t = M[ma >> 2];
         val = ((val & mask) << sc) | (t & ~(mask << sc));
         }
+    ICD_INVAL (ma);
     M[ma >> 2] = val;
     }
 else {
@@ -616,6 +622,7 @@ if (qba_map_addr (qa, &ma)) {                           /* map addr */
         int32 t = M[ma >> 2];
         val = ((val & mask) << sc) | (t & ~(mask << sc));
         }
+    ICD_INVAL (ma);
     M[ma >> 2] = val;
     }
 else {
@@ -727,14 +734,26 @@ return SCPE_OK;
    Map_ReadW    -       fetch word buffer from memory
    Map_WriteB   -       store byte buffer into memory
    Map_WriteW   -       store word buffer into memory
+
+   On a little endian host, memory holds bytes in VAX order, and each
+   mapped page is moved with a single block copy.  Map registers are
+   checked exactly as in the element by element loops.
 */
 
 int32 Map_ReadB (uint32 ba, int32 bc, uint8 *buf)
 {
-int32 i;
+int32 i, lnt;
 uint32 ma, dat;
 
-if ((ba | bc) & 03) {                                   /* check alignment */
+if (sim_end) {                                          /* little endian? */
+    for (i = 0; i < bc; i = i + lnt) {                  /* by pages */
+        if (!qba_map_addr (ba + i, &ma))                /* inv or NXM? */
+            return (bc - i);
+        lnt = QBA_PGLNT (ma, bc - i);                   /* rest of page */
+        memcpy (buf + i, ((uint8 *) M) + ma, lnt);
+        }
+    }
+else if ((ba | bc) & 03) {                              /* check alignment */
     for (i = ma = 0; i < bc; i++, buf++) {              /* by bytes */
         if ((ma & VA_M_OFF) == 0) {                     /* need map? */
             if (!qba_map_addr (ba + i, &ma))            /* inv or NXM? */
@@ -763,12 +782,20 @@ return 0;
 
 int32 Map_ReadW (uint32 ba, int32 bc, uint16 *buf)
 {
-int32 i;
+int32 i, lnt;
 uint32 ma,dat;
 
 ba = ba & ~01;
 bc = bc & ~01;
-if ((ba | bc) & 03) {                                   /* check alignment */
+if (sim_end) {                                          /* little endian? */
+    for (i = 0; i < bc; i = i + lnt) {                  /* by pages */
+        if (!qba_map_addr (ba + i, &ma))                /* inv or NXM? */
+            return (bc - i);
+        lnt = QBA_PGLNT (ma, bc - i);                   /* rest of page */
+        memcpy (((uint8 *) buf) + i, ((uint8 *) M) + ma, lnt);
+        }
+    }
+else if ((ba | bc) & 03) {                              /* check alignment */
     for (i = ma = 0; i < bc; i = i + 2, buf++) {        /* by words */
         if ((ma & VA_M_OFF) == 0) {                     /* need map? */
             if (!qba_map_addr (ba + i, &ma))            /* inv or NXM? */
@@ -795,10 +822,19 @@ return 0;
 
 int32 Map_WriteB (uint32 ba, int32 bc, const uint8 *buf)
 {
-int32 i;
+int32 i, lnt;
 uint32 ma, dat;
 
-if ((ba | bc) & 03) {                                   /* check alignment */
+if (sim_end) {                                          /* little endian? */
+    for (i = 0; i < bc; i = i + lnt) {                  /* by pages */
+        if (!qba_map_addr (ba + i, &ma))                /* inv or NXM? */
+            return (bc - i);
+        lnt = QBA_PGLNT (ma, bc - i);                   /* rest of page */
+        ICD_INVAL (ma);                                 /* page written */
+        memcpy (((uint8 *) M) + ma, buf + i, lnt);
+        }
+    }
+else if ((ba | bc) & 03) {                              /* check alignment */
     for (i = ma = 0; i < bc; i++, buf++) {              /* by bytes */
         if ((ma & VA_M_OFF) == 0) {                     /* need map? */
             if (!qba_map_addr (ba + i, &ma))            /* inv or NXM? */
@@ -827,12 +863,21 @@ return 0;
 
 int32 Map_WriteW (uint32 ba, int32 bc, const uint16 *buf)
 {
-int32 i;
+int32 i, lnt;
 uint32 ma, dat;
 
 ba = ba & ~01;
 bc = bc & ~01;
-if ((ba | bc) & 03) {                                   /* check alignment */
+if (sim_end) {                                          /* little endian? */
+    for (i = 0; i < bc; i = i + lnt) {                  /* by pages */
+        if (!qba_map_addr (ba + i, &ma))                /* inv or NXM? */
+            return (bc - i);
+        lnt = QBA_PGLNT (ma, bc - i);                   /* rest of page */
+        ICD_INVAL (ma);                                 /* page written */
+        memcpy (((uint8 *) M) + ma, ((const uint8 *) buf) + i, lnt);
+        }
+    }
+else if ((ba | bc) & 03) {                              /* check alignment */
     for (i = ma = 0; i < bc; i = i + 2, buf++) {        /* by words */
         if ((ma & VA_M_OFF) == 0) {                     /* need map? */
             if (!qba_map_addr (ba + i, &ma))            /* inv or NXM? */
@@ -142,7 +142,7 @@ TLBENT fill (uint32 va, int32 lnt, int32 acc, int32 *stat)
 {
 int32 ptidx = (((uint32) va) >> 7) & ~03;
 int32 tlbpte, ptead, pte, tbi, vpn;
-static TLBENT zero_pte = { 0, 0 };
+static TLBENT zero_pte = { 0, 0, NULL };
 
 if (va & VA_S0) {                                       /* system space? */
     if (ptidx >= d_slr)                                 /* system */
@@ -179,6 +179,7 @@ else {
         stlb[tbi].tag = vpn;                            /* set stlb tag */
         stlb[tbi].pte = cvtacc[PTE_GETACC (pte)] |
             ((pte << VA_N_OFF) & TLB_PFN);              /* set stlb data */
+        stlb[tbi].hp = TLB_HP (stlb[tbi].pte);
         }
     ptead = (stlb[tbi].pte & TLB_PFN) | VA_GETOFF (ptead);
 #endif
@@ -200,10 +201,12 @@ tbi = VA_GETTBI (vpn);
 if ((va & VA_S0) == 0) {                                /* process space? */
     ptlb[tbi].tag = vpn;                                /* store tlb ent */
     ptlb[tbi].pte = tlbpte;
+    ptlb[tbi].hp = TLB_HP (tlbpte);
     return ptlb[tbi];
     }
 stlb[tbi].tag = vpn;                                    /* system space */
 stlb[tbi].pte = tlbpte;                                 /* store tlb ent */
+stlb[tbi].hp = TLB_HP (tlbpte);
 return stlb[tbi];
 }
 
@@ -227,8 +230,11 @@ size_t i;
 
 for (i = 0; i < VA_TBSIZE; i++) {
     ptlb[i].tag = ptlb[i].pte = -1;
-    if (stb)
+    ptlb[i].hp = NULL;
+    if (stb) {
         stlb[i].tag = stlb[i].pte = -1;
+        stlb[i].hp = NULL;
+        }
     }
 }
 
@@ -238,9 +244,14 @@ void zap_tb_ent (uint32 va)
 {
 int32 tbi = VA_GETTBI (VA_GETVPN (va));
 
-if (va & VA_S0)
+if (va & VA_S0) {
     stlb[tbi].tag = stlb[tbi].pte = -1;
-else ptlb[tbi].tag = ptlb[tbi].pte = -1;
+    stlb[tbi].hp = NULL;
+    }
+else {
+    ptlb[tbi].tag = ptlb[tbi].pte = -1;
+    ptlb[tbi].hp = NULL;
+    }
 }
 
 /* Check for tlb entry corresponding to va */
@@ -282,8 +293,14 @@ uint32 idx = (uint32) addr >> 1;
 if (idx >= VA_TBSIZE)
     return SCPE_NXM;
 if (addr & 1) {
-    if (tlbn) stlb[idx].pte = (int32) val;
-    else ptlb[idx].pte = (int32) val;
+    if (tlbn) {
+        stlb[idx].pte = (int32) val;
+        stlb[idx].hp = TLB_HP (stlb[idx].pte);
+        }
+    else {
+        ptlb[idx].pte = (int32) val;
+        ptlb[idx].hp = TLB_HP (ptlb[idx].pte);
+        }
     }
 else {
     if (tlbn) stlb[idx].tag = (int32) val;
@@ -298,8 +315,10 @@ t_stat tlb_reset (DEVICE *dptr)
 {
 size_t i;
 
-for (i = 0; i < VA_TBSIZE; i++)
+for (i = 0; i < VA_TBSIZE; i++) {
     stlb[i].tag = ptlb[i].tag = stlb[i].pte = ptlb[i].pte = -1;
+    stlb[i].hp = ptlb[i].hp = NULL;
+    }
 return SCPE_OK;
 }
 
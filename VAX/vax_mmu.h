@@ -42,6 +42,7 @@
         ReadB(W)        -       read aligned physical byte (word)
         WriteB(W)       -       write aligned physical byte (word)
         Test            -       test acccess
+        HostB           -       host address of virtual byte
 
 */
 
@@ -54,8 +55,14 @@
 typedef struct {
     int32       tag;                                    /* tag */
     int32       pte;                                    /* pte */
+    uint32      *hp;                                    /* host page, if memory */
     } TLBENT;
 
+/* Host page of a TB entry - the page's longwords in M if pte<pfn> is
+   main memory, otherwise NULL */
+
+#define TLB_HP(p)       (ADDR_IS_MEM ((p) & TLB_PFN)? &M[((uint32) ((p) & TLB_PFN)) >> 2]: NULL)
+
 extern uint32 *M;
 extern UNIT cpu_unit;
 extern DEVICE cpu_dev;
@@ -103,6 +110,11 @@ static SIM_INLINE void WriteL (uint32 pa, int32 val);
         write, with three cases: unaligned long, unaligned word within
         a longword, unaligned word crossing a longword boundary.
 
+   When mapping is on and the page is main memory, the TB entry also
+   holds a pointer to the page in M, and an aligned reference is made
+   through it directly, skipping the memory and I/O space tests of the
+   physical routines.
+
    Note that these routines do not handle quad or octa references.
 */
 
@@ -131,6 +143,13 @@ if (mapen) {                                            /* mapping on? */
     if (((xpte.pte & acc) == 0) || (xpte.tag != vpn) ||
         ((acc & TLB_WACC) && ((xpte.pte & TLB_M) == 0)))
         xpte = fill (va, lnt, acc, NULL);               /* fill if needed */
+    if (xpte.hp && ((off & (lnt - 1)) == 0)) {          /* memory, aligned? */
+        if (lnt >= L_LONG)                              /* long, quad? */
+            return xpte.hp[off >> 2];
+        if (lnt == L_WORD)                              /* word? */
+            return ((xpte.hp[off >> 2] >> ((off & 2)? 16: 0)) & WMASK);
+        return ((xpte.hp[off >> 2] >> ((off & 3) << 3)) & BMASK);
+        }
     pa = (xpte.pte & TLB_PFN) | off;                    /* get phys addr */
     }
 else {
@@ -197,6 +216,21 @@ if (mapen) {
         ((xpte.pte & TLB_M) == 0))
         xpte = fill (va, lnt, acc, NULL);
     pa = (xpte.pte & TLB_PFN) | off;
+    if (xpte.hp && ((off & (lnt - 1)) == 0)) {          /* memory, aligned? */
+        uint32 *mp = &xpte.hp[off >> 2];
+
+        ICD_INVAL (pa);
+        if (lnt >= L_LONG)                              /* long, quad? */
+            *mp = val;
+        else if (lnt == L_WORD)                         /* word? */
+            *mp = (off & 2)? (*mp & 0xFFFF) | (val << 16):
+                (*mp & ~0xFFFF) | val;
+        else {                                          /* byte */
+            sc = (off & 3) << 3;
+            *mp = (*mp & ~(0xFF << sc)) | (val << sc);
+            }
+        return;
+        }
     }
 else {
     pa = va & PAMASK;
@@ -258,6 +292,41 @@ if (mapen) {                                            /* mapping on? */
 return va & PAMASK;                                     /* ret phys addr */
 }
 
+/* Host address of a virtual byte (string instructions)
+
+   Inputs:
+        va      =       virtual address
+        acc     =       access code (KESU, shifted for write)
+        pa      =       pointer to returned physical address
+   Output:
+        pointer to the byte in M, or NULL if the byte is not in main
+        memory or host byte order differs from VAX byte order
+
+   The translation faults as a Read or Write of the byte would.  The bytes
+   from va to the end of its page are contiguous in M.
+*/
+
+static SIM_INLINE uint8 *HostB (uint32 va, int32 acc, uint32 *pa)
+{
+int32 vpn, tbi;
+TLBENT xpte;
+
+mchk_va = va;
+if (mapen) {                                            /* mapping on? */
+    vpn = VA_GETVPN (va);
+    tbi = VA_GETTBI (vpn);
+    xpte = (va & VA_S0)? stlb[tbi]: ptlb[tbi];          /* access tlb */
+    if (((xpte.pte & acc) == 0) || (xpte.tag != vpn) ||
+        ((acc & TLB_WACC) && ((xpte.pte & TLB_M) == 0)))
+        xpte = fill (va, L_BYTE, acc, NULL);            /* fill if needed */
+    *pa = (xpte.pte & TLB_PFN) | VA_GETOFF (va);
+    }
+else *pa = va & PAMASK;
+if (!sim_end || !ADDR_IS_MEM (*pa))                     /* not plain memory? */
+    return NULL;
+return ((uint8 *) M) + *pa;
+}
+
 /* Read aligned physical (in virtual context, unless indicated)
 
    Inputs:
@@ -356,6 +425,7 @@ if (ADDR_IS_MEM (pa)) {
     int32 id = pa >> 2;
     int32 sc = (pa & 3) << 3;
     int32 mask = 0xFF << sc;
+    ICD_INVAL (pa);
     M[id] = (M[id] & ~mask) | (val << sc);
     }
 else {
@@ -371,6 +441,7 @@ static SIM_INLINE void WriteW (uint32 pa, int32 val)
 {
 if (ADDR_IS_MEM (pa)) {
     int32 id = pa >> 2;
+    ICD_INVAL (pa);
     M[id] = (pa & 2)? (M[id] & 0xFFFF) | (val << 16):
         (M[id] & ~0xFFFF) | val;
     }
@@ -385,8 +456,10 @@ return;
 
 static SIM_INLINE void WriteL (uint32 pa, int32 val)
 {
-if (ADDR_IS_MEM (pa))
+if (ADDR_IS_MEM (pa)) {
+    ICD_INVAL (pa);
     M[pa >> 2] = val;
+    }
 else {
     mchk_ref = REF_V;
     if (ADDR_IS_IO (pa))
@@ -398,8 +471,10 @@ return;
 
 static SIM_INLINE void WriteLP (uint32 pa, int32 val)
 {
-if (ADDR_IS_MEM (pa))
+if (ADDR_IS_MEM (pa)) {
+    ICD_INVAL (pa);
     M[pa >> 2] = val;
+    }
 else {
     mchk_va = pa;
     mchk_ref = REF_P;
@@ -425,6 +500,7 @@ static SIM_INLINE void WriteU (uint32 pa, int32 val, int32 lnt)
 if (ADDR_IS_MEM (pa)) {
     int32 bo = pa & 3;
     int32 sc = bo << 3;
+    ICD_INVAL (pa);
     M[pa >> 2] = (M[pa >> 2] & ~(insert[lnt] << sc)) | ((val & insert[lnt]) << sc);
     }
 else {
@@ -1832,7 +1832,7 @@ if (MATCH_CMD(gbuf, "VAXSERVER") == 0) {
 else if (MATCH_CMD(gbuf, "MICROVAX") == 0) {
     sys_model = 1;
     strcpy (sim_name, "MicroVAX 3900 (KA655)");
-#if defined(USE_SIM_VIDEO) && defined(HAVE_LIBSDL)
+#if defined(USE_SIM_VIDEO) && (defined(HAVE_LIBSDL) || defined(USE_HEADLESS_VIDEO))
     vc_dev.flags = vc_dev.flags | DEV_DIS;               /* disable QVSS */
     lk_dev.flags = lk_dev.flags | DEV_DIS;               /* disable keyboard */
     vs_dev.flags = vs_dev.flags | DEV_DIS;               /* disable mouse */
@@ -1840,7 +1840,7 @@ else if (MATCH_CMD(gbuf, "MICROVAX") == 0) {
 #endif
     }
 else if (MATCH_CMD(gbuf, "VAXSTATION") == 0) {
-#if defined(USE_SIM_VIDEO) && defined(HAVE_LIBSDL)
+#if defined(USE_SIM_VIDEO) && (defined(HAVE_LIBSDL) || defined(USE_HEADLESS_VIDEO))
     strcpy (sim_name, "VAXStation 3900 (KA655)");
     sys_model = 1;
     vc_dev.flags = vc_dev.flags & ~DEV_DIS;              /* enable QVSS */
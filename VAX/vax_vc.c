@@ -181,6 +181,7 @@ BITFIELD vc_ic_mode_bits[] = {
 #define VC_XSIZE        1024                            /* screen size */
 #define VC_YSIZE        864
 #define VC_MEMSIZE      (1u << 16)                      /* video memory size */
+#define VC_BUFLINES     (VC_MEMSIZE >> 5)               /* video memory lines */
 
 #define VC_MOVE_MAX     49                              /* mouse movement max (per update) */
 
@@ -229,6 +230,8 @@ uint32 vc_icsr = 0;                                     /* Interrupt controller
 uint32 *vc_map;                                         /* Scanline map */
 uint32 *vc_buf = NULL;                                  /* Video memory */
 uint32 *vc_lines = NULL;                                /* Video Display Lines */
+uint8 vc_dirty_lo[VC_BUFLINES];                         /* first changed longword of buffer line */
+uint8 vc_dirty_hi[VC_BUFLINES];                         /* last changed longword of buffer line */
 uint8 vc_cur[256];                                      /* Cursor image */
 
 t_stat vc_rd (int32 *data, int32 PA, int32 access);
@@ -726,13 +729,43 @@ else if (rg >= 0xFE00) {                                /* scanline map */
             }
         }
     }
-bufln = rg / 32;
-for (scrln = 0; scrln < 1024; scrln++) {
-    if ((vc_map[scrln] & 0x7FF) == bufln) {
-        vc_map[scrln] &= ~VCMAP_VLD;                    /* invalidate map */
-        }
+if (vc_buf[rg] != nval) {                               /* changed? */
+    bufln = rg >> 5;                                    /* note changed longwords */
+    idx = rg & 0x1F;
+    if (idx < vc_dirty_lo[bufln])
+        vc_dirty_lo[bufln] = (uint8)idx;
+    if (idx > vc_dirty_hi[bufln])
+        vc_dirty_hi[bufln] = (uint8)idx;
+    vc_buf[rg] = nval;
+    }
+}
+
+/* Mark every buffer line unchanged (first > last) */
+
+static void vc_clean (void)
+{
+memset (vc_dirty_lo, 0xFF, sizeof (vc_dirty_lo));
+memset (vc_dirty_hi, 0, sizeof (vc_dirty_hi));
+}
+
+/* Send a run of consecutive refreshed screen lines to the display.
+   Only the longword columns lo through hi changed, so unless that is
+   the whole width each line is drawn separately; the video layer
+   coalesces the pieces again.
+*/
+
+static void vc_draw_lines (uint32 y, uint32 n, uint32 lo, uint32 hi)
+{
+uint32 ln;
+uint32 x = lo << 5;
+uint32 w = (hi - lo + 1) << 5;
+
+if (w == VC_XSIZE)
+    vid_draw (0, y, VC_XSIZE, n, vc_lines + y*VC_XSIZE);
+else {
+    for (ln = y; ln < (y + n); ln++)
+        vid_draw (x, ln, w, 1, vc_lines + ln*VC_XSIZE + x);
     }
-vc_buf[rg] = nval;
 }
 
 static SIM_INLINE void vc_invalidate (uint32 y1, uint32 y2)
@@ -879,8 +912,9 @@ t_stat vc_svc (UNIT *uptr)
 SIM_MOUSE_EVENT mev;
 SIM_KEY_EVENT kev;
 t_bool updated = FALSE;                                 /* flag for refresh */
-uint32 lines;
-uint32 ln, col, off;
+uint32 lines, lo, hi, run_lo, run_hi;
+uint32 ln, col, off, bufln, bits, b;
+uint32 *pix;
 int32 xpos, ypos, dx, dy;
 uint8 *cur;
 
@@ -947,38 +981,64 @@ if (vid_poll_mouse (&mev) == SCPE_OK) {                 /* poll mouse */
     vs_event (&mev);                                    /* push event */
     }
 
-lines = 0;
-for (ln = 0; ln < VC_YSIZE; ln++) {
-    if ((vc_map[ln] & VCMAP_VLD) == 0) {                /* line invalid? */
-        off = vc_map[ln] * 32;                          /* get video buf offset */
-        for (col = 0; col < VC_XSIZE; col++)  
-            vc_lines[ln*VC_XSIZE + col] = vid_mono_palette[(vc_buf[off + (col >> 5)] >> (col & 0x1F)) & 1];
-                                                        /* 1bpp to 32bpp */
-        if (CUR_V &&                                    /* cursor visible && need to draw cursor? */
-            (vc_input_captured || (vc_dev.dctrl & DBG_CURSOR))) {
-            if ((ln >= CUR_Y) && (ln < (CUR_Y + 16))) { /* cursor on this line? */
-                cur = &vc_cur[((ln - CUR_Y) << 4)];     /* get image base */
-                for (col = 0; col < 16; col++) {
-                    if ((CUR_X + col) >= VC_XSIZE)      /* Part of cursor off screen? */
-                        continue;                       /* Skip */
-                    if (CUR_F)                          /* mask function */
-                        vc_lines[ln*VC_XSIZE + CUR_X + col] = vid_mono_palette[(vc_lines[ln*VC_XSIZE + CUR_X + col] == vid_mono_palette[1]) | (cur[col] & 1)];
-                    else
-                        vc_lines[ln*VC_XSIZE + CUR_X + col] = vid_mono_palette[(vc_lines[ln*VC_XSIZE + CUR_X + col] == vid_mono_palette[1]) & (~cur[col] & 1)];
-                    }
-                }
+lines = 0;                                              /* no run of lines yet */
+run_lo = run_hi = 0;
+for (ln = 0; ln <= VC_YSIZE; ln++) {
+    lo = 1;                                             /* assume unchanged */
+    hi = 0;
+    if (ln < VC_YSIZE) {
+        bufln = vc_map[ln] & (VC_BUFLINES - 1);
+        if ((vc_map[ln] & VCMAP_VLD) == 0) {            /* line invalid? */
+            lo = 0;                                     /* redraw all of it */
+            hi = 31;
+            }
+        else {                                          /* only what changed */
+            lo = vc_dirty_lo[bufln];
+            hi = vc_dirty_hi[bufln];
             }
-        vc_map[ln] |= VCMAP_VLD;                        /* set valid */
-        if ((ln == (VC_YSIZE-1)) ||                     /* if end of window OR */
-            (vc_map[ln+1] & VCMAP_VLD)) {               /* next is already valid? */
-            vid_draw (0, ln-lines, VC_XSIZE, lines+1, vc_lines+(ln-lines)*VC_XSIZE); /* update region */
-            lines = 0;
+        }
+    if (lo > hi) {                                      /* line unchanged? */
+        if (lines)                                      /* end of a run? */
+            vc_draw_lines (ln - lines, lines, run_lo, run_hi);/* update region */
+        lines = 0;
+        continue;
+        }
+    off = bufln * 32;                                   /* get video buf offset */
+    for (col = lo; col <= hi; col++) {                  /* 1bpp to 32bpp */
+        bits = vc_buf[off + col];
+        pix = &vc_lines[ln*VC_XSIZE + (col << 5)];
+        for (b = 0; b < 32; b++, bits >>= 1)
+            pix[b] = vid_mono_palette[bits & 1];
+        }
+    if (CUR_V &&                                        /* cursor visible && need to draw cursor? */
+        (vc_input_captured || (vc_dev.dctrl & DBG_CURSOR))) {
+        if ((ln >= CUR_Y) && (ln < (CUR_Y + 16))) {     /* cursor on this line? */
+            cur = &vc_cur[((ln - CUR_Y) << 4)];         /* get image base */
+            for (col = 0; col < 16; col++) {
+                if ((CUR_X + col) >= VC_XSIZE)          /* Part of cursor off screen? */
+                    continue;                           /* Skip */
+                if (CUR_F)                              /* mask function */
+                    vc_lines[ln*VC_XSIZE + CUR_X + col] = vid_mono_palette[(vc_lines[ln*VC_XSIZE + CUR_X + col] == vid_mono_palette[1]) | (cur[col] & 1)];
+                else
+                    vc_lines[ln*VC_XSIZE + CUR_X + col] = vid_mono_palette[(vc_lines[ln*VC_XSIZE + CUR_X + col] == vid_mono_palette[1]) & (~cur[col] & 1)];
+                }
             }
-        else
-            lines++;
-        updated = TRUE;
         }
+    vc_map[ln] |= VCMAP_VLD;                            /* set valid */
+    if (lines == 0) {                                   /* start of a run? */
+        run_lo = lo;
+        run_hi = hi;
+        }
+    else {
+        if (lo < run_lo)
+            run_lo = lo;
+        if (hi > run_hi)
+            run_hi = hi;
+        }
+    lines++;
+    updated = TRUE;
     }
+vc_clean ();                                            /* all changes drawn */
 
 if (updated)                                            /* video updated? */
     vid_refresh ();                                     /* put to screen */
@@ -1048,6 +1108,7 @@ if (!vid_active)  {
         vid_close ();
         return SCPE_MEM;
         }
+    vc_clean ();
     sim_printf ("QVSS Display Created.  ");
     vc_show_capture (stdout, NULL, 0, NULL);
     if (sim_log)
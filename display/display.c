@@ -290,59 +290,59 @@ static struct display displays[] = {
  */
 
 /*
- * Each point on the display is represented by a "struct point".  When
- * a point isn't dark (intensity > 0), it is linked into a circular,
- * doubly linked delta queue (a priority queue where "delay"
- * represents the time difference from the previous entry (if any) in
- * the queue.
+ * All points age at the same rate: a point intensified at time T is
+ * moved to the next (logarithmically) lower intensity level at
+ * T + refresh_interval, T + 2*refresh_interval, ... until its time
+ * to live (ttl) runs out.  So the lit points are kept in
+ * refresh_interval "buckets", one for each DELAY_UNIT of the refresh
+ * interval; a point goes into the bucket for the current time when it
+ * is intensified, and stays there until it goes dark.  Every DELAY_UNIT
+ * display_age() moves on to the next bucket and ages all of its points
+ * at once.  Calling display_age() often allows spreading out the
+ * workload.
  *
- * All points are aged refresh_rate times/second, each time moved to the
- * next (logarithmically) lower intensity level.  When display_age() is
- * called, only the entries which have expired are processed.  Calling
- * display_age() often allows spreading out the workload.
+ * Each bucket keeps its points as parallel arrays (point index, ttl,
+ * intensity level and color) so aging a bucket is a pass over densely
+ * packed bytes (which compilers can vectorize) followed by a single
+ * batched ws_display_points() call, rather than a linked list walk
+ * with a window system call per point.
  *
  * An alternative would be to have intensity levels represent linear
  * decreases in intensity, and have the decay time at each level change.
  * Inverting the decay function for a multi-component phosphor may be
  * tricky, and the two different colors would need different time tables.
- * Furthermore, it would require finding the correct location in the
- * queue when adding a point (currently only need to add points at end)
- */
-
-/*
- * 12 bytes/entry on 32-bit system when REFRESH_RATE > 15
- * (requires 3MB for 512x512 display).
  */
 
 typedef unsigned short delay_t;
 #define DELAY_T_MAX USHRT_MAX
 
-struct point {
-    struct point *next;         /* next entry in queue */
-    struct point *prev;         /* prev entry in queue */
-    delay_t delay;              /* delta T in DELAY_UNITs */
-    unsigned char ttl;          /* zero means off, not linked in */
-    unsigned char level : 7;    /* intensity level */
-    unsigned char color : 1;    /* for VR20 (two colors) */
+struct bucket {
+    unsigned int *pix;          /* point index: x + y*xpixels */
+    unsigned char *ttl;         /* aging periods left; never zero */
+    unsigned char *lc;          /* intensity level << 1 | color */
+    unsigned int count;         /* points in bucket */
+    unsigned int size;          /* allocated */
 };
 
-static struct point *points;    /* allocated array of points */
-static struct point _head;
-#define head (&_head)
+static struct bucket *buckets;  /* refresh_interval buckets */
+static int bucket_now;          /* bucket aged most recently */
+static long lit_points;         /* points in all buckets */
 
 /*
- * time span of all entries in queue
- * should never exceed refresh_interval
- * (should be possible to make this a delay_t)
+ * for each point on the display, its bucket and slot in the bucket
+ * (or NOSLOT if the point is dark)
  */
-static long queue_interval;
+#define NOSLOT (~0U)
+static delay_t *point_bucket;
+static unsigned int *point_slot;
 
-/* convert X,Y to a "struct point *" */
-#define P(X,Y) (points + (X) + ((Y)*(size_t)xpixels))
+/* scratch window system colors for a batch of points */
+static void **batch_colors;
+static unsigned int batch_size;
 
-/* convert "struct point *" to X and Y */
-#define X(P) (((P) - points) % xpixels)
-#define Y(P) (((P) - points) / xpixels)
+#define LC(LEVEL,COLOR) (((LEVEL) << 1) | (COLOR))
+#define LC_LEVEL(LC) ((LC) >> 1)
+#define LC_COLOR(LC) ((LC) & 1)
 
 static int initialized = 0;
 
@@ -392,39 +392,108 @@ display_lp_radius(int r)
     scaled_pen_radius_squared = r * r;
 }
 
+/* add a point to the bucket for the current time */
+static int
+queue_point(unsigned int pix, int ttl, int lc)
+{
+    struct bucket *b = &buckets[bucket_now];
+
+    if (b->count == b->size) {
+        unsigned int size = b->size ? 2*b->size : 64;
+        unsigned int *npix;
+        unsigned char *nttl, *nlc;
+
+        npix = (unsigned int *)realloc(b->pix, size * sizeof(*npix));
+        if (npix)
+            b->pix = npix;
+        nttl = (unsigned char *)realloc(b->ttl, size);
+        if (nttl)
+            b->ttl = nttl;
+        nlc = (unsigned char *)realloc(b->lc, size);
+        if (nlc)
+            b->lc = nlc;
+        if (!npix || !nttl || !nlc)
+            return 0;
+        b->size = size;
+        }
+    b->pix[b->count] = pix;
+    b->ttl[b->count] = ttl;
+    b->lc[b->count] = lc;
+    point_bucket[pix] = bucket_now;
+    point_slot[pix] = b->count++;
+    ++lit_points;
+    return 1;
+}
+
+/* remove the point in slot i of a bucket, by moving the last one there */
+static void
+dequeue_point(struct bucket *b, unsigned int i)
+{
+    unsigned int last = --b->count;
+
+    point_slot[b->pix[i]] = NOSLOT;
+    if (i != last) {
+        b->pix[i] = b->pix[last];
+        b->ttl[i] = b->ttl[last];
+        b->lc[i] = b->lc[last];
+        point_slot[b->pix[i]] = i;
+        }
+    --lit_points;
+}
+
 /*
- * from display_age and display_point
- * since all points age at the same rate,
- * only adds points at end of list.
+ * draw all points in a bucket with one window system call;
+ * "off" is subtracted from the ttl to index the colors table
  */
 static void
-queue_point(struct point *p)
+draw_bucket(struct bucket *b, int off)
 {
-    int d;
+    unsigned int i;
+
+    if (b->count > batch_size) {
+        void **nc = (void **)realloc(batch_colors, b->count * sizeof(*nc));
 
-    d = refresh_interval - queue_interval;
-    queue_interval += d;
-    /* queue_interval should now be == refresh_interval */
+        if (!nc) {                  /* no memory; one at a time */
+            for (i = 0; i < b->count; i++)
+                ws_display_point(b->pix[i] % xpixels, b->pix[i] / xpixels,
+                    colors[LC_COLOR(b->lc[i])][LC_LEVEL(b->lc[i])][b->ttl[i]-off]);
+            return;
+            }
+        batch_colors = nc;
+        batch_size = b->count;
+        }
+    for (i = 0; i < b->count; i++)
+        batch_colors[i] =
+            colors[LC_COLOR(b->lc[i])][LC_LEVEL(b->lc[i])][b->ttl[i]-off];
+    ws_display_points(b->count, b->pix, batch_colors);
+}
 
-#ifdef PARANOIA
-    if (p->ttl == 0 || p->ttl > MAXTTL)
-    printf("queuing %d,%d level %d!\n", X(p), Y(p), p->level);
-    if (d > DELAY_T_MAX)
-    printf("queuing %d,%d delay %d!\n", X(p), Y(p), d);
-    if (queue_interval > DELAY_T_MAX)
-    printf("queue_interval (%d) > DELAY_T_MAX (%d)\n",
-           (int)queue_interval, DELAY_T_MAX);
-#endif /* PARANOIA defined */
+/* age all points in a bucket; returns true if any were */
+static int
+age_bucket(struct bucket *b)
+{
+    unsigned int i, n = b->count;
+    unsigned char *ttl = b->ttl;
+    int dark = 0;
 
-    p->next = head;
-    p->prev = head->prev;
+    if (n == 0)
+        return 0;
+    for (i = 0; i < n; i++)         /* decay */
+        dark |= (--ttl[i] == 0);
 
-    head->prev->next = p;
-    head->prev = p;
+    draw_bucket(b, 0);
 
-    p->delay = d;
+    if (dark) {                     /* drop points which went dark */
+        for (i = 0; i < b->count; ) {
+            if (ttl[i] == 0)
+                dequeue_point(b, i);
+            else
+                i++;
+            }
+        }
+    return 1;
 }
-
+
 /*
  * here to to dynamically adjust interval for examination
  * of elapsed vs. simulated time, and fritter away
@@ -591,7 +660,6 @@ int
 display_age(int t,          /* simulated us since last call */
         int slowdown)       /* slowdown to simulated speed */
 {
-    struct point *p;
     static int elapsed = 0;
     static int refresh_elapsed = 0; /* in units of DELAY_UNIT bounded by refresh_interval */
     int changed;
@@ -617,55 +685,28 @@ display_age(int t,          /* simulated us since last call */
         refresh_elapsed = 0;
         }
 
-    while ((p = head->next) != head) {
-        int x, y;
-
-        /* look at oldest entry */
-        if (p->delay > t) {         /* further than our reach? */
-            p->delay -= t;          /* update head */
-            queue_interval -= t;    /* update span */
-            break;                  /* quit */
+    if (lit_points == 0)            /* nothing to age? */
+        bucket_now = (bucket_now + t) % refresh_interval;
+    else
+        while (t-- > 0) {
+            if (++bucket_now == refresh_interval)
+                bucket_now = 0;
+            changed |= age_bucket(&buckets[bucket_now]);
             }
-
-        x = X(p);
-        y = Y(p);
-#ifdef PARANOIA
-        if (p->ttl == 0)
-            printf("BUG: age %d,%d ttl zero\n", x, y);
-#endif /* PARANOIA defined */
-
-        /* dequeue point */
-        p->prev->next = p->next;
-        p->next->prev = p->prev;
-
-        t -= p->delay;              /* lessen our reach */
-        queue_interval -= p->delay; /* update queue span */
-
-        ws_display_point(x, y, colors[p->color][p->level][--p->ttl]);
-        changed = 1;
-
-        /* queue it back up, unless we just turned it off! */
-        if (p->ttl > 0)
-            queue_point(p);
-        }
     return changed;
 } /* display_age */
 
 /* here from window system */
 void
 display_repaint(void) {
-    struct point *p;
-    int x, y;
-    /*
-     * bottom to top, left to right.
-     */
-    for (p = points, y = 0; y < ypixels; y++)
-        for (x = 0; x < xpixels; p++, x++)
-            if (p->ttl)
-                ws_display_point(x, y, colors[p->color][p->level][p->ttl-1]);
+    int i;
+
+    for (i = 0; i < refresh_interval; i++)
+        if (buckets[i].count)
+            draw_bucket(&buckets[i], 1);
     ws_sync();
 }
-
+
 /* (0,0) is lower left */
 static int
 intensify(int x,            /* 0..xpixels */
@@ -673,36 +714,32 @@ intensify(int x,            /* 0..xpixels */
       int level,            /* 0..MAXLEVEL */
       int color)            /* for VR20! 0 or 1 */
 {
-    struct point *p;
+    unsigned int pix, slot;
+    struct bucket *b = NULL;
+    int ttl = 0;            /* dark */
     int bleed;
 
     if (x < 0 || x >= xpixels || y < 0 || y >= ypixels)
         return 0;           /* limit to display */
 
-    p = P(x,y);
-    if (p->ttl) {           /* currently lit? */
+    pix = x + y*xpixels;
+    slot = point_slot[pix];
+    if (slot != NOSLOT) {   /* currently lit? */
+        b = &buckets[point_bucket[pix]];
+        ttl = b->ttl[slot];
 #ifdef LOUD
         printf("%d,%d old level %d ttl %d new %d\r\n",
-               x, y, p->level, p->ttl, level);
+               x, y, LC_LEVEL(b->lc[slot]), ttl, level);
 #endif /* LOUD defined */
-
-        /* unlink from delta queue */
-        p->prev->next = p->next;
-
-        if (p->next == head)
-            queue_interval -= p->delay;
-        else
-            p->next->delay += p->delay;
-        p->next->prev = p->prev;
         }
 
     bleed = 0;              /* no bleeding for now */
 
     /* EXP: doesn't work... yet */
     /* if "recently" drawn, same or brighter, same color, make even brighter */
-    if (p->ttl >= MAXTTL*2/3 && 
-        level >= p->level && 
-        p->color == color &&
+    if (ttl >= MAXTTL*2/3 && 
+        level >= LC_LEVEL(b->lc[slot]) && 
+        color == LC_COLOR(b->lc[slot]) &&
         level < MAXLEVEL)
         level++;
 
@@ -710,17 +747,23 @@ intensify(int x,            /* 0..xpixels */
      * this allows a dim beam to suck light out of
      * a recently drawn bright spot!!
      */
-    if (p->ttl != MAXTTL || p->level != level || p->color != color) {
-        p->ttl = MAXTTL;
-        p->level = level;
-        p->color = color;   /* save color even if monochrome */
-        ws_display_point(x, y, colors[p->color][p->level][p->ttl-1]);
-        }
+    if (ttl != MAXTTL || b->lc[slot] != LC(level, color))
+        ws_display_point(x, y, colors[color][level][MAXTTL-1]);
 
-    queue_point(p);         /* put at end of list */
+    /* put in the bucket for now */
+    if (b == &buckets[bucket_now]) {
+        b->ttl[slot] = MAXTTL;
+        b->lc[slot] = LC(level, color); /* save color even if monochrome */
+        }
+    else {
+        if (b)
+            dequeue_point(b, slot);
+        if (!queue_point(pix, MAXTTL, LC(level, color)))
+            ws_display_point(x, y, colors[color][level][0]); /* no memory */
+        }
     return bleed;
 }
-
+
 int
 display_point(int x,        /* 0..xpixels (unscaled) */
           int y,            /* 0..ypixels (unscaled) */
@@ -863,9 +906,6 @@ display_init(enum display_type type, int sf, void *dptr)
         goto failed;
         }
 
-    /* Initialize display list */
-    head->next = head->prev = head;
-
     display_type = type;
     scale = sf;
 
@@ -931,10 +971,15 @@ display_init(enum display_type type, int sf, void *dptr)
     for (i = 0; i < NLEVELS; i++)
         level_scale[i] = ((float)i+1+BOOST)/(NLEVELS+BOOST);
 
-    points = (struct point *)calloc((size_t)xpixels,
-                    ypixels * sizeof(struct point));
-    if (!points)
+    buckets = (struct bucket *)calloc(refresh_interval, sizeof(*buckets));
+    point_bucket = (delay_t *)calloc((size_t)xpixels,
+                    ypixels * sizeof(*point_bucket));
+    point_slot = (unsigned int *)malloc((size_t)xpixels *
+                    ypixels * sizeof(*point_slot));
+    if (!buckets || !point_bucket || !point_slot)
         goto failed;
+    for (i = 0; i < xpixels*ypixels; i++)
+        point_slot[i] = NOSLOT;     /* all dark */
 
     if (!ws_init(dp->name, xpixels, ypixels, ncolors, dptr))
         goto failed;
@@ -0,0 +1,144 @@
+/*
+ * Window system driver with no window for XY display simulator;
+ * points are drawn into a framebuffer in memory.
+ * Used to benchmark the display code (see "bench" in gmakefile).
+ */
+
+/*
+ * This file may be used under the same terms as display.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include "ws.h"
+#include "display.h"
+
+int ws_lp_x = -1;
+int ws_lp_y = -1;
+
+static int xpixels, ypixels;
+static unsigned long *surface;
+
+static unsigned long black = 0;
+static unsigned long white = 0xffffff;
+
+/* statistics, for the benchmark */
+unsigned long ws_points_drawn;
+unsigned long ws_syncs;
+
+int
+ws_init(const char *crtname,    /* crt type name */
+        int xp, int yp,         /* screen size in pixels */
+        int colors,             /* colors to support (not used) */
+        void *dptr)
+{
+    xpixels = xp;
+    ypixels = yp;
+    surface = (unsigned long *)calloc((size_t)xpixels * ypixels,
+                                      sizeof(*surface));
+    return surface != NULL;
+}
+
+void ws_shutdown (void)
+{
+    free(surface);
+    surface = NULL;
+}
+
+void *
+ws_color_black(void)
+{
+    return &black;
+}
+
+void *
+ws_color_white(void)
+{
+    return &white;
+}
+
+void *
+ws_color_rgb(int r, int g, int b)
+{
+    unsigned long *color = (unsigned long *)malloc(sizeof(*color));
+
+    if (color)
+        *color = ((r & 0xff00) << 8) | (g & 0xff00) | ((b & 0xff00) >> 8);
+    return color;
+}
+
+/* put a point on the screen */
+void
+ws_display_point(int x, int y, void *color)
+{
+    if (x >= xpixels || y >= ypixels)
+        return;
+    surface[(ypixels - 1 - y)*(size_t)xpixels + x] =
+        color ? *(unsigned long *)color : black;
+    ++ws_points_drawn;
+}
+
+/* put n points on the screen; pix[i] is x + y*xpixels */
+void
+ws_display_points(int n, const unsigned int *pix, void **colors)
+{
+    int i;
+
+    for (i = 0; i < n; i++) {
+        int x = pix[i] % xpixels;
+        int y = pix[i] / xpixels;
+
+        surface[(ypixels - 1 - y)*(size_t)xpixels + x] =
+            colors[i] ? *(unsigned long *)colors[i] : black;
+    }
+    ws_points_drawn += n;
+}
+
+/* for comparing runs */
+unsigned long
+ws_checksum(void)
+{
+    unsigned long sum = 0;
+    size_t i;
+
+    for (i = 0; i < (size_t)xpixels * ypixels; i++)
+        sum = sum * 31 + surface[i];
+    return sum;
+}
+
+void
+ws_sync(void)
+{
+    ++ws_syncs;
+}
+
+int
+ws_poll(int *valp, int maxusec)
+{
+    return 1;
+}
+
+void
+ws_beep(void)
+{
+}
+
+/* public version, used by delay code */
+unsigned long
+os_elapsed(void)
+{
+    static struct timeval last;
+    struct timeval now;
+    unsigned long val;
+
+    gettimeofday(&now, NULL);
+    if (last.tv_sec == 0)
+        val = ~0L;
+    else
+        val = ((now.tv_sec - last.tv_sec) * 1000000 +
+               (now.tv_usec - last.tv_usec));
+    last = now;
+    return val;
+}
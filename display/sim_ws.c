@@ -62,8 +62,8 @@ static uint32 *colors = NULL;
 static uint32 ncolors = 0, size_colors = 0;
 static uint32 *surface = NULL;
 typedef struct cursor {
-    Uint8 *data;
-    Uint8 *mask;
+    uint8 *data;
+    uint8 *mask;
     int width;
     int height;
     int hot_x;
@@ -234,8 +234,8 @@ static const char *cross[] = {
 static CURSOR *ws_create_cursor(const char *image[])
 {
 int byte, bit, row, col;
-Uint8 *data = NULL;
-Uint8 *mask = NULL;
+uint8 *data = NULL;
+uint8 *mask = NULL;
 char black, white, transparent;
 CURSOR *result = NULL;
 int width, height, colors, cpp;
@@ -249,8 +249,8 @@ if ((cpp != 1) || (0 != width%8) || (colors != 3))
 black = image[1][0];
 white = image[2][0];
 transparent = image[3][0];
-data = (Uint8 *)calloc (1, (width / 8) * height);
-mask = (Uint8 *)calloc (1, (width / 8) * height);
+data = (uint8 *)calloc (1, (width / 8) * height);
+mask = (uint8 *)calloc (1, (width / 8) * height);
 if (!data || !mask) {
     free (data);
     free (mask);
@@ -393,6 +393,25 @@ ws_display_point(int x, int y, void *color)
     else
         surface[y*xpixels + x] = *brush;
 }
+
+/* put n points on the screen; pix[i] is x + y*xpixels */
+void
+ws_display_points(int n, const unsigned int *pix, void **colors)
+{
+    int i;
+
+    if (pix_size > 1) {
+        for (i = 0; i < n; i++)
+            ws_display_point(pix[i] % xpixels, pix[i] / xpixels, colors[i]);
+        return;
+        }
+    for (i = 0; i < n; i++) {
+        int x = pix[i] % xpixels;
+        int y = ypixels - 1 - (int)(pix[i] / xpixels);
+
+        surface[y*xpixels + x] = colors[i] ? *(uint32 *)colors[i] : vid_mono_palette[0];
+        }
+}
   
 void
 ws_sync(void) {
@@ -46,6 +46,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#ifdef BENCH
+#include <time.h>
+#endif
 
 #ifndef EXIT_FAILURE
 /* SunOS4 <stdlib.h> doesn't define this */
@@ -117,7 +120,11 @@ munch(void) {
 #define US 0
     us += 50;                           /* 10 5us PDP-1 memory cycles */
     if (us >= US) {
+#ifdef BENCH
+      display_age(us, 0);               /* as fast as possible */
+#else
       display_age(us, 1);
+#endif
       us = 0;
     }
     display_sync();                     /* XXX push down */
@@ -172,6 +179,41 @@ t3(void) {
 }
 #endif
 
+#ifdef BENCH
+/*
+ * benchmark: run munching squares for a fixed number of points
+ * without slowing down to real time, and report the rate.
+ * link with nullws.c; compile with -DBENCH or -DBENCH=<points>
+ */
+#if BENCH <= 1
+#undef BENCH
+#define BENCH 20000000L
+#endif
+
+extern unsigned long ws_points_drawn, ws_syncs;
+extern unsigned long ws_checksum(void);
+
+int
+main(void) {
+    long i;
+    clock_t start;
+    double secs;
+
+    if (!display_init(TEST_DIS, TEST_RES, NULL))
+        exit(EXIT_FAILURE);
+
+    test_switches = 04000UL;            /* classic starting value */
+    start = clock();
+    for (i = 0; i < BENCH; i++)
+        munch();
+    secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%ld points in %.2f seconds: %.0f points/sec\n",
+           (long)BENCH, secs, BENCH / secs);
+    printf("%lu window system points drawn, %lu syncs, checksum %08lx\n",
+           ws_points_drawn, ws_syncs, ws_checksum() & 0xffffffffUL);
+    return 0;
+}
+#else /* BENCH not defined */
 int
 main(void) {
     if (!display_init(TEST_DIS, TEST_RES, NULL))
@@ -189,3 +231,4 @@ main(void) {
     }
     /*NOTREACHED*/
 }
+#endif /* BENCH not defined */
@@ -37,6 +37,7 @@ extern void *ws_color_rgb(int, int, int);
 extern void *ws_color_black(void);
 extern void *ws_color_white(void);
 extern void ws_display_point(int, int, void *);
+extern void ws_display_points(int, const unsigned int *, void **);
 extern void ws_sync(void);
 extern int ws_poll(int *, int);
 extern void ws_beep(void);
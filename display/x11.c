@@ -424,6 +424,16 @@ ws_display_point(int x, int y, void *color)
 #endif
 }
 
+/* put n points on the screen; pix[i] is x + y*xpixels */
+void
+ws_display_points(int n, const unsigned int *pix, void **colors)
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+        ws_display_point(pix[i] % xpixels, pix[i] / xpixels, colors[i]);
+}
+
 void
 ws_sync(void)
 {
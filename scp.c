@@ -394,6 +394,7 @@ sim_asynch_check = 0;                             /* try to force check */
 if (sim_idle_wait) {
     sim_debug (TIMER_DBG_IDLE, &sim_timer_dev, "waking due to event on %s after %d instructions\n", sim_uname(uptr), event_time);
     pthread_cond_signal (&sim_asynch_wake);
+    sim_idle_wake ();
     }
 }
 #else
@@ -1122,6 +1123,8 @@ static const char simh_help[] =
       "++++++++                     specify console serial port and optionally\n"
       "++++++++                     the port config (i.e. ;9600-8n1)\n"
       "+SET CONSOLE NOSERIAL        disable console serial session\n"
+      "+SET CONSOLE BATCH           batch console output while running (default)\n"
+      "+SET CONSOLE NOBATCH         write console output a character at a time\n"
       "+SET CONSOLE SPEED=nn{*fac}  specifies the maximum console port input rate\n"
        /***************** 80 character line width template *************************/
 #define HLP_SET_REMOTE "*Commands SET REMOTE"
@@ -1198,7 +1201,9 @@ static const char simh_help[] =
       "+SET THROTTLE x%%             occupy x percent of the host capacity\n"
       "++++++++executing instructions\n"
       "+SET THROTTLE x/t            sleep for t milliseconds after executing x\n"
-      "++++++++instructions\n\n"
+      "++++++++instructions\n"
+      "+SET THROTTLE xM PACED{=u}   pace xM, xK or x%% throttling every u\n"
+      "++++++++microseconds (default 1000)\n\n"
       "+SET NOTHROTTLE              set simulation rate to maximum\n\n"
       " Throttling is only available on host systems that implement a precision\n"
       " real-time delay function.\n\n"
@@ -1207,6 +1212,11 @@ static const char simh_help[] =
       " to wall clock time.  Very short running programs may complete before\n"
       " calibration completes and therefore before the simulated execution rate\n"
       " can match the desired rate.\n\n"
+      " Adding PACED to an xM, xK or x%% throttle replaces long bursts of\n"
+      " execution followed by millisecond sleeps with short evenly spaced\n"
+      " intervals.  A feedback controller adjusts the instructions executed in\n"
+      " each interval so that the simulator stays on schedule, and SHOW THROTTLE\n"
+      " reports how closely it does.\n\n"
       " The SET NOTHROTTLE command turns off throttling.  The SHOW THROTTLE\n"
       " command shows the current settings for throttling and the calibration\n"
       " results\n\n"
@@ -1223,14 +1233,45 @@ static const char simh_help[] =
 #endif
       "+SET CLOCK nocatchup         disable catchup clock ticks\n"
       "+SET CLOCK catchup           enable catchup clock ticks\n"
+      "+SET CLOCK tickless{=n}      idle across clock ticks (for up to n ms)\n"
+      "+SET CLOCK notickless        idle at most one clock tick at a time\n"
       "+SET CLOCK calib=n%%          specify idle calibration skip %%\n"
       "+SET CLOCK stop=n            stop execution after n instructions\n\n"
       " The SET CLOCK STOP command allows execution to have a bound when\n"
-      " execution starts with a BOOT, NEXT or CONTINUE command.\n"
+      " execution starts with a BOOT, NEXT or CONTINUE command.\n\n"
+      " The SET CLOCK TICKLESS command lets an idle simulator sleep until the\n"
+      " next scheduled event which isn't a clock tick, or until multiplexer,\n"
+      " console or asynchronous I/O input arrives, instead of waking up for\n"
+      " every simulated clock tick.  The clock ticks which elapsed while asleep\n"
+      " are then delivered as catchup ticks, so tickless idling only takes\n"
+      " effect while catchup ticks are enabled (the default), and SHOW CLOCKS\n"
+      " reports it as inactive otherwise.  The optional value limits a single\n"
+      " sleep (default 250 ms).\n"
+      " Tickless idling only applies to simulators which acknowledge their\n"
+      " clock interrupts.\n"
 #define HLP_SET_ASYNCH "*Commands SET Asynch"
       "3Asynch\n"
       "+SET ASYNCH                  enable asynchronous I/O\n"
       "+SET NOASYNCH                disable asynchronous I/O\n"
+#if defined(USE_SIM_VIDEO)
+#define HLP_SET_VIDEO "*Commands SET Video"
+      "3Video\n"
+      "+SET VIDEO record=prefix     record changed video frames\n"
+      "+SET VIDEO norecord          stop recording video frames\n"
+      "+SET VIDEO sample=n          sample the display every n refreshes\n\n"
+      " Simulators built without libSDL still run their video devices, drawing\n"
+      " into an in-memory display.  SET VIDEO RECORD samples that display each\n"
+      " time the video device refreshes it (or every nth time with SAMPLE=n) and\n"
+#if defined(HAVE_LIBPNG)
+      " writes each sample which differs from the last frame written to the file\n"
+      " prefix-nnnnnnnn.png, nnnnnnnn being the refresh count.  This allows\n"
+#else
+      " writes each sample which differs from the last frame written to the file\n"
+      " prefix-nnnnnnnn.bmp, nnnnnnnn being the refresh count.  This allows\n"
+#endif
+      " graphical output to be captured and compared on hosts without a display.\n"
+      " SHOW VIDEO reports the frames written and the time spent writing them.\n"
+#endif
 #define HLP_SET_ENVIRON "*Commands SET Environment"
       "3Environment\n"
       "4Explicitily Changing a Variable\n"
@@ -1353,6 +1394,8 @@ static const char simh_help[] =
       "+sh{ow} ethernet             show ethernet devices\n"
       "+sh{ow} serial               show serial devices\n"
       "+sh{ow} multiplexer          show open multiplexer devices\n"
+      "+sh{ow} loadtest             show multiplexer load test results\n"
+      "+sh{ow} export               show shared memory state export\n"
 #if defined(USE_SIM_VIDEO)
       "+sh{ow} video                show video capabilities\n"
 #endif
@@ -1381,6 +1424,8 @@ static const char simh_help[] =
 #define HLP_SHOW_ETHERNET       "*Commands SHOW"
 #define HLP_SHOW_SERIAL         "*Commands SHOW"
 #define HLP_SHOW_MULTIPLEXER    "*Commands SHOW"
+#define HLP_SHOW_LOADTEST       "*Commands SHOW"
+#define HLP_SHOW_EXPORT         "*Commands SHOW"
 #define HLP_SHOW_VIDEO          "*Commands SHOW"
 #define HLP_SHOW_CLOCKS         "*Commands SHOW"
 #define HLP_SHOW_ON             "*Commands SHOW"
@@ -2101,6 +2146,53 @@ static const char simh_help[] =
       "2Exiting The Simulator\n"
       " EXIT (synonyms QUIT and BYE) returns control to the operating system.\n"
        /***************** 80 character line width template *************************/
+#define HLP_LOADTEST    "*Commands Multiplexer_Load_Test"
+      "2Multiplexer Load Test\n"
+      " The LOADTEST command measures how well a simulated multiplexer and the\n"
+      " operating system running on it keep up with a number of concurrent\n"
+      " interactive users.  It opens sessions to the listening port of an\n"
+      " attached multiplexer (tcp or unix:path) and has each session type one\n"
+      " character at a time, timing how long the simulated system takes to\n"
+      " respond (normally with the echo of the character):\n\n"
+      "++LOADTEST <dev> {SESSIONS=n,}{INTERVAL=usecs,}{DURATION=secs,}{\"<string>\"}\n"
+      "++NOLOADTEST\n"
+      "++SHOW LOADTEST\n\n"
+      " SESSIONS (default 1) is the number of concurrent sessions, INTERVAL\n"
+      " (default 100000) is the minimum time between the characters a session\n"
+      " types and DURATION (default 30) is how long the test runs once the\n"
+      " simulator is running.  The optional quoted string, which is interpreted\n"
+      " the same way as SEND strings, is the input each session types over and\n"
+      " over.  A session starts typing once its line has been quiet for 250ms.\n\n"
+      " SHOW LOADTEST reports the characters sent and received per second, the\n"
+      " response latency percentiles and the host CPU time used by the\n"
+      " simulator while the test ran.  NOLOADTEST stops a running test.\n\n"
+      "++sim> ATTACH DZ 2300\n"
+      "++sim> LOADTEST DZ SESSIONS=8,DURATION=60,\"show time\\r\"\n"
+      "++sim> BOOT RQ\n"
+       /***************** 80 character line width template *************************/
+#define HLP_EXPORT      "*Commands Exporting_State_To_Shared_Memory"
+      "2Exporting State To Shared Memory\n"
+      " The EXPORT command publishes the values of selected registers and ranges\n"
+      " of memory in a named shared memory region so that external monitoring\n"
+      " tools can observe the simulated system without sending commands to it:\n\n"
+      "++EXPORT <name> {EVERY <n> {INSTRUCTIONS}} <item>{,<item>...}\n"
+      "++NOEXPORT\n"
+      "++SHOW EXPORT\n\n"
+      " Each item is either a register, optionally a range of elements of an\n"
+      " array register, published as elements of the given size (1, 2, 4 or 8\n"
+      " bytes):\n\n"
+      "++<size> {-I} {<dev>} <reg>{[<lo>{:<hi>}]}\n\n"
+      " or a range of a device's memory, specified as for EXAMINE:\n\n"
+      "++MEMORY {-<switches>} {<dev>} <range>\n\n"
+      " The -I switch publishes the memory the register points at instead of\n"
+      " the register's value.  The published values are refreshed every n\n"
+      " instructions (default 100000) while the simulator runs.  Each refresh\n"
+      " is protected by a sequence lock so that readers never delay the\n"
+      " simulator.  The region layout and the client library used to read it\n"
+      " are described in sim_export.h.  The name may be up to 64 characters of\n"
+      " letters, digits, '-', '_' and '.'.  NOEXPORT stops exporting.\n\n"
+      "++sim> EXPORT vax1 EVERY 50000 4 PC,4 R0,4 PSL,MEMORY 0-1FF\n"
+       /***************** 80 character line width template *************************/
 #define HLP_SCREENSHOT  "*Commands Screenshot_Video_Window"
       "2Screenshot Video Window\n"
       " Simulators with Video devices display the simulated video in a window\n"
@@ -2183,6 +2275,10 @@ static CTAB cmd_table[] = {
     { "EXPECT",     &expect_cmd,    1,          HLP_EXPECT },
     { "NOEXPECT",   &expect_cmd,    0,          HLP_EXPECT },
     { "SLEEP",      &sleep_cmd,     0,          HLP_SLEEP },
+    { "LOADTEST",   &tmxr_loadtest_cmd, 1,      HLP_LOADTEST },
+    { "NOLOADTEST", &tmxr_loadtest_cmd, 0,      HLP_LOADTEST },
+    { "EXPORT",     &sim_export_cmd, 1,         HLP_EXPORT },
+    { "NOEXPORT",   &sim_export_cmd, 0,         HLP_EXPORT },
     { "!",          &spawn_cmd,     0,          HLP_SPAWN },
     { "HELP",       &help_cmd,      0,          HLP_HELP },
 #if defined(USE_SIM_VIDEO)
@@ -2220,6 +2316,9 @@ static CTAB set_glob_tab[] = {
     { "QUIET",      &set_quiet,                 1, HLP_SET_QUIET },
     { "NOQUIET",    &set_quiet,                 0, HLP_SET_QUIET },
     { "PROMPT",     &set_prompt,                0, HLP_SET_PROMPT },
+#if defined(USE_SIM_VIDEO)
+    { "VIDEO",      &vid_set_video,             1, HLP_SET_VIDEO },
+#endif
     { NULL,         NULL,                       0 }
     };
 
@@ -2266,12 +2365,14 @@ static SHTAB show_glob_tab[] = {
     { "SERIAL",         &sim_show_serial,           0, HLP_SHOW_SERIAL },
     { "MULTIPLEXER",    &tmxr_show_open_devices,    0, HLP_SHOW_MULTIPLEXER },
     { "MUX",            &tmxr_show_open_devices,    0, HLP_SHOW_MULTIPLEXER },
+    { "LOADTEST",       &tmxr_show_loadtest,        0, HLP_SHOW_LOADTEST },
 #if defined(USE_SIM_VIDEO)
     { "VIDEO",          &vid_show,                  0, HLP_SHOW_VIDEO },
 #endif
     { "CLOCKS",         &sim_show_timers,           0, HLP_SHOW_CLOCKS },
     { "SEND",           &sim_show_send,             0, HLP_SHOW_SEND },
     { "EXPECT",         &sim_show_expect,           0, HLP_SHOW_EXPECT },
+    { "EXPORT",         &sim_show_export,           0, HLP_SHOW_EXPORT },
     { "ON",             &show_on,                   0, HLP_SHOW_ON },
     { NULL,             NULL,                       0 }
     };
@@ -2475,6 +2576,7 @@ detach_all (0, TRUE);                                   /* close files */
 sim_set_deboff (0, NULL);                               /* close debug */
 sim_set_logoff (0, NULL);                               /* close log */
 sim_set_notelnet (0, NULL);                             /* close Telnet */
+sim_export_cmd (0, NULL);                               /* stop exporting */
 vid_close ();                                           /* close video */
 sim_ttclose ();                                         /* close console */
 AIO_CLEANUP;                                            /* Asynch I/O */
@@ -12011,6 +12113,7 @@ while (1) {                                         /* format passed string, arg
 if (sim_is_running) {
     char *c, *remnant = buf;
 
+    sim_putchar_flush ();                           /* keep batched console output in order */
     while ((c = strchr (remnant, '\n'))) {
         if ((c != buf) && (*(c - 1) != '\r'))
             fprintf (stdout, "%.*s\r\n", (int)(c-remnant), remnant);
@@ -12095,6 +12198,7 @@ if (sim_do_ocptr[sim_do_depth]) {
 if (sim_is_running && !inhibit_message) {
     char *c, *remnant = buf;
 
+    sim_putchar_flush ();                           /* keep batched console output in order */
     while ((c = strchr(remnant, '\n'))) {
         if ((c != buf) && (*(c - 1) != '\r'))
             fprintf (stdout, "%.*s\r\n", (int)(c-remnant), remnant);
@@ -12132,6 +12236,10 @@ return stat | SCPE_NOMESSAGE;
    Callers should be calling sim_debug() which is a macro
    defined in scp.h which evaluates the action condition before 
    incurring call overhead. */
+#if !defined(va_copy)
+#define va_copy(dest, src) ((dest) = (src))
+#endif
+
 static void _sim_vdebug (uint32 dbits, DEVICE* dptr, UNIT *uptr, const char* fmt, va_list arglist)
 {
 if (sim_deb && dptr && ((dptr->dctrl | (uptr ? uptr->dctrl : 0)) & dbits)) {
@@ -12146,11 +12254,15 @@ if (sim_deb && dptr && ((dptr->dctrl | (uptr ? uptr->dctrl : 0)) & dbits)) {
     buf[bufsize-1] = '\0';
 
     while (1) {                                         /* format passed string, args */
+        va_list args;
+
+        va_copy (args, arglist);                        /* a retry needs the args again */
 #if defined(NO_vsnprintf)
-        len = vsprintf (buf, fmt, arglist);
+        len = vsprintf (buf, fmt, args);
 #else                                                   /* !defined(NO_vsnprintf) */
-        len = vsnprintf (buf, bufsize-1, fmt, arglist);
+        len = vsnprintf (buf, bufsize-1, fmt, args);
 #endif                                                  /* NO_vsnprintf */
+        va_end (args);
 
 /* If the formatted result didn't fit into the buffer, then grow the buffer and try again */
 
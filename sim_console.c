@@ -91,6 +91,7 @@
    sim_poll_kbd                 poll for keyboard input
    sim_putchar                  output character to console
    sim_putchar_s                output character to console, stall if congested
+   sim_putchar_flush            write any batched console output
    sim_set_console              set console parameters
    sim_show_console             show console parameters
    sim_set_remote_console       set remote console parameters
@@ -114,6 +115,7 @@
    sim_ttisatty                 called to determine if running interactively
    sim_os_poll_kbd              poll for keyboard input
    sim_os_putchar               output character to console
+   sim_os_putbuf                output a block of characters to console
    sim_set_noconsole_port       Enable automatic WRU console polling
    sim_set_stable_registers_state Declare that all registers are always stable
 
@@ -131,6 +133,7 @@
 #include "sim_tmxr.h"
 #include "sim_serial.h"
 #include "sim_timer.h"
+#include "sim_export.h"
 #include <ctype.h>
 #include <math.h>
 
@@ -143,6 +146,7 @@
 static t_stat sim_os_poll_kbd (void);
 static t_bool sim_os_poll_kbd_ready (int ms_timeout);
 static t_stat sim_os_putchar (int32 out);
+static t_stat sim_os_putbuf (const char *buf, size_t len);
 static t_stat sim_os_ttinit (void);
 static t_stat sim_os_ttrun (void);
 static t_stat sim_os_ttcmd (void);
@@ -309,6 +313,8 @@ static CTAB set_con_tab[] = {
     { "NOLOG", &sim_set_logoff, 0 },
     { "DEBUG", &sim_set_debon, 0 },
     { "NODEBUG", &sim_set_deboff, 0 },
+    { "BATCH", &sim_set_cons_batch, 1 },
+    { "NOBATCH", &sim_set_cons_batch, 0 },
 #define CMD_WANTSTR     0100000
     { "HALT", &sim_set_halt, 1 | CMD_WANTSTR },
     { "NOHALT", &sim_set_halt, 0 },
@@ -339,6 +345,7 @@ static SHTAB show_con_tab[] = {
     { "TELNET", &sim_show_telnet, 0 },
     { "DEBUG", &sim_show_cons_debug, 0 },
     { "BUFFERED", &sim_show_cons_buff, 0 },
+    { "OUTPUT", &sim_show_cons_output, 0 },
     { "EXPECT", &sim_show_cons_expect, 0 },
     { "HALT", &sim_show_cons_expect, -1 },
     { "INPUT", &sim_show_cons_send_input, 0 },
@@ -441,6 +448,7 @@ t_stat sim_rem_con_reset (DEVICE *dptr);                /* remote console reset
 #define DBG_REP  0x00000008                             /* Remote Console Repeat activities */
 #define DBG_SAM  0x00000010                             /* Remote Console Sample activities */
 #define DBG_CMD  0x00000020                             /* Remote Console Command activities */
+#define DBG_SNP  0x00000040                             /* Remote Console Snapshot activities */
 
 DEBTAB sim_rem_con_debug[] = {
   {"TRC",    DBG_TRC, "routine calls"},
@@ -451,6 +459,7 @@ DEBTAB sim_rem_con_debug[] = {
   {"MODE",   DBG_MOD, "Remote Console Mode activity"},
   {"REPEAT", DBG_REP, "Remote Console Repeat activity"},
   {"SAMPLE", DBG_SAM, "Remote Console Sample activity"},
+  {"SNAPSHOT", DBG_SNP, "Remote Console Snapshot activity"},
   {0}
 };
 
@@ -487,6 +496,16 @@ struct BITSAMPLE_REG {
     uint32          width;          /* number of bits to sample */
     BITSAMPLE       *bits;
     };
+typedef struct SNAPSHOT_REG SNAPSHOT_REG;
+struct SNAPSHOT_REG {
+    REG             *reg;           /* Register to be reported */
+    uint32          lo;             /* First element reported */
+    uint32          hi;             /* Last element reported */
+    t_bool          indirect;       /* Register value points at memory */
+    DEVICE          *dptr;          /* Device register is part of */
+    UNIT            *uptr;          /* Unit Register is related to */
+    uint32          size;           /* bytes per element in a snapshot */
+    };
 typedef struct REMOTE REMOTE;
 struct REMOTE {
     int32           buf_size;
@@ -507,6 +526,12 @@ struct REMOTE {
     int             smp_sample_dither_pct;  /* dithering of cycles interval */
     uint32          smp_reg_count;          /* sample register count */
     BITSAMPLE_REG   *smp_regs;              /* registers being sampled */
+    uint32          snap_reg_count;         /* snapshot register count */
+    SNAPSHOT_REG    *snap_regs;             /* registers in snapshot schema */
+    uint8           *snap_buf;              /* snapshot frame buffer */
+    size_t          snap_buf_size;          /* snapshot frame buffer size */
+    t_bool          snap_push;              /* repeat interval pushes snapshots */
+    t_bool          pipeline;               /* pipelined command mode */
     };
 REMOTE *sim_rem_consoles = NULL;
 
@@ -615,6 +640,12 @@ for (i=connections=0; i<sim_rem_con_tmxr.lines; i++) {
         fprintf (st, "The Command: %s\n", rem->repeat_action);
         fprintf (st, "    is repeated every %s\n", sim_fmt_secs (rem->repeat_interval / 1000000.0));
         }
+    if (rem->snap_reg_count) {
+        if (rem->snap_push)
+            fprintf (st, "Register Snapshots (%d registers) are pushed every %s\n", rem->snap_reg_count, sim_fmt_secs (rem->repeat_interval / 1000000.0));
+        else
+            fprintf (st, "Register Snapshots (%d registers) are defined\n", rem->snap_reg_count);
+        }
     if (rem->smp_reg_count) {
         uint32 reg;
         DEVICE *dptr = NULL;
@@ -707,6 +738,26 @@ static t_stat x_execute_cmd (int32 flag, CONST char *cptr)
 return 5+SCPE_IERR;         /* This routine should never be called */
 }
 
+static t_stat x_snapshot_cmd (int32 flag, CONST char *cptr)
+{
+return 8+SCPE_IERR;         /* This routine should never be called */
+}
+
+static t_stat x_pipeline_cmd (int32 flag, CONST char *cptr)
+{
+return 9+SCPE_IERR;         /* This routine should never be called */
+}
+
+static t_stat x_bexamine_cmd (int32 flag, CONST char *cptr)
+{
+return 10+SCPE_IERR;        /* This routine should never be called */
+}
+
+static t_stat x_bdeposit_cmd (int32 flag, CONST char *cptr)
+{
+return 11+SCPE_IERR;        /* This routine should never be called */
+}
+
 static t_stat x_step_cmd (int32 flag, CONST char *cptr)
 {
 return 6+SCPE_IERR;         /* This routine should never be called */
@@ -718,6 +769,8 @@ return 7+SCPE_IERR;         /* This routine should never be called */
 }
 
 static t_stat x_help_cmd (int32 flag, CONST char *cptr);
+static t_stat sim_rem_bexamine (REMOTE *rem, CONST char *cptr);
+static t_stat sim_rem_bdeposit (REMOTE *rem, CONST char *cptr);
 
 static CTAB allowed_remote_cmds[] = {
     { "EXAMINE",  &exdep_cmd,      EX_E },
@@ -731,6 +784,7 @@ static CTAB allowed_remote_cmds[] = {
     { "REPEAT",   &x_repeat_cmd,      0 },
     { "COLLECT",  &x_collect_cmd,     0 },
     { "SAMPLEOUT",&x_sampleout_cmd,   0 },
+    { "SNAPSHOT", &x_snapshot_cmd,    0 },
     { "STEP",     &x_step_cmd,        0 },
     { "PWD",      &pwd_cmd,           0 },
     { "SAVE",     &save_cmd,          0 },
@@ -741,6 +795,9 @@ static CTAB allowed_remote_cmds[] = {
     { "SET",      &set_cmd,           0 },
     { "SHOW",     &show_cmd,          0 },
     { "HELP",     &x_help_cmd,        0 },
+    { "PIPELINE", &x_pipeline_cmd,    0 },
+    { "BEXAMINE", &x_bexamine_cmd,    0 },
+    { "BDEPOSIT", &x_bdeposit_cmd,    0 },
     { NULL,       NULL }
     };
 
@@ -756,6 +813,7 @@ static CTAB allowed_master_remote_cmds[] = {
     { "REPEAT",   &x_repeat_cmd,      0 },
     { "COLLECT",  &x_collect_cmd,     0 },
     { "SAMPLEOUT",&x_sampleout_cmd,   0 },
+    { "SNAPSHOT", &x_snapshot_cmd,    0 },
     { "EXECUTE",  &x_execute_cmd,     0 },
     { "STEP",     &x_step_cmd,        0 },
     { "PWD",      &pwd_cmd,           0 },
@@ -780,6 +838,9 @@ static CTAB allowed_master_remote_cmds[] = {
     { "DEBUG",    &debug_cmd,         1 },
     { "NODEBUG",  &debug_cmd,         0 },
     { "SEND",     &send_cmd,          0 },
+    { "PIPELINE", &x_pipeline_cmd,    0 },
+    { "BEXAMINE", &x_bexamine_cmd,    0 },
+    { "BDEPOSIT", &x_bdeposit_cmd,    0 },
     { NULL,       NULL }
     };
 
@@ -791,6 +852,7 @@ static CTAB allowed_single_remote_cmds[] = {
     { "REPEAT",   &x_repeat_cmd,      0 },
     { "COLLECT",  &x_collect_cmd,     0 },
     { "SAMPLEOUT",&x_sampleout_cmd,   0 },
+    { "SNAPSHOT", &x_snapshot_cmd,    0 },
     { "EXECUTE",  &x_execute_cmd,     0 },
     { "PWD",      &pwd_cmd,           0 },
     { "DIR",      &dir_cmd,           0 },
@@ -801,6 +863,8 @@ static CTAB allowed_single_remote_cmds[] = {
     { "DEBUG",    &debug_cmd,         1 },
     { "NODEBUG",  &debug_cmd,         0 },
     { "HELP",     &x_help_cmd,        0 },
+    { "PIPELINE", &x_pipeline_cmd,    0 },
+    { "BEXAMINE", &x_bexamine_cmd,    0 },
     { NULL,       NULL }
     };
 
@@ -808,7 +872,11 @@ static CTAB remote_only_cmds[] = {
     { "REPEAT",   &x_repeat_cmd,      0 },
     { "COLLECT",  &x_collect_cmd,     0 },
     { "SAMPLEOUT",&x_sampleout_cmd,   0 },
+    { "SNAPSHOT", &x_snapshot_cmd,    0 },
     { "EXECUTE",  &x_execute_cmd,     0 },
+    { "PIPELINE", &x_pipeline_cmd,    0 },
+    { "BEXAMINE", &x_bexamine_cmd,    0 },
+    { "BDEPOSIT", &x_bdeposit_cmd,    0 },
     { NULL,       NULL }
     };
 
@@ -894,10 +962,24 @@ sim_sub_args (cbuf, sizeof(cbuf), argv);
 cptr = cbuf;
 cptr = get_glyph (cptr, gbuf, 0);               /* get command glyph */
 sim_rem_active_command = find_cmd (gbuf);       /* find command */
+if (sim_rem_active_command == NULL)
+    sim_rem_active_command = find_ctab (remote_only_cmds, gbuf);
 
 if (!sim_processing_event)
     sim_ttcmd ();                               /* restore console */
-stat = sim_rem_active_command->action (sim_rem_active_command->arg, cptr);/* execute command */
+if (sim_rem_active_command->action == &x_bexamine_cmd) {
+    t_bool was_running = sim_is_running;
+
+    sim_is_running = FALSE;                     /* instruction loop has exited, */
+    stat = sim_rem_bexamine (&sim_rem_consoles[sim_rem_cmd_active_line], cptr);
+    sim_is_running = was_running;               /* so wait for the wire */
+    }
+else {
+    if (sim_rem_active_command->action == &x_bdeposit_cmd)
+        stat = sim_rem_bdeposit (&sim_rem_consoles[sim_rem_cmd_active_line], cptr);
+    else
+        stat = sim_rem_active_command->action (sim_rem_active_command->arg, cptr);/* execute command */
+    }
 if (stat != SCPE_OK)
     stat = _sim_rem_message (gbuf, stat);       /* display results */
 sim_last_cmd_stat = SCPE_BARE_STATUS(stat);
@@ -1037,6 +1119,7 @@ if (stat == SCPE_OK) {
             rem->repeat_action = NULL;
             sim_cancel (rem->uptr);
             rem->repeat_pending = FALSE;
+            rem->snap_push = FALSE;
             sim_rem_clract (line);
             }
         }
@@ -1053,6 +1136,7 @@ if (stat == SCPE_OK) {
             sim_cancel (rem->uptr);
             }
         rem->repeat_pending = FALSE;
+        rem->snap_push = FALSE;
         sim_rem_clract (line);
         }
     }
@@ -1255,12 +1339,797 @@ else {
 return stat;
 }
 
+/* Value of one element of a snapshot (or export) register */
+
+static t_value sim_snapshot_reg_value (SNAPSHOT_REG *snp, uint32 idx)
+{
+t_value val = get_rval (snp->reg, idx);
+
+if (snp->indirect) {                                /* assemble size bytes of memory */
+    int32 k, units = (int32)((8 * snp->size + snp->dptr->dwidth - 1) / snp->dptr->dwidth);
+
+    if (get_aval ((t_addr)val, snp->dptr, snp->uptr) != SCPE_OK)
+        units = 0;
+    if (snp->dptr->dwidth >= 8 * sizeof (val))
+        units = (units > 0) ? 1 : 0;
+    for (k = 0, val = 0; (k < units) && (k < sim_emax) && (k * snp->dptr->dwidth < 8 * sizeof (val)); k++)
+        val |= ((units > 1) ? (sim_eval[k] & ((((t_value)1) << snp->dptr->dwidth) - 1)) : sim_eval[k]) << (k * snp->dptr->dwidth);
+    }
+return val;
+}
+
+/* 
+    Parse a snapshot (or export) register item:
+       size {-I} {dev} reg{[lo{:hi}]}
+ */
+static t_stat sim_snapshot_reg_parse (const char *item, SNAPSHOT_REG *snp)
+{
+char gbuf[CBUFSIZE];
+const char *tptr;
+uint32 size, lo, hi;
+REG *reg;
+int32 saved_switches = sim_switches;
+t_bool indirect = FALSE;
+t_stat stat = SCPE_OK;
+
+tptr = get_glyph (item, gbuf, 0);                   /* get element size */
+size = (uint32) get_uint (gbuf, 10, 8, &stat);
+if ((stat != SCPE_OK) || (size == 0))
+    return sim_messagef (SCPE_ARG, "Expected element size found: %s\n", gbuf);
+sim_dfdev = sim_dflt_dev;
+sim_dfunit = sim_dfdev->units;
+if (strchr (tptr, ' ')) {
+    sim_switches = 0;
+    tptr = get_sim_opt (CMD_OPT_SW|CMD_OPT_DFT, tptr, &stat); /* get switches and device */
+    indirect = ((sim_switches & SWMASK('I')) != 0);
+    sim_switches = saved_switches;
+    }
+if (stat != SCPE_OK)
+    return stat;
+tptr = get_glyph (tptr, gbuf, 0);                   /* get register name */
+reg = find_reg (gbuf, &tptr, sim_dfdev);
+if (reg == NULL)
+    return sim_messagef (SCPE_NXREG, "Nonexistent Register: %s\n", gbuf);
+lo = hi = 0;
+if (*tptr == '[') {                                 /* subscript? */
+    const char *tgptr = ++tptr;
+
+    if (reg->depth <= 1)                            /* array register? */
+        return sim_messagef (SCPE_SUB, "Not Array Register: %s\n", reg->name);
+    lo = hi = (uint32) strtotv (tgptr, &tptr, 10);  /* convert index */
+    if ((tgptr != tptr) && (*tptr == ':')) {
+        tgptr = ++tptr;
+        hi = (uint32) strtotv (tgptr, &tptr, 10);
+        }
+    if ((tgptr == tptr) || (*tptr++ != ']'))
+        return sim_messagef (SCPE_SUB, "Missing or Invalid Register Subscript: %s[%s\n", reg->name, tgptr);
+    if ((hi < lo) || (hi >= reg->depth))            /* validate subscript */
+        return sim_messagef (SCPE_SUB, "Invalid Register Subscript: %s[%d:%d]\n", reg->name, lo, hi);
+    }
+snp->reg = reg;
+snp->lo = lo;
+snp->hi = hi;
+snp->indirect = indirect;
+snp->dptr = sim_dfdev;
+snp->uptr = sim_dfunit;
+snp->size = size;
+return SCPE_OK;
+}
+
+static const char *sim_rem_snapshot_echo = "# SNAPSHOT:";
+static const char *sim_rem_snapshot_push_echo = "# SNAPSHOT-PUSH:";
+
+/*
+    Emit a binary register snapshot on a remote console session.
+
+    A snapshot is a "# SNAPSHOT:nnn" (or "# SNAPSHOT-PUSH:nnn" when it
+    was produced by the repeat timer) text line followed by nnn bytes 
+    of little endian data:
+
+        8 bytes             simulation time
+        size bytes          for each element of each SNAPSHOT DEFINE register
+        2 + 4*width bytes   for each COLLECT register: the bit count followed
+                            by the sample total of each bit
+
+    The layout is fixed by the SNAPSHOT DEFINE and COLLECT commands, so
+    the client decodes it positionally without any text parsing.
+ */
+static t_stat sim_rem_snapshot_output (REMOTE *rem, const char *tag)
+{
+size_t i, len, hdr, need = 8;
+uint32 idx, bit;
+t_uint64 now = (t_uint64)sim_gtime ();
+uint8 *buf;
+char hbuf[64];
+
+for (i = 0; i < rem->snap_reg_count; i++)
+    need += (rem->snap_regs[i].hi - rem->snap_regs[i].lo + 1) * rem->snap_regs[i].size;
+for (i = 0; i < rem->smp_reg_count; i++)
+    need += 2 + 4 * rem->smp_regs[i].width;
+hdr = (size_t)snprintf (hbuf, sizeof (hbuf), "%s%d\r\n", tag, (int)need);
+if (hdr + need > rem->snap_buf_size) {
+    buf = (uint8 *)realloc (rem->snap_buf, hdr + need);
+    if (buf == NULL)
+        return SCPE_MEM;
+    rem->snap_buf = buf;
+    rem->snap_buf_size = hdr + need;
+    }
+memcpy (rem->snap_buf, hbuf, hdr);                  /* header and data go out as one block */
+buf = rem->snap_buf + hdr;
+for (len = 0; len < 8; len++, now >>= 8)
+    buf[len] = (uint8)(now & 0xFF);
+for (i = 0; i < rem->snap_reg_count; i++) {
+    SNAPSHOT_REG *snp = &rem->snap_regs[i];
+
+    for (idx = snp->lo; idx <= snp->hi; idx++) {
+        t_value val = sim_snapshot_reg_value (snp, idx);
+        uint32 b;
+
+        for (b = 0; b < snp->size; b++) {
+            buf[len++] = (uint8)(val & 0xFF);
+            val = (b < sizeof (val) - 1) ? (val >> 8) : 0;
+            }
+        }
+    }
+for (i = 0; i < rem->smp_reg_count; i++) {
+    BITSAMPLE_REG *smp = &rem->smp_regs[i];
+
+    buf[len++] = (uint8)(smp->width & 0xFF);
+    buf[len++] = (uint8)((smp->width >> 8) & 0xFF);
+    for (bit = 0; bit < smp->width; bit++) {
+        uint32 tot = (uint32)smp->bits[bit].tot;
+
+        buf[len++] = (uint8)(tot & 0xFF);
+        buf[len++] = (uint8)((tot >> 8) & 0xFF);
+        buf[len++] = (uint8)((tot >> 16) & 0xFF);
+        buf[len++] = (uint8)((tot >> 24) & 0xFF);
+        }
+    }
+sim_debug (DBG_SNP, &sim_remote_console, "Snapshot(line=%d) - %d bytes\n", rem->line, (int)len);
+return tmxr_putblk_ln (rem->lp, rem->snap_buf, hdr + len);/* a push which doesn't fit is dropped */
+}
+
+static void sim_rem_snapshot_stop (REMOTE *rem)
+{
+if (rem->snap_push) {
+    rem->snap_push = FALSE;
+    rem->repeat_interval = 0;
+    sim_cancel (rem->uptr);
+    }
+}
+
+static void sim_rem_snapshot_clear (REMOTE *rem)
+{
+free (rem->snap_regs);
+rem->snap_regs = NULL;
+rem->snap_reg_count = 0;
+sim_rem_snapshot_stop (rem);
+}
+
+/* 
+    Parse and setup Remote Console SNAPSHOT command:
+       SNAPSHOT DEFINE size {-I} {dev} reg{[lo{:hi}]}{,size reg...}
+       SNAPSHOT EVERY nnn USECS
+       SNAPSHOT STOP
+       SNAPSHOT
+ */
+static t_stat sim_rem_snapshot_cmd_setup (int32 line, CONST char **iptr)
+{
+char gbuf[CBUFSIZE];
+int32 val;
+t_stat stat = SCPE_OK;
+CONST char *cptr = *iptr;
+REMOTE *rem = &sim_rem_consoles[line];
+
+sim_debug (DBG_SNP, &sim_remote_console, "Snapshot Setup: %s\n", cptr);
+if (*cptr == 0) {                                   /* emit a snapshot now */
+    if (rem->snap_reg_count == 0)
+        return sim_messagef (SCPE_ARG, "No snapshot registers defined\n");
+    return sim_rem_snapshot_output (rem, sim_rem_snapshot_echo);
+    }
+cptr = get_glyph (cptr, gbuf, 0);                   /* get next glyph */
+if (MATCH_CMD (gbuf, "STOP") == 0) {
+    *iptr = cptr;
+    if (*cptr)
+        return SCPE_2MARG;
+    sim_rem_snapshot_stop (rem);                    /* the layout stays defined */
+    return SCPE_OK;
+    }
+if (MATCH_CMD (gbuf, "EVERY") == 0) {
+    cptr = get_glyph (cptr, gbuf, 0);               /* get next glyph */
+    val = (int32) get_uint (gbuf, 10, INT_MAX, &stat);
+    if ((stat != SCPE_OK) || (val <= 0)) {          /* error? */
+        *iptr = cptr;
+        return sim_messagef (SCPE_ARG, "Expected value found: %s\n", gbuf);
+        }
+    cptr = get_glyph (cptr, gbuf, 0);               /* get next glyph */
+    *iptr = cptr;
+    if ((MATCH_CMD (gbuf, "USECS") != 0) || (*cptr != 0))
+        return sim_messagef (SCPE_ARG, "Expected USECS found: %s\n", gbuf);
+    if (rem->snap_reg_count == 0)
+        return sim_messagef (SCPE_ARG, "No snapshot registers defined\n");
+    free (rem->repeat_action);                      /* snapshots replace any repeat command */
+    rem->repeat_action = NULL;
+    rem->repeat_pending = FALSE;
+    rem->repeat_interval = val;
+    rem->snap_push = TRUE;
+    return sim_activate_after (rem->uptr, rem->repeat_interval);
+    }
+if (MATCH_CMD (gbuf, "DEFINE") != 0) {
+    *iptr = cptr;
+    return sim_messagef (SCPE_ARG, "Expected DEFINE, EVERY or STOP found: %s\n", gbuf);
+    }
+sim_rem_snapshot_clear (rem);                       /* Start from a clean slate */
+while (cptr && *cptr) {
+    const char *comma = strchr (cptr, ',');
+    char tbuf[2*CBUFSIZE];
+    SNAPSHOT_REG snp, *snap_regs;
+
+    if (comma) {
+        strncpy (tbuf, cptr, comma - cptr);
+        tbuf[comma - cptr] = '\0';
+        cptr = comma + 1;
+        }
+    else {
+        strcpy (tbuf, cptr);
+        cptr += strlen (cptr);
+        }
+    stat = sim_snapshot_reg_parse (tbuf, &snp);
+    if (stat != SCPE_OK)
+        break;
+    snap_regs = (SNAPSHOT_REG *)realloc (rem->snap_regs, (rem->snap_reg_count + 1) * sizeof(*snap_regs));
+    if (snap_regs == NULL) {
+        stat = SCPE_MEM;
+        break;
+        }
+    rem->snap_regs = snap_regs;
+    snap_regs[rem->snap_reg_count] = snp;
+    rem->snap_reg_count += 1;
+    }
+*iptr = cptr;
+if (stat != SCPE_OK)                                /* Error? */
+    sim_rem_snapshot_clear (rem);                   /* Cleanup mess */
+return stat;
+}
+
+static const char *sim_rem_pipeline_status_echo = "# STATUS:";
+
+/*
+    Report the completion status of a command on a pipelined session.
+
+    In pipelined mode a session's input isn't echoed and no prompts are 
+    written, so a client can send many commands without waiting for each 
+    response.  Every command's output is followed by a "# STATUS:n" line 
+    (n is the command's SCPE status, 0 for success) which delimits the 
+    responses.  Empty and comment lines produce no output at all.
+ */
+static void sim_rem_pipeline_status (REMOTE *rem, t_stat stat)
+{
+TMLN *lp = rem->lp;
+
+if (!rem->pipeline)
+    return;
+tmxr_linemsgf (lp, "%s%d\r\n", sim_rem_pipeline_status_echo, SCPE_BARE_STATUS(stat));
+if (((rem->act == NULL) && (!tmxr_input_pending_ln (lp))) ||    /* no more commands queued */
+    (tmxr_tqln (lp) > lp->txbsz / 2))                           /* OR output backing up? */
+    tmxr_send_buffered_data (lp);                               /* flush any buffered data */
+}
+
+/* 
+    Parse and setup Remote Console PIPELINE command:
+       PIPELINE ON
+       PIPELINE OFF
+ */
+static t_stat sim_rem_pipeline_cmd_setup (int32 line, CONST char **iptr)
+{
+char gbuf[CBUFSIZE];
+CONST char *cptr = *iptr;
+REMOTE *rem = &sim_rem_consoles[line];
+
+if (*cptr == 0)
+    return SCPE_2FARG;
+cptr = get_glyph (cptr, gbuf, 0);                   /* get next glyph */
+*iptr = cptr;
+if (*cptr)
+    return SCPE_2MARG;
+if (MATCH_CMD (gbuf, "ON") == 0) {
+    rem->pipeline = TRUE;
+    return SCPE_OK;
+    }
+if (MATCH_CMD (gbuf, "OFF") == 0) {
+    sim_rem_pipeline_status (rem, SCPE_OK);         /* acknowledge before leaving */
+    rem->pipeline = FALSE;
+    return SCPE_OK;
+    }
+return sim_messagef (SCPE_ARG, "Expected ON or OFF found: %s\n", gbuf);
+}
+
+/*
+    Remote Console bulk memory transfers:
+       BEXAMINE {-switches} {dev} range
+       BDEPOSIT {-switches} {dev} address hexdata
+
+    BEXAMINE responds with a "# BEXAMINE:nnn" text line followed by nnn 
+    bytes of raw data.  Each addressable unit in the range occupies 
+    (data width + 7)/8 bytes, little endian.  BDEPOSIT stores consecutive 
+    units starting at address from a string of hex digits holding the 
+    same byte layout (input on a telnet session isn't 8 bit clean, so the 
+    data is hex encoded).  Both use the device's examine and deposit 
+    routines, as EXAMINE and DEPOSIT do, so -switches select the same 
+    address spaces.
+ */
+
+#define REM_BULK_MAX        (16*1024*1024)  /* largest bulk transfer (bytes) */
+
+static const char *sim_rem_bexamine_echo = "# BEXAMINE:";
+
+static t_stat sim_rem_bulk_device (CONST char **iptr, DEVICE **dptr, UNIT **uptr, size_t *bytes)
+{
+t_stat stat;
+CONST char *cptr = get_sim_opt (CMD_OPT_SW|CMD_OPT_DFT, *iptr, &stat);  /* get switches and device */
+
+if (cptr == NULL)
+    return stat;
+*iptr = cptr;
+*dptr = sim_dfdev;
+*uptr = sim_dfunit;
+if (((*dptr)->dwidth == 0) || ((*dptr)->aincr == 0))
+    return sim_messagef (SCPE_NOFNC, "Device %s has no memory\n", (*dptr)->name);
+if (*cptr == 0)
+    return SCPE_2FARG;
+*bytes = ((*dptr)->dwidth + 7) / 8;
+return SCPE_OK;
+}
+
+static t_stat sim_rem_bexamine (REMOTE *rem, CONST char *cptr)
+{
+t_stat stat;
+DEVICE *dptr;
+UNIT *uptr;
+t_addr lo, hi, addr;
+size_t bytes, len, need;
+uint8 *buf;
+
+stat = sim_rem_bulk_device (&cptr, &dptr, &uptr, &bytes);
+if (stat != SCPE_OK)
+    return stat;
+cptr = get_range (dptr, cptr, &lo, &hi, dptr->aradix, 0, 0);
+if ((cptr == NULL) || (*cptr != 0))
+    return sim_messagef (SCPE_ARG, "Invalid memory range\n");
+if ((hi - lo) / dptr->aincr >= REM_BULK_MAX / bytes)
+    return sim_messagef (SCPE_ARG, "Bulk transfers are limited to %d bytes\n", REM_BULK_MAX);
+need = (size_t)((hi - lo) / dptr->aincr + 1) * bytes;
+buf = (uint8 *)malloc (need);
+if (buf == NULL)
+    return SCPE_MEM;
+for (addr = lo, len = 0; len < need; addr += dptr->aincr) {
+    t_value val = 0;
+    size_t b;
+
+    if (dptr->examine)
+        stat = dptr->examine (&val, addr, uptr, sim_switches);
+    else {
+        stat = get_aval (addr, dptr, uptr);
+        val = sim_eval[0];
+        }
+    if (stat != SCPE_OK) {
+        free (buf);
+        return stat;
+        }
+    for (b = 0; b < bytes; b++) {
+        buf[len++] = (uint8)(val & 0xFF);
+        val = (b < sizeof (val) - 1) ? (val >> 8) : 0;
+        }
+    }
+sim_debug (DBG_CMD, &sim_remote_console, "BEXAMINE(line=%d) - %d bytes\n", rem->line, (int)len);
+tmxr_linemsgf (rem->lp, "%s%d\r\n", sim_rem_bexamine_echo, (int)len);
+stat = tmxr_putblk_ln (rem->lp, buf, len);
+free (buf);
+return stat;
+}
+
+static t_stat sim_rem_bdeposit (REMOTE *rem, CONST char *cptr)
+{
+char gbuf[CBUFSIZE];
+t_stat stat;
+DEVICE *dptr;
+UNIT *uptr;
+t_addr lo, hi, addr;
+size_t bytes, digits, b;
+CONST char *tptr;
+
+stat = sim_rem_bulk_device (&cptr, &dptr, &uptr, &bytes);
+if (stat != SCPE_OK)
+    return stat;
+if (dptr->deposit == NULL)
+    return sim_messagef (SCPE_NOFNC, "Device %s has no memory\n", dptr->name);
+if (uptr->flags & UNIT_RO)                          /* read only? */
+    return SCPE_RO;
+cptr = get_glyph (cptr, gbuf, 0);                   /* get address */
+tptr = get_range (dptr, gbuf, &lo, &hi, dptr->aradix, 0, 0);
+if ((tptr == NULL) || (*tptr != 0) || (lo != hi))
+    return sim_messagef (SCPE_ARG, "Invalid address: %s\n", gbuf);
+if (*cptr == 0)
+    return SCPE_2FARG;
+for (digits = 0; isxdigit ((unsigned char)cptr[digits]); digits++)
+    ;
+if ((cptr[digits] != 0) || (digits % (2 * bytes)))
+    return sim_messagef (SCPE_ARG, "Data must be hex digits, %d per unit\n", (int)(2 * bytes));
+sim_debug (DBG_CMD, &sim_remote_console, "BDEPOSIT(line=%d) - %d bytes\n", rem->line, (int)(digits / 2));
+for (addr = lo; *cptr; addr += dptr->aincr) {
+    t_value val = 0;
+
+    for (b = 0; b < bytes; b++, cptr += 2) {
+        char hex[3] = {cptr[0], cptr[1], 0};
+
+        if (b < sizeof (val))
+            val |= ((t_value)strtoul (hex, NULL, 16)) << (8 * b);
+        }
+    if (dptr->dwidth < 8 * sizeof (val))
+        val &= (((t_value)1) << dptr->dwidth) - 1;
+    stat = dptr->deposit (val, addr, uptr, sim_switches);
+    if (stat != SCPE_OK)
+        return stat;
+    }
+return SCPE_OK;
+}
+
+/*
+    Shared memory state export
+
+    EXPORT publishes the values of a set of registers and memory ranges in
+    a named shared memory region (see sim_export.h for its layout and the
+    client API used to read it).  The values are refreshed every interval
+    instructions by an internal unit.  Each refresh is bracketed by a 
+    sequence lock, so external readers never block the simulator.
+ */
+
+typedef struct EXPORT_ITEM EXPORT_ITEM;
+struct EXPORT_ITEM {
+    SNAPSHOT_REG    reg;            /* register elements (reg.reg NULL for memory) */
+    t_addr          lo;             /* first memory address */
+    t_addr          hi;             /* last memory address */
+    int32           switches;       /* examine switches for memory */
+    uint8           *data;          /* where the values are published */
+    };
+
+#define EXPORT_SHM_NAME_SIZE (sizeof (SIM_EXPORT_NAME_PREFIX) + SIM_EXPORT_NAME_MAX)
+
+static struct {
+    char                name[SIM_EXPORT_NAME_MAX + 1];  /* export name */
+    char                shm_name[EXPORT_SHM_NAME_SIZE]; /* shared memory object name */
+    SHMEM               *shmem;             /* shared memory object */
+    SIM_EXPORT_HEADER   *hdr;               /* mapped region */
+    EXPORT_ITEM         *items;             /* exported items */
+    uint32              item_count;
+    int32               interval;           /* instructions between updates */
+    } sim_export;
+
+#define EXPORT_DEFAULT_INTERVAL 100000      /* default instructions between updates */
+
+static t_stat sim_export_svc (UNIT *uptr);
+
+static UNIT sim_export_unit = { UDATA (&sim_export_svc, UNIT_DIS, 0) };
+
+static const char *sim_export_description (DEVICE *dptr)
+{
+return "Shared Memory State Export Facility";
+}
+
+static DEVICE sim_export_dev = {
+    "SIM-EXPORT", &sim_export_unit, NULL, NULL, 
+    1, 0, 0, 0, 0, 0, 
+    NULL, NULL, NULL, NULL, NULL, NULL, 
+    NULL, DEV_NOSAVE, 0, NULL,
+    NULL, NULL, NULL, NULL, NULL, sim_export_description};
+
+static void sim_export_store (uint8 *p, uint32 size, t_value val)
+{
+switch (size) {
+    case 1:
+        *p = (uint8)val;
+        break;
+    case 2:
+        *(uint16 *)p = (uint16)val;
+        break;
+    case 4:
+        *(uint32 *)p = (uint32)val;
+        break;
+    default:
+        *(t_uint64 *)p = (t_uint64)val;
+        break;
+    }
+}
+
+static void sim_export_update (void)
+{
+SIM_EXPORT_HEADER *hdr = sim_export.hdr;
+uint32 i;
+
+hdr->sequence += 1;                                 /* odd - update in progress */
+SIM_EXPORT_BARRIER ();
+for (i = 0; i < sim_export.item_count; i++) {
+    EXPORT_ITEM *item = &sim_export.items[i];
+    uint8 *p = item->data;
+
+    if (item->reg.reg) {
+        uint32 idx;
+
+        for (idx = item->reg.lo; idx <= item->reg.hi; idx++, p += item->reg.size)
+            sim_export_store (p, item->reg.size, sim_snapshot_reg_value (&item->reg, idx));
+        }
+    else {
+        DEVICE *dptr = item->reg.dptr;
+        t_addr addr;
+
+        for (addr = item->lo; addr <= item->hi; addr += dptr->aincr, p += item->reg.size) {
+            t_value val = 0;
+
+            if (dptr->examine) {
+                if (dptr->examine (&val, addr, item->reg.uptr, item->switches) != SCPE_OK)
+                    val = 0;
+                }
+            else {
+                if (get_aval (addr, dptr, item->reg.uptr) == SCPE_OK)
+                    val = sim_eval[0];
+                }
+            sim_export_store (p, item->reg.size, val);
+            if (addr + dptr->aincr < addr)          /* end of the address space? */
+                break;
+            }
+        }
+    }
+hdr->simulation_time = (t_uint64)sim_gtime ();
+hdr->updates += 1;
+SIM_EXPORT_BARRIER ();
+hdr->sequence += 1;                                 /* even - update complete */
+}
+
+static t_stat sim_export_svc (UNIT *uptr)
+{
+sim_export_update ();
+return sim_activate (uptr, sim_export.interval);
+}
+
+static void sim_export_close (void)
+{
+sim_cancel (&sim_export_unit);
+if (sim_export.hdr) {
+    sim_export.hdr->active = 0;                     /* tell readers we're gone */
+    SIM_EXPORT_BARRIER ();
+    }
+sim_shmem_close (sim_export.shmem);
+free (sim_export.items);
+memset (&sim_export, 0, sizeof (sim_export));
+}
+
+/* 
+    Parse an export memory item:
+       MEMORY {-switches} {dev} range
+ */
+static t_stat sim_export_mem_parse (const char *item, EXPORT_ITEM *exp)
+{
+char gbuf[CBUFSIZE];
+const char *tptr;
+int32 saved_switches = sim_switches;
+t_stat stat = SCPE_OK;
+t_addr lo, hi;
+DEVICE *dptr;
+
+tptr = get_glyph (item, gbuf, 0);                   /* skip MEMORY */
+sim_dfdev = sim_dflt_dev;
+sim_dfunit = sim_dfdev->units;
+sim_switches = 0;
+if (strchr (tptr, ' '))
+    tptr = get_sim_opt (CMD_OPT_SW|CMD_OPT_DFT, tptr, &stat); /* get switches and device */
+exp->switches = sim_switches;
+sim_switches = saved_switches;
+if (stat != SCPE_OK)
+    return stat;
+dptr = sim_dfdev;
+if ((dptr->dwidth == 0) || (dptr->aincr == 0))
+    return sim_messagef (SCPE_NOFNC, "Device %s has no memory to export\n", dptr->name);
+tptr = get_range (dptr, tptr, &lo, &hi, dptr->aradix, 0, 0);
+if ((tptr == NULL) || (*tptr != 0) || (hi < lo))
+    return sim_messagef (SCPE_ARG, "Invalid memory range: %s\n", item);
+exp->reg.reg = NULL;
+exp->reg.dptr = dptr;
+exp->reg.uptr = sim_dfunit;
+exp->reg.size = (dptr->dwidth <= 8) ? 1 : ((dptr->dwidth <= 16) ? 2 : ((dptr->dwidth <= 32) ? 4 : 8));
+exp->reg.lo = 0;
+exp->reg.hi = (uint32)((hi - lo) / dptr->aincr);
+exp->lo = lo;
+exp->hi = hi;
+return SCPE_OK;
+}
+
+/* 
+    EXPORT name {EVERY nnn {INSTRUCTIONS}} item{,item...}
+        item:   size {-I} {dev} reg{[lo{:hi}]}
+                MEMORY {-switches} {dev} range
+    NOEXPORT
+ */
+t_stat sim_export_cmd (int32 flag, CONST char *cptr)
+{
+char gbuf[CBUFSIZE], name[CBUFSIZE];
+const char *nptr;
+t_stat stat = SCPE_OK;
+int32 interval = EXPORT_DEFAULT_INTERVAL;
+EXPORT_ITEM *items = NULL;
+uint32 i, item_count = 0;
+size_t item_offset, data_offset, data_size, offset;
+SIM_EXPORT_HEADER *hdr;
+SIM_EXPORT_ITEM *desc;
+
+if (!flag) {                                        /* NOEXPORT */
+    if (cptr && *cptr)
+        return SCPE_2MARG;
+    sim_export_close ();
+    return SCPE_OK;
+    }
+if ((cptr == NULL) || (*cptr == 0))
+    return SCPE_2FARG;
+cptr = get_glyph_nc (cptr, name, 0);                /* get export name */
+if (strlen (name) > SIM_EXPORT_NAME_MAX)
+    return sim_messagef (SCPE_ARG, "Export name longer than %d characters: %s\n", SIM_EXPORT_NAME_MAX, name);
+for (nptr = name; *nptr; nptr++)
+    if (!isalnum (*nptr) && !strchr ("-_.", *nptr))
+        return sim_messagef (SCPE_ARG, "Invalid character in export name: %s\n", name);
+get_glyph (cptr, gbuf, 0);
+if (MATCH_CMD (gbuf, "EVERY") == 0) {
+    cptr = get_glyph (cptr, gbuf, 0);               /* skip EVERY */
+    cptr = get_glyph (cptr, gbuf, 0);               /* get interval */
+    interval = (int32) get_uint (gbuf, 10, INT_MAX, &stat);
+    if ((stat != SCPE_OK) || (interval <= 0))
+        return sim_messagef (SCPE_ARG, "Expected instruction interval found: %s\n", gbuf);
+    get_glyph (cptr, gbuf, 0);
+    if (MATCH_CMD (gbuf, "INSTRUCTIONS") == 0)
+        cptr = get_glyph (cptr, gbuf, 0);           /* skip INSTRUCTIONS */
+    }
+if (*cptr == 0)
+    return sim_messagef (SCPE_2FARG, "No registers or memory to export\n");
+while (*cptr) {
+    const char *comma = strchr (cptr, ',');
+    char tbuf[2*CBUFSIZE];
+    EXPORT_ITEM *t;
+
+    if (comma) {
+        strncpy (tbuf, cptr, comma - cptr);
+        tbuf[comma - cptr] = '\0';
+        cptr = comma + 1;
+        }
+    else {
+        strcpy (tbuf, cptr);
+        cptr += strlen (cptr);
+        }
+    t = (EXPORT_ITEM *)realloc (items, (item_count + 1) * sizeof (*items));
+    if (t == NULL) {
+        stat = SCPE_MEM;
+        break;
+        }
+    items = t;
+    memset (&items[item_count], 0, sizeof (*items));
+    get_glyph (tbuf, gbuf, 0);
+    if (MATCH_CMD (gbuf, "MEMORY") == 0)
+        stat = sim_export_mem_parse (tbuf, &items[item_count]);
+    else {
+        stat = sim_snapshot_reg_parse (tbuf, &items[item_count].reg);
+        if ((stat == SCPE_OK) && (items[item_count].reg.size & (items[item_count].reg.size - 1)))
+            stat = sim_messagef (SCPE_ARG, "Export element size must be 1, 2, 4 or 8: %s\n", tbuf);
+        }
+    if (stat != SCPE_OK)
+        break;
+    item_count += 1;
+    }
+/* Lay out the region: header, item table then naturally aligned data */
+item_offset = (sizeof (*hdr) + 7) & ~((size_t)7);
+data_offset = (item_offset + item_count * sizeof (*desc) + 63) & ~((size_t)63);
+for (i = 0, data_size = 0; (stat == SCPE_OK) && (i < item_count); i++) {
+    size_t size = items[i].reg.size;
+
+    data_size = (data_size + size - 1) & ~(size - 1);
+    items[i].data = (uint8 *)data_size;             /* offset until the region is mapped */
+    data_size += (items[i].reg.hi - items[i].reg.lo + 1) * size;
+    if (data_offset + data_size > 0x7FFFFFFF)
+        stat = sim_messagef (SCPE_ARG, "Export region too large\n");
+    }
+if (stat != SCPE_OK) {
+    free (items);
+    return stat;
+    }
+sim_export_close ();                                /* replace any prior export */
+strcpy (sim_export.name, name);
+sprintf (sim_export.shm_name, "%s%s", SIM_EXPORT_NAME_PREFIX, name);
+sim_shmem_unlink (sim_export.shm_name);             /* discard any region with a stale layout */
+stat = sim_shmem_open (sim_export.shm_name, data_offset + data_size, &sim_export.shmem, (void **)&hdr);
+if (stat != SCPE_OK) {
+    free (items);
+    stat = sim_messagef (stat, "Can't create export shared memory region %s\n", sim_export.shm_name);
+    memset (&sim_export, 0, sizeof (sim_export));
+    return stat;
+    }
+memset (hdr, 0, data_offset + data_size);
+hdr->version = SIM_EXPORT_VERSION;
+hdr->pid = (unsigned int)getpid ();
+hdr->interval = (unsigned int)interval;
+hdr->item_count = item_count;
+hdr->item_offset = (unsigned int)item_offset;
+hdr->data_offset = (unsigned int)data_offset;
+hdr->data_size = (unsigned int)data_size;
+strlcpy (hdr->sim_name, sim_name, sizeof (hdr->sim_name));
+desc = (SIM_EXPORT_ITEM *)((uint8 *)hdr + item_offset);
+for (i = 0; i < item_count; i++) {
+    EXPORT_ITEM *item = &items[i];
+
+    offset = (size_t)item->data;
+    item->data = (uint8 *)hdr + data_offset + offset;
+    strlcpy (desc[i].name, item->reg.reg ? item->reg.reg->name : "MEMORY", sizeof (desc[i].name));
+    strlcpy (desc[i].device, item->reg.dptr->name, sizeof (desc[i].device));
+    desc[i].type = item->reg.reg ? SIM_EXPORT_REGISTER : SIM_EXPORT_MEMORY;
+    desc[i].flags = item->reg.indirect ? SIM_EXPORT_F_INDIRECT : 0;
+    desc[i].element_size = item->reg.size;
+    desc[i].element_count = item->reg.hi - item->reg.lo + 1;
+    desc[i].offset = (unsigned int)offset;
+    desc[i].address_increment = item->reg.reg ? 0 : item->reg.dptr->aincr;
+    desc[i].first = item->reg.reg ? item->reg.lo : (unsigned long long)item->lo;
+    }
+sim_export.hdr = hdr;
+sim_export.items = items;
+sim_export.item_count = item_count;
+sim_export.interval = interval;
+sim_export_update ();                               /* publish the current state */
+hdr->active = 1;
+SIM_EXPORT_BARRIER ();
+hdr->magic = SIM_EXPORT_MAGIC;                      /* layout is now valid */
+sim_register_internal_device (&sim_export_dev);
+return sim_activate (&sim_export_unit, sim_export.interval);
+}
+
+t_stat sim_show_export (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr)
+{
+uint32 i;
+
+if (cptr && (*cptr != 0))
+    return SCPE_2MARG;
+if (sim_export.hdr == NULL) {
+    fprintf (st, "No state is being exported\n");
+    return SCPE_OK;
+    }
+fprintf (st, "Exporting %d item%s (%d bytes) to shared memory %s every %d instructions\n", 
+         (int)sim_export.item_count, (sim_export.item_count == 1) ? "" : "s", 
+         (int)sim_export.hdr->data_size, sim_export.shm_name, (int)sim_export.interval);
+fprintf (st, "%s updates have been published\n", sim_fmt_numeric ((double)sim_export.hdr->updates));
+for (i = 0; i < sim_export.item_count; i++) {
+    EXPORT_ITEM *item = &sim_export.items[i];
+
+    if (item->reg.reg) {
+        fprintf (st, "  %d %s%s %s", (int)item->reg.size, item->reg.indirect ? "-I " : "", item->reg.dptr->name, item->reg.reg->name);
+        if (item->reg.reg->depth > 1)
+            fprintf (st, "[%d:%d]", (int)item->reg.lo, (int)item->reg.hi);
+        fprintf (st, "\n");
+        }
+    else {
+        fprintf (st, "  MEMORY %s ", item->reg.dptr->name);
+        fprint_val (st, (t_value)item->lo, item->reg.dptr->aradix, item->reg.dptr->awidth, PV_LEFT);
+        fprintf (st, "-");
+        fprint_val (st, (t_value)item->hi, item->reg.dptr->aradix, item->reg.dptr->awidth, PV_LEFT);
+        fprintf (st, "\n");
+        }
+    }
+return SCPE_OK;
+}
+
 t_stat sim_rem_con_repeat_svc (UNIT *uptr)
 {
 int line = uptr - rem_con_repeat_units;
 REMOTE *rem = &sim_rem_consoles[line];
 
 sim_debug (DBG_REP, &sim_remote_console, "sim_rem_con_repeat_svc(line=%d) - interval=%d usecs\n", line, rem->repeat_interval);
+if (rem->snap_push) {                                       /* pushing snapshots? */
+    sim_rem_snapshot_output (rem, sim_rem_snapshot_push_echo);/* emit directly without leaving the instruction loop */
+    sim_activate_after (uptr, rem->repeat_interval);        /* reschedule */
+    return SCPE_OK;
+    }
 if (rem->repeat_interval) {
     rem->repeat_pending = TRUE;
     sim_activate_after (uptr, rem->repeat_interval);        /* reschedule */
@@ -1373,6 +2242,9 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
             cptr = strcpy (gbuf, "STOP");
             sim_rem_collect_cmd_setup (i, &cptr);   /* make sure it is now disabled */
             }
+        if (rem->snap_reg_count)                    /* was a snapshot schema defined? */
+            sim_rem_snapshot_clear (rem);           /* discard it */
+        rem->pipeline = FALSE;
         continue;
         }
     if (master_session && !sim_rem_master_was_connected) {
@@ -1390,7 +2262,11 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
                 stat = SCPE_STEP;
                 _sim_rem_message ("STEP", stat);    /* produce a STEP complete message */
                 }
+            else
+                stat = sim_last_cmd_stat;
             _sim_rem_log_out (lp);
+            if (sim_rem_active_command != &allowed_single_remote_cmds[0])/* Not a comment or a stop? */
+                sim_rem_pipeline_status (rem, stat);
             sim_rem_active_command = NULL;          /* Restart loop to process available input */
             was_active_command = FALSE;
             i = -1;
@@ -1455,7 +2331,7 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
                         tmxr_reset_ln (lp);
                         continue;
                         }
-                    if (rem->buf_ptr == 0) {
+                    if ((rem->buf_ptr == 0) && (!rem->pipeline)) {
                         /* we just picked up the first character on a command line */
                         if (!master_session)
                             tmxr_linemsgf (lp, "\r\n%s", sim_prompt);
@@ -1475,11 +2351,13 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
             return stat|SCPE_NOMESSAGE;
         if ((!rem->single_mode) && (rem->act == NULL)) {
             read_start_time = sim_os_msec();
-            if (master_session)
-                tmxr_linemsg (lp, "sim> ");
-            else
-                tmxr_linemsg (lp, sim_prompt);
-            tmxr_send_buffered_data (lp);               /* flush any buffered data */
+            if (!rem->pipeline) {
+                if (master_session)
+                    tmxr_linemsg (lp, "sim> ");
+                else
+                    tmxr_linemsg (lp, sim_prompt);
+                tmxr_send_buffered_data (lp);           /* flush any buffered data */
+                }
             }
         do {
             if (rem->buf_ptr == 0) {
@@ -1527,8 +2405,11 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
                         got_command = TRUE;
                         break;
                         }
-                    sim_os_ms_sleep (50);
                     tmxr_poll_rx (&sim_rem_con_tmxr);   /* poll input */
+                    if (!tmxr_input_pending_ln (lp)) {  /* nothing more arrived yet? */
+                        sim_os_ms_sleep (50);
+                        tmxr_poll_rx (&sim_rem_con_tmxr);/* poll input */
+                        }
                     if (!lp->conn) {                    /* if connection lost? */
                         rem->single_mode = TRUE;        /* No longer multi-command more */
                         break;                          /* done waiting */
@@ -1544,14 +2425,16 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
                 case '\b':  /* Backspace */
                 case 127:   /* Rubout */
                     if (rem->buf_ptr > 0) {
-                        tmxr_linemsg (lp, "\b \b");
+                        if (!rem->pipeline)
+                            tmxr_linemsg (lp, "\b \b");
                         --rem->buf_ptr;
                         }
                     break;
                 case 27:   /* escape */
                 case 21:   /* ^U */
                     while (rem->buf_ptr > 0) {
-                        tmxr_linemsg (lp, "\b \b");
+                        if (!rem->pipeline)
+                            tmxr_linemsg (lp, "\b \b");
                         --rem->buf_ptr;
                         }
                     break;
@@ -1559,7 +2442,8 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
                     if (rem->buf_ptr == 0)
                         break;
                 case '\r':
-                    tmxr_linemsg (lp, "\r\n");
+                    if (!rem->pipeline)
+                        tmxr_linemsg (lp, "\r\n");
                     if (rem->buf_ptr+1 >= rem->buf_size) {
                         rem->buf_size += 1024;
                         rem->buf = (char *)realloc (rem->buf, rem->buf_size);
@@ -1586,7 +2470,8 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
                     close_session = TRUE;
                     break;
                 default:
-                    tmxr_putc_ln (lp, c);
+                    if (!rem->pipeline)                 /* echo unless pipelined */
+                        tmxr_putc_ln (lp, c);
                     if (rem->buf_ptr+2 >= rem->buf_size) {
                         rem->buf_size += 1024;
                         rem->buf = (char *)realloc (rem->buf, rem->buf_size);
@@ -1731,16 +2616,42 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
                                             stat = sim_rem_collect_cmd_setup (i, &cptr);
                                             }
                                         else {
-                                            if (sim_con_stable_registers && 
-                                                sim_rem_master_mode) {  /* can we process command now? */
-                                                sim_debug (DBG_CMD, &sim_remote_console, "Processing Command directly\n");
+                                            if (cmdp->action == &x_snapshot_cmd) {
+                                                sim_debug (DBG_CMD, &sim_remote_console, "snapshot_cmd executing\n");
                                                 sim_oline = lp;         /* specify output socket */
-                                                sim_remote_process_command ();
-                                                stat = SCPE_OK;         /* any message has already been emitted */
+                                                stat = sim_rem_snapshot_cmd_setup (i, &cptr);
+                                                sim_last_cmd_stat = SCPE_BARE_STATUS(stat);
                                                 }
                                             else {
-                                                sim_debug (DBG_CMD, &sim_remote_console, "Processing Command via SCPE_REMOTE\n");
-                                                stat = SCPE_REMOTE;     /* force processing outside of sim_instr() */
+                                                if (cmdp->action == &x_pipeline_cmd) {
+                                                    sim_debug (DBG_CMD, &sim_remote_console, "pipeline_cmd executing\n");
+                                                    sim_oline = lp;         /* specify output socket */
+                                                    stat = sim_rem_pipeline_cmd_setup (i, &cptr);
+                                                    sim_last_cmd_stat = SCPE_BARE_STATUS(stat);
+                                                    }
+                                                else {
+                                                    if (sim_con_stable_registers && 
+                                                        sim_rem_master_mode) {  /* can we process command now? */
+                                                        sim_debug (DBG_CMD, &sim_remote_console, "Processing Command directly\n");
+                                                        sim_oline = lp;         /* specify output socket */
+                                                        if ((cmdp->action == &x_bexamine_cmd) ||
+                                                            (cmdp->action == &x_bdeposit_cmd)) {
+                                                            if (cmdp->action == &x_bexamine_cmd)
+                                                                stat = sim_rem_bexamine (rem, cptr);
+                                                            else
+                                                                stat = sim_rem_bdeposit (rem, cptr);
+                                                            sim_last_cmd_stat = SCPE_BARE_STATUS(stat);
+                                                            }
+                                                        else {
+                                                            sim_remote_process_command ();
+                                                            stat = sim_last_cmd_stat|SCPE_NOMESSAGE;/* any message has already been emitted */
+                                                            }
+                                                        }
+                                                    else {
+                                                        sim_debug (DBG_CMD, &sim_remote_console, "Processing Command via SCPE_REMOTE\n");
+                                                        stat = SCPE_REMOTE;     /* force processing outside of sim_instr() */
+                                                        }
+                                                    }
                                                 }
                                             }
                                         }
@@ -1757,6 +2668,9 @@ for (i=(was_active_command ? sim_rem_cmd_active_line : 0);
         if ((stat != SCPE_OK) && (stat != SCPE_REMOTE))
             stat = _sim_rem_message (gbuf, stat);
         _sim_rem_log_out (lp);
+        if ((stat != SCPE_REMOTE) &&
+            !(cmdp && (cmdp->action == &x_step_cmd)))   /* completed now? */
+            sim_rem_pipeline_status (rem, stat);
         if (master_session && !sim_rem_master_mode) {
             rem->single_mode = TRUE;
             return SCPE_STOP;
@@ -2374,7 +3288,7 @@ return SCPE_OK;
 
 t_stat sim_set_telnet (int32 flag, CONST char *cptr)
 {
-char *cvptr, gbuf[CBUFSIZE];
+char *cvptr, gbuf[CBUFSIZE], ubuf[CBUFSIZE];
 CTAB *ctptr;
 t_stat r;
 
@@ -2384,8 +3298,8 @@ while (*cptr != 0) {                                    /* do all mods */
     cptr = get_glyph_nc (cptr, gbuf, ',');              /* get modifier */
     if ((cvptr = strchr (gbuf, '=')))                   /* = value? */
         *cvptr++ = 0;
-    get_glyph (gbuf, gbuf, 0);                          /* modifier to UC */
-    if ((ctptr = find_ctab (set_con_telnet_tab, gbuf))) { /* match? */
+    get_glyph (gbuf, ubuf, 0);                          /* modifier to UC (port keeps case for unix:path) */
+    if ((ctptr = find_ctab (set_con_telnet_tab, ubuf))) { /* match? */
         r = ctptr->action (ctptr->arg, cvptr);          /* do the rest */
         if (r != SCPE_OK)
             return r;
@@ -2781,6 +3695,7 @@ t_stat sim_poll_kbd (void)
 {
 t_stat c;
 
+sim_putchar_flush ();                                   /* write output batched since the last poll */
 if (sim_send_poll_data (&sim_con_send, &c))                 /* injected input characters available? */
     return c;
 if (!sim_rem_master_mode) {
@@ -2819,39 +3734,82 @@ if ((c = (t_stat)tmxr_getc_ln (&sim_con_ldsc)))             /* any char? */
 return SCPE_OK;
 }
 
-/* Output character */
+/* Output character
 
-t_stat sim_putchar (int32 c)
+   While the simulator is running, console output is batched: it is 
+   collected in sim_con_obuf (or, for a Telnet or serial console, left 
+   in the line's transmit buffer) and handed to the host in a single 
+   write when the buffer fills, at the next keyboard poll (once per 
+   simulated clock tick), when SCP prints a message or when the 
+   simulator stops.  The console log is written at the same time.  
+   Expect rules still examine each character as it's output, so the 
+   timing of matches doesn't change.
+
+   Output is written a character at a time when the simulator isn't 
+   running, while debug output is being produced (so traces stay 
+   interleaved with the console output), on rate limited or serial 
+   console lines and after SET CONSOLE NOBATCH.
+*/
+
+#define CON_OBUF_SIZE   4096                            /* batched output buffer size */
+
+static char sim_con_obuf[CON_OBUF_SIZE];                /* batched output (not Telnet or serial) */
+static size_t sim_con_obuf_cnt = 0;                     /* characters in sim_con_obuf */
+static t_bool sim_con_batch = TRUE;                     /* batch output while running */
+static t_uint64 sim_con_out_chars = 0;                  /* characters output */
+static t_uint64 sim_con_out_writes = 0;                 /* host writes */
+static t_uint64 sim_con_run_msecs = 0;                  /* time spent running */
+static uint32 sim_con_run_start = 0;                    /* start time of the current run */
+static t_bool sim_con_run_timing = FALSE;               /* sim_con_run_start valid */
+
+t_stat sim_putchar_flush (void)
 {
-sim_exp_check (&sim_con_expect, c);
-if ((sim_con_tmxr.master == 0) &&                       /* not Telnet? */
-    (sim_con_ldsc.serport == 0)) {                      /* and not serial port */
+t_stat r = SCPE_OK;
+
+if (sim_con_obuf_cnt) {                                 /* batched window output? */
     if (sim_log)                                        /* log file? */
-        fputc (c, sim_log);
-    sim_debug (DBG_XMT, &sim_con_telnet, "sim_putchar('%c' (0x%02X)\n", sim_isprint (c) ? c : '.', c);
-    return sim_os_putchar (c);                          /* in-window version */
+        fwrite (sim_con_obuf, 1, sim_con_obuf_cnt, sim_log);
+    r = sim_os_putbuf (sim_con_obuf, sim_con_obuf_cnt);
+    sim_con_obuf_cnt = 0;
+    ++sim_con_out_writes;
     }
-if (!sim_con_ldsc.conn) {                               /* no Telnet or serial connection? */
-    if (!sim_con_ldsc.txbfd)                            /* unbuffered? */
-        return SCPE_LOST;                               /* connection lost */
-    if (tmxr_poll_conn (&sim_con_tmxr) >= 0)            /* poll connect */
-        sim_con_ldsc.rcve = 1;                          /* rcv enabled */
+if (sim_con_ldsc.conn && tmxr_tqln (&sim_con_ldsc)) {   /* pending Telnet or serial output? */
+    tmxr_poll_tx (&sim_con_tmxr);                       /* poll xmt */
+    ++sim_con_out_writes;
     }
-tmxr_putc_ln (&sim_con_ldsc, c);                        /* output char */
-tmxr_poll_tx (&sim_con_tmxr);                           /* poll xmt */
-return SCPE_OK;
+return r;
+}
+
+t_stat sim_putchar (int32 c)
+{
+t_stat r = sim_putchar_s (c);
+
+if ((r == SCPE_STALL) ||                                /* stalled characters are dropped */
+    ((r == SCPE_LOST) && sim_con_ldsc.txbfd))           /* as is output for an unconnected buffered line */
+    return SCPE_OK;
+return r;
 }
 
 t_stat sim_putchar_s (int32 c)
 {
 t_stat r;
+t_bool batch = (sim_con_batch && sim_is_running && !sim_deb);
 
 sim_exp_check (&sim_con_expect, c);
+++sim_con_out_chars;
 if ((sim_con_tmxr.master == 0) &&                       /* not Telnet? */
     (sim_con_ldsc.serport == 0)) {                      /* and not serial port */
+    if (batch) {                                        /* batching output? */
+        sim_con_obuf[sim_con_obuf_cnt++] = (char)c;
+        if (sim_con_obuf_cnt == sizeof (sim_con_obuf))  /* full? */
+            return sim_putchar_flush ();
+        return SCPE_OK;
+        }
+    sim_putchar_flush ();                               /* keep output in order */
     if (sim_log)                                        /* log file? */
         fputc (c, sim_log);
     sim_debug (DBG_XMT, &sim_con_telnet, "sim_putchar('%c' (0x%02X)\n", sim_isprint (c) ? c : '.', c);
+    ++sim_con_out_writes;
     return sim_os_putchar (c);                          /* in-window version */
     }
 if (!sim_con_ldsc.conn) {                               /* no Telnet or serial connection? */
@@ -2861,10 +3819,50 @@ if (!sim_con_ldsc.conn) {                               /* no Telnet or serial c
         sim_con_ldsc.rcve = 1;                          /* rcv enabled */
     }
 r = tmxr_putc_ln (&sim_con_ldsc, c);                    /* Telnet output */
-tmxr_poll_tx (&sim_con_tmxr);                           /* poll xmt */
+if ((!batch) ||                                         /* not batching */
+    (sim_con_ldsc.serport) ||                           /* OR serial port */
+    (sim_con_ldsc.txbps) ||                             /* OR rate limited */
+    (r == SCPE_STALL) ||                                /* OR buffer full */
+    (!sim_con_ldsc.xmte) ||                             /* OR nearly full */
+    ((sim_con_ldsc.txbfd) &&                            /* OR buffered */
+     (tmxr_tqln (&sim_con_ldsc) >= sim_con_ldsc.txbsz / 2))) {/*  and half full? */
+    tmxr_poll_tx (&sim_con_tmxr);                       /* poll xmt */
+    if (sim_con_ldsc.conn)
+        ++sim_con_out_writes;
+    }
 return r;                                               /* return status */
 }
 
+/* Set console output batching */
+
+t_stat sim_set_cons_batch (int32 flg, CONST char *cptr)
+{
+if (cptr && (*cptr != 0))
+    return SCPE_2MARG;
+sim_putchar_flush ();
+sim_con_batch = (flg != 0);
+return SCPE_OK;
+}
+
+t_stat sim_show_cons_output (FILE *st, DEVICE *dunused, UNIT *uunused, int32 flag, CONST char *cptr)
+{
+t_uint64 msecs = sim_con_run_msecs;
+
+if (cptr && (*cptr != 0))
+    return SCPE_2MARG;
+if (sim_con_run_timing)
+    msecs += sim_os_msec () - sim_con_run_start;
+fprintf (st, "Output %s\n", sim_con_batch ? "batched while running" : "not batched");
+if (sim_con_out_chars == 0)
+    return SCPE_OK;
+fprintf (st, "  %s characters", sim_fmt_numeric ((double)sim_con_out_chars));
+fprintf (st, " in %s host writes", sim_fmt_numeric ((double)sim_con_out_writes));
+fprintf (st, " (%.1f characters per write)\n", (double)sim_con_out_chars / (double)(sim_con_out_writes ? sim_con_out_writes : 1));
+if (msecs)
+    fprintf (st, "  %s characters per second while running\n", sim_fmt_numeric (((double)sim_con_out_chars * 1000.0) / (double)msecs));
+return SCPE_OK;
+}
+
 /* Input character processing */
 
 int32 sim_tt_inpcvt (int32 c, uint32 mode)
@@ -3094,11 +4092,18 @@ if (sim_asynch_enabled) {
 pthread_mutex_unlock (&sim_tmxr_poll_lock);
 #endif
 tmxr_start_poll ();
+sim_con_run_start = sim_os_msec ();                     /* start timing console output */
+sim_con_run_timing = TRUE;
 return sim_os_ttrun ();
 }
 
 t_stat sim_ttcmd (void)
 {
+sim_putchar_flush ();                                   /* write batched output in run mode */
+if (sim_con_run_timing) {
+    sim_con_run_msecs += sim_os_msec () - sim_con_run_start;
+    sim_con_run_timing = FALSE;
+    }
 #if defined(SIM_ASYNCH_IO) && defined(SIM_ASYNCH_MUX)
 pthread_mutex_lock (&sim_tmxr_poll_lock);
 if (sim_console_poll_running) {
@@ -3924,6 +4929,24 @@ write (1, &c, 1);
 return SCPE_OK;
 }
 
+#define SIM_OS_PUTBUF
+
+static t_stat sim_os_putbuf (const char *buf, size_t len)
+{
+while (len > 0) {
+    ssize_t written = write (1, buf, len);
+
+    if (written < 0) {
+        if (errno == EINTR)
+            continue;
+        return SCPE_TTOERR;
+        }
+    buf += written;
+    len -= (size_t)written;
+    }
+return SCPE_OK;
+}
+
 /* POSIX UNIX routines, from Leendert Van Doorn */
 
 #else
@@ -4053,6 +5076,37 @@ c = out;
 return SCPE_OK;
 }
 
+#define SIM_OS_PUTBUF
+
+static t_stat sim_os_putbuf (const char *buf, size_t len)
+{
+while (len > 0) {
+    ssize_t written = write (1, buf, len);
+
+    if (written < 0) {
+        if (errno == EINTR)
+            continue;
+        return SCPE_TTOERR;
+        }
+    buf += written;
+    len -= (size_t)written;
+    }
+return SCPE_OK;
+}
+
+#endif
+
+#if !defined (SIM_OS_PUTBUF)
+/* Platforms without a block write output each character in turn */
+
+static t_stat sim_os_putbuf (const char *buf, size_t len)
+{
+t_stat r = SCPE_OK;
+
+while ((r == SCPE_OK) && (len-- > 0))
+    r = sim_os_putchar ((uint8)*buf++);
+return r;
+}
 #endif
 
 /* Decode a string.
@@ -73,6 +73,7 @@ extern "C" {
 
 t_stat sim_set_console (int32 flag, CONST char *cptr);
 t_stat sim_set_remote_console (int32 flag, CONST char *cptr);
+t_stat sim_export_cmd (int32 flag, CONST char *cptr);
 void sim_remote_process_command (void);
 t_stat sim_set_kmap (int32 flag, CONST char *cptr);
 t_stat sim_set_telnet (int32 flag, CONST char *cptr);
@@ -87,6 +88,7 @@ t_stat sim_set_cons_buff (int32 flg, CONST char *cptr);
 t_stat sim_set_cons_unbuff (int32 flg, CONST char *cptr);
 t_stat sim_set_cons_log (int32 flg, CONST char *cptr);
 t_stat sim_set_cons_nolog (int32 flg, CONST char *cptr);
+t_stat sim_set_cons_batch (int32 flg, CONST char *cptr);
 t_stat sim_set_deboff (int32 flag, CONST char *cptr);
 t_stat sim_set_cons_expect (int32 flg, CONST char *cptr);
 t_stat sim_set_cons_noexpect (int32 flg, CONST char *cptr);
@@ -95,6 +97,7 @@ t_stat sim_set_pchar (int32 flag, CONST char *cptr);
 t_stat sim_set_cons_speed (int32 flag, CONST char *cptr);
 t_stat sim_show_console (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_remote_console (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
+t_stat sim_show_export (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_kmap (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_telnet (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_log (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
@@ -103,6 +106,7 @@ t_stat sim_show_pchar (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST cha
 t_stat sim_show_cons_speed (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_cons_buff (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_cons_log (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
+t_stat sim_show_cons_output (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_cons_debug (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_cons_expect (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_check_console (int32 sec);
@@ -117,6 +121,7 @@ t_stat sim_set_stable_registers_state (void);
 t_stat sim_poll_kbd (void);
 t_stat sim_putchar (int32 c);
 t_stat sim_putchar_s (int32 c);
+t_stat sim_putchar_flush (void);
 t_stat sim_ttinit (void);
 t_stat sim_ttrun (void);
 t_stat sim_ttcmd (void);
@@ -1244,6 +1244,7 @@ extern int32 sim_asynch_inst_latency;
       if (sim_idle_wait) {                                             \
         sim_debug (TIMER_DBG_IDLE, &sim_timer_dev, "waking due to event on %s after %d instructions\n", sim_uname(uptr), event_time);\
         pthread_cond_signal (&sim_asynch_wake);                        \
+        sim_idle_wake ();                                              \
         }                                                              \
       AIO_UNLOCK;                                                      \
       sim_asynch_check = 0;                                            \
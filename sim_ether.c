@@ -493,6 +493,62 @@ t_stat eth_mac_scan_ex (ETH_MAC* mac, const char* strmac, UNIT *uptr)
   return SCPE_OK;
 }
 
+/* Scan a SET <dev> COALESCE argument: DISABLED, OFF or PACKETS=n{;TIME=usecs}
+
+   packets and time hold the current settings on entry and are only
+   updated when the whole argument is valid.  The argument is expected
+   to have already been upcased.
+*/
+t_stat eth_coalesce_scan (uint32* packets, uint32* time, const char* cptr)
+{
+  char tbuf[CBUFSIZE], gbuf[CBUFSIZE];
+  const char *tptr = cptr;
+  uint32 newval;
+  uint32 set_packets = *packets;
+  uint32 set_time = *time;
+  t_bool time_given = FALSE;
+  t_stat r = SCPE_OK;
+
+  if (!cptr)
+    return SCPE_ARG;
+
+  if ((!strcmp (cptr, "OFF")) ||
+      (!strcmp (cptr, "DISABLED")))
+    set_packets = 0;
+  else {
+    if (set_time == 0)
+      set_time = ETH_COAL_DEFAULT_TIME;
+    while (*tptr) {
+      tptr = get_glyph_nc (tptr, tbuf, ';');
+      cptr = tbuf;
+      cptr = get_glyph (cptr, gbuf, '=');
+      if ((NULL == cptr) || ('\0' == *cptr))
+        return SCPE_ARG;
+      if (!MATCH_CMD(gbuf, "PACKETS")) {
+        newval = (uint32)get_uint (cptr, 10, ETH_COAL_MAX_PACKETS, &r);
+        if (r != SCPE_OK)
+          return SCPE_ARG;
+        set_packets = newval;
+        }
+      else
+        if (!MATCH_CMD(gbuf, "TIME")) {
+          newval = (uint32)get_uint (cptr, 10, 100000, &r);
+          if ((r != SCPE_OK) || (newval == 0))
+            return SCPE_ARG;
+          set_time = newval;
+          time_given = TRUE;
+          }
+        else
+          return SCPE_ARG;
+      }
+    if (time_given && (set_packets <= 1))
+      return sim_messagef (SCPE_ARG, "COALESCE TIME=n also requires PACKETS=n, with n greater than 1\n");
+    }
+  *packets = set_packets;
+  *time = set_time;
+  return SCPE_OK;
+}
+
 void eth_mac_fmt(ETH_MAC* const mac, char* buff)
 {
   const uint8* m = (const uint8*) mac;
@@ -948,6 +1004,16 @@ t_stat eth_check_address_conflict (ETH_DEV* dev,
   {return SCPE_NOFNC;}
 t_stat eth_set_throttle (ETH_DEV* dev, uint32 time, uint32 burst, uint32 delay)
   {return SCPE_NOFNC;}
+t_stat eth_set_capture (ETH_DEV* dev, const char* cptr)
+  {return SCPE_NOFNC;}
+t_stat eth_show_capture (FILE* st, ETH_DEV* dev)
+  {return SCPE_NOFNC;}
+t_stat eth_set_coalesce (ETH_DEV* dev, uint32 packets, uint32 time)
+  {return SCPE_NOFNC;}
+t_bool eth_coalesce_hold (ETH_DEV* dev, int queued, UNIT* uptr)
+  {return FALSE;}
+void eth_coalesce_batch (ETH_DEV* dev, int delivered, int remaining)
+  {}
 t_stat eth_set_async (ETH_DEV *dev, int latency)
   {return SCPE_NOFNC;}
 t_stat eth_clr_async (ETH_DEV *dev)
@@ -989,6 +1055,9 @@ const char *eth_capabilities(void)
 #endif
 #if defined (HAVE_SLIRP_NETWORK)
      ":NAT"
+#endif
+#if defined (HAVE_VSW_NETWORK)
+     ":VSW"
 #endif
      ":UDP";
  }
@@ -1681,6 +1750,641 @@ return 0;
 }
 #endif
 
+#ifdef HAVE_VSW_NETWORK
+/*============================================================================*/
+/*                    Integrated Virtual Switch (vsw:)                        */
+/*                                                                            */
+/*  Simulators running on the same host attach to a named POSIX shared       */
+/*  memory segment which holds a fixed set of switch ports.  Each port owns   */
+/*  a bounded multi-producer/single-consumer ring of frame slots.  A sender   */
+/*  learns its source MAC address into a shared forwarding table and then    */
+/*  copies the frame directly into the receive ring of the learned           */
+/*  destination port, or into every other port's ring for multicast,         */
+/*  broadcast and not yet learned destinations.  No locks are used: each     */
+/*  ring slot carries a sequence number which orders producer and consumer   */
+/*  access to it.  Receiving ports do their own address filtering, just as   */
+/*  with the tap, vde and udp transports.                                    */
+/*                                                                            */
+/*  A port's reader only sleeps when its ring is empty.  Before sleeping it   */
+/*  advertises that in the port, and a sender which notices rings the        */
+/*  port's loopback UDP doorbell to wake it up.  While frames are flowing    */
+/*  no system calls are made to move them.                                   */
+/*============================================================================*/
+
+#include <signal.h>
+
+#define VSW_MAGIC       0x56535753                      /* "VSWS" */
+#define VSW_MAGIC_INIT  0x56535749                      /* "VSWI" segment being initialized */
+#define VSW_VERSION     1
+#define VSW_PORTS       32                              /* ports per switch */
+#define VSW_RING_SLOTS  256                             /* frames per port ring (power of 2) */
+#define VSW_FDB_SIZE    1024                            /* forwarding table entries (power of 2) */
+#define VSW_OPEN_WAIT   2000                            /* ms to wait for a new segment to be set up */
+
+typedef struct {
+    volatile uint32 seq;                                /* slot sequence number */
+    uint32          len;                                /* frame length */
+    uint8           msg[ETH_MAX_PACKET];                /* frame data */
+    } VSW_SLOT;
+
+typedef struct {
+    volatile uint32 owner;                              /* pid of attached simulator (0 = free) */
+    volatile uint32 doorbell;                           /* loopback UDP port of the reader's doorbell */
+    volatile uint32 sleeping;                           /* reader is waiting on its doorbell */
+    volatile uint32 head;                               /* next slot to be reserved by a producer */
+    volatile uint32 tail;                               /* next slot to be consumed by the reader */
+    volatile uint32 dropped;                            /* frames dropped due to a full ring */
+    VSW_SLOT        slot[VSW_RING_SLOTS];
+    } VSW_PORT;
+
+typedef struct {
+    volatile uint32 magic;                              /* VSW_MAGIC once initialized */
+    uint32          version;
+    uint32          ports;
+    uint32          ring_slots;
+    volatile t_uint64 fdb[VSW_FDB_SIZE];                /* MAC address << 16 | (port + 1) */
+    VSW_PORT        port[VSW_PORTS];
+    } VSW_SEGMENT;
+
+typedef struct {
+    SHMEM           *shmem;                             /* shared memory object */
+    VSW_SEGMENT     *seg;                               /* mapped switch segment */
+    char            switch_name[CBUFSIZE];              /* switch name */
+    char            shm_name[CBUFSIZE];                 /* shared memory object name */
+    int             port;                               /* switch port we own */
+    SOCKET          doorbell;                           /* our doorbell (also used to ring others) */
+    uint32          forwarded;                          /* frames sent to a learned port */
+    uint32          flooded;                            /* frames sent to all ports */
+    uint32          doorbells;                          /* doorbells rung */
+    } VSW;
+
+static t_uint64 _eth_vsw_mac (const uint8 *mac)
+{
+return ((t_uint64)mac[0] << 40) | ((t_uint64)mac[1] << 32) | ((t_uint64)mac[2] << 24) |
+       ((t_uint64)mac[3] << 16) | ((t_uint64)mac[4] << 8)  | (t_uint64)mac[5];
+}
+
+static uint32 _eth_vsw_hash (t_uint64 mac)
+{
+return (uint32)((mac ^ (mac >> 13) ^ (mac >> 29)) & (VSW_FDB_SIZE - 1));
+}
+
+static int _eth_vsw_owner_alive (uint32 owner)
+{
+if (owner == 0)
+    return FALSE;
+return !((kill ((pid_t)owner, 0) != 0) && (errno == ESRCH));
+}
+
+static void _eth_vsw_close (VSW *vsw)
+{
+if (!vsw)
+    return;
+if (vsw->seg && (vsw->port >= 0)) {
+    vsw->seg->port[vsw->port].doorbell = 0;
+    __sync_synchronize ();
+    vsw->seg->port[vsw->port].owner = 0;
+    }
+sim_shmem_close (vsw->shmem);
+if (vsw->doorbell != INVALID_SOCKET)
+    close (vsw->doorbell);
+free (vsw);
+}
+
+static VSW *_eth_vsw_open (const char *switch_name, char *errbuf)
+{
+VSW *vsw;
+VSW_SEGMENT *seg;
+VSW_PORT *p;
+struct sockaddr_in sin;
+socklen_t sinlen = sizeof (sin);
+uint32 pid = (uint32)getpid ();
+int i, waited;
+t_stat r;
+const char *cptr;
+
+if (!*switch_name) {
+    strncpy (errbuf, "Must specify a virtual switch name (i.e. vsw:lan1)", PCAP_ERRBUF_SIZE-1);
+    return NULL;
+    }
+for (cptr = switch_name; *cptr; cptr++)
+    if (!isalnum (*cptr) && !strchr ("-_.", *cptr)) {
+        strncpy (errbuf, "Invalid character in virtual switch name", PCAP_ERRBUF_SIZE-1);
+        return NULL;
+        }
+vsw = (VSW *)calloc (1, sizeof (*vsw));
+if (vsw == NULL) {
+    strncpy (errbuf, "Out of memory", PCAP_ERRBUF_SIZE-1);
+    return NULL;
+    }
+vsw->doorbell = INVALID_SOCKET;
+vsw->port = -1;
+strncpy (vsw->switch_name, switch_name, sizeof (vsw->switch_name) - 1);
+snprintf (vsw->shm_name, sizeof (vsw->shm_name), "/simh-vsw-%s", switch_name);
+/* A simulator which is concurrently creating the segment may not have sized it yet */
+for (waited = 0; SCPE_OK != (r = sim_shmem_open (vsw->shm_name, sizeof (*seg), &vsw->shmem, (void **)&seg)); waited += 10) {
+    if ((r != SCPE_OPENERR) || (waited >= VSW_OPEN_WAIT)) {
+        strncpy (errbuf, "Can't create or attach to the virtual switch shared memory segment", PCAP_ERRBUF_SIZE-1);
+        free (vsw);
+        return NULL;
+        }
+    sim_os_ms_sleep (10);
+    }
+vsw->seg = seg;
+/* Whoever first finds the (zero filled) segment uninitialized initializes it */
+if (__sync_bool_compare_and_swap (&seg->magic, 0, VSW_MAGIC_INIT)) {
+    seg->version = VSW_VERSION;
+    seg->ports = VSW_PORTS;
+    seg->ring_slots = VSW_RING_SLOTS;
+    for (i = 0; i < VSW_PORTS; i++) {
+        uint32 s;
+
+        for (s = 0; s < VSW_RING_SLOTS; s++)
+            seg->port[i].slot[s].seq = s;
+        }
+    __sync_synchronize ();
+    seg->magic = VSW_MAGIC;
+    }
+for (waited = 0; (seg->magic != VSW_MAGIC) && (waited < VSW_OPEN_WAIT); waited += 10)
+    sim_os_ms_sleep (10);
+__sync_synchronize ();
+if ((seg->magic != VSW_MAGIC) ||
+    (seg->version != VSW_VERSION) ||
+    (seg->ports != VSW_PORTS) ||
+    (seg->ring_slots != VSW_RING_SLOTS)) {
+    strncpy (errbuf, "Incompatible or uninitialized virtual switch segment", PCAP_ERRBUF_SIZE-1);
+    _eth_vsw_close (vsw);
+    return NULL;
+    }
+/* Claim a free port, or one whose owner has gone away */
+for (i = 0; i < VSW_PORTS; i++) {
+    uint32 owner = seg->port[i].owner;
+
+    if (_eth_vsw_owner_alive (owner))
+        continue;
+    if (__sync_bool_compare_and_swap (&seg->port[i].owner, owner, pid)) {
+        vsw->port = i;
+        break;
+        }
+    }
+if (vsw->port < 0) {
+    strncpy (errbuf, "No free virtual switch ports", PCAP_ERRBUF_SIZE-1);
+    _eth_vsw_close (vsw);
+    return NULL;
+    }
+p = &seg->port[vsw->port];
+/* Discard anything left over from a previous owner of this port */
+while (p->slot[p->tail & (VSW_RING_SLOTS - 1)].seq == p->tail + 1) {
+    p->slot[p->tail & (VSW_RING_SLOTS - 1)].seq = p->tail + VSW_RING_SLOTS;
+    ++p->tail;
+    }
+p->dropped = 0;
+p->sleeping = 0;
+for (i = 0; i < VSW_FDB_SIZE; i++) {
+    t_uint64 ent = seg->fdb[i];
+
+    if ((ent & 0xFFFF) == (t_uint64)(vsw->port + 1))
+        __sync_bool_compare_and_swap (&seg->fdb[i], ent, 0);
+    }
+/* Set up the doorbell other ports ring when they've queued frames for us */
+vsw->doorbell = socket (AF_INET, SOCK_DGRAM, 0);
+memset (&sin, 0, sizeof (sin));
+sin.sin_family = AF_INET;
+sin.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+sin.sin_port = 0;
+if ((vsw->doorbell == INVALID_SOCKET) ||
+    bind (vsw->doorbell, (struct sockaddr *)&sin, sizeof (sin)) ||
+    getsockname (vsw->doorbell, (struct sockaddr *)&sin, &sinlen) ||
+    (fcntl (vsw->doorbell, F_SETFL, fcntl (vsw->doorbell, F_GETFL, 0) | O_NONBLOCK) == -1)) {
+    strncpy (errbuf, strerror (errno), PCAP_ERRBUF_SIZE-1);
+    _eth_vsw_close (vsw);
+    return NULL;
+    }
+p->doorbell = ntohs (sin.sin_port);
+return vsw;
+}
+
+static void _eth_vsw_ring_doorbell (VSW *vsw, VSW_PORT *p)
+{
+struct sockaddr_in sin;
+uint32 doorbell = p->doorbell;
+
+if (doorbell == 0)
+    return;
+memset (&sin, 0, sizeof (sin));
+sin.sin_family = AF_INET;
+sin.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+sin.sin_port = htons ((uint16)doorbell);
+(void)sendto (vsw->doorbell, "", 1, 0, (struct sockaddr *)&sin, sizeof (sin));
+++vsw->doorbells;
+}
+
+static void _eth_vsw_enqueue (VSW *vsw, VSW_PORT *p, const uint8 *msg, uint32 len)
+{
+uint32 pos = p->head;
+VSW_SLOT *slot;
+
+while (1) {
+    int32 diff;
+
+    slot = &p->slot[pos & (VSW_RING_SLOTS - 1)];
+    diff = (int32)(slot->seq - pos);
+    if (diff == 0) {
+        if (__sync_bool_compare_and_swap (&p->head, pos, pos + 1))
+            break;
+        }
+    else {
+        if (diff < 0) {                                 /* ring is full */
+            __sync_fetch_and_add (&p->dropped, 1);
+            return;
+            }
+        }
+    pos = p->head;
+    }
+slot->len = len;
+memcpy (slot->msg, msg, len);
+__sync_synchronize ();
+slot->seq = pos + 1;                                    /* publish */
+__sync_synchronize ();
+if (p->sleeping)
+    _eth_vsw_ring_doorbell (vsw, p);
+}
+
+static int _eth_vsw_send (VSW *vsw, const uint8 *msg, uint32 len)
+{
+VSW_SEGMENT *seg = vsw->seg;
+t_uint64 src = _eth_vsw_mac (msg + 6);
+t_uint64 dst = _eth_vsw_mac (msg);
+t_uint64 ent;
+int i, port = -1;
+
+if (!(msg[6] & 1)) {                                    /* learn unicast source addresses */
+    ent = (src << 16) | (t_uint64)(vsw->port + 1);
+    if (seg->fdb[_eth_vsw_hash (src)] != ent)
+        seg->fdb[_eth_vsw_hash (src)] = ent;
+    }
+if (!(msg[0] & 1)) {                                    /* known unicast destination? */
+    ent = seg->fdb[_eth_vsw_hash (dst)];
+    if ((ent >> 16) == dst)
+        port = (int)(ent & 0xFFFF) - 1;
+    }
+if ((port >= 0) && (port != vsw->port) && (seg->port[port].owner != 0)) {
+    _eth_vsw_enqueue (vsw, &seg->port[port], msg, len);
+    ++vsw->forwarded;
+    return 0;
+    }
+for (i = 0; i < VSW_PORTS; i++)                         /* flood */
+    if ((i != vsw->port) && (seg->port[i].owner != 0))
+        _eth_vsw_enqueue (vsw, &seg->port[i], msg, len);
+++vsw->flooded;
+return 0;
+}
+
+static int _eth_vsw_recv (VSW *vsw, uint8 *buf, size_t size)
+{
+VSW_PORT *p = &vsw->seg->port[vsw->port];
+uint32 tail = p->tail;
+VSW_SLOT *slot = &p->slot[tail & (VSW_RING_SLOTS - 1)];
+uint32 len;
+
+if (slot->seq != tail + 1)                              /* nothing ready */
+    return 0;
+__sync_synchronize ();
+len = slot->len;
+if (len > size)
+    len = (uint32)size;
+memcpy (buf, slot->msg, len);
+__sync_synchronize ();
+slot->seq = tail + VSW_RING_SLOTS;                      /* give slot back to producers */
+p->tail = tail + 1;
+return (int)len;
+}
+
+static int _eth_vsw_select (VSW *vsw, int ms_timeout)
+{
+VSW_PORT *p = &vsw->seg->port[vsw->port];
+int ret = 1;
+
+p->sleeping = 1;
+__sync_synchronize ();
+if (p->slot[p->tail & (VSW_RING_SLOTS - 1)].seq != p->tail + 1) {
+    fd_set rfds;
+    struct timeval timeout;
+
+    FD_ZERO (&rfds);
+    FD_SET (vsw->doorbell, &rfds);
+    timeout.tv_sec = ms_timeout / 1000;
+    timeout.tv_usec = (ms_timeout % 1000) * 1000;
+    ret = select (1 + vsw->doorbell, &rfds, NULL, NULL, &timeout);
+    }
+p->sleeping = 0;
+if (ret > 0) {
+    char buf[32];
+
+    /* consume the doorbell wakeup rings */
+    while (recv (vsw->doorbell, buf, sizeof (buf), 0) > 0)
+        ;
+    }
+return ret;
+}
+
+static void _eth_vsw_show (VSW *vsw, FILE *st)
+{
+int i, attached = 0;
+
+for (i = 0; i < VSW_PORTS; i++)
+    if (vsw->seg->port[i].owner != 0)
+        ++attached;
+fprintf(st, "  Virtual Switch:          %s\n", vsw->switch_name);
+fprintf(st, "  Switch Port:             %d of %d (%d attached)\n", vsw->port, VSW_PORTS, attached);
+fprintf(st, "  Frames Forwarded:        %u\n", vsw->forwarded);
+fprintf(st, "  Frames Flooded:          %u\n", vsw->flooded);
+fprintf(st, "  Doorbells Rung:          %u\n", vsw->doorbells);
+if (vsw->seg->port[vsw->port].dropped)
+    fprintf(st, "  Receive Ring Overruns:   %u\n", vsw->seg->port[vsw->port].dropped);
+}
+#endif /* HAVE_VSW_NETWORK */
+
+#if defined (USE_READER_THREAD)
+/* Packet capture
+
+   Frames sent and received on an ETH_DEV can be captured to a pcapng
+   file.  The transmit (writer thread) and receive (reader thread) paths
+   each do no more than timestamp and copy the frame into a ring of
+   fixed size slots.  A capture thread drains the ring and formats the
+   pcapng blocks, so the simulator never waits on file I/O.  When the
+   ring is full, frames are counted as dropped rather than delaying
+   the simulation.
+*/
+
+#define ETH_CAP_DEFAULT_RING    1024                    /* slots in capture ring */
+#define ETH_CAP_MAX_RING        65536
+
+#define PCAPNG_SHB              0x0A0D0D0A              /* Section Header Block */
+#define PCAPNG_IDB              0x00000001              /* Interface Description Block */
+#define PCAPNG_EPB              0x00000006              /* Enhanced Packet Block */
+#define PCAPNG_MAGIC            0x1A2B3C4D              /* byte-order magic */
+#define PCAPNG_LINKTYPE_EN10MB  1
+#define PCAPNG_OPT_IF_NAME      2
+#define PCAPNG_OPT_EPB_FLAGS    2
+#define PCAPNG_FLAG_INBOUND     1
+#define PCAPNG_FLAG_OUTBOUND    2
+
+typedef struct eth_capture_slot {
+    uint32          len;                                /* original frame length */
+    uint32          caplen;                             /* bytes captured */
+    uint32          flags;                              /* direction */
+    uint32          ts_high;                            /* usecs since epoch */
+    uint32          ts_low;
+    uint8           msg[1];                             /* snaplen bytes follow */
+    } ETH_CAPTURE_SLOT;
+
+typedef struct eth_capture ETH_CAPTURE;
+
+struct eth_capture {
+    FILE            *file;
+    char            *filename;
+    uint32          snaplen;
+    uint32          ring_size;
+    size_t          slot_size;
+    uint8           *ring;
+    uint32          head;                               /* next slot to fill */
+    uint32          tail;                               /* next slot to write */
+    int             active;                             /* capture in progress */
+    int             closing;                            /* capture thread should exit */
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    uint32          captured;                           /* frames placed in the ring */
+    uint32          dropped;                            /* frames lost to a full ring */
+    uint32          truncated;                          /* frames longer than snaplen */
+    uint32          high;                               /* ring high water mark */
+    t_uint64        bytes;                              /* bytes written to file */
+    };
+
+static void _eth_capture_put16 (uint8 *buf, uint16 val)
+{
+memcpy (buf, &val, sizeof (val));                       /* pcapng is host byte order */
+}
+
+static void _eth_capture_put32 (uint8 *buf, uint32 val)
+{
+memcpy (buf, &val, sizeof (val));
+}
+
+static void _eth_capture_block (ETH_CAPTURE *cap, uint8 *block, uint32 len)
+{
+_eth_capture_put32 (&block[4], len);
+_eth_capture_put32 (&block[len-4], len);
+cap->bytes += fwrite (block, 1, len, cap->file);
+}
+
+static void _eth_capture_header (ETH_CAPTURE *cap, const char *ifname)
+{
+uint8 block[64 + 256];
+uint32 len, name_len = (uint32)strlen (ifname);
+
+if (name_len > 255)
+    name_len = 255;
+/* Section Header Block */
+memset (block, 0, sizeof (block));
+_eth_capture_put32 (&block[0], PCAPNG_SHB);
+_eth_capture_put32 (&block[8], PCAPNG_MAGIC);
+_eth_capture_put16 (&block[12], 1);                     /* major version 1, minor 0 */
+memset (&block[16], 0xFF, 8);                           /* section length unknown */
+_eth_capture_block (cap, block, 28);
+/* Interface Description Block with an if_name option */
+memset (block, 0, sizeof (block));
+_eth_capture_put32 (&block[0], PCAPNG_IDB);
+_eth_capture_put16 (&block[8], PCAPNG_LINKTYPE_EN10MB);
+_eth_capture_put32 (&block[12], cap->snaplen);
+_eth_capture_put16 (&block[16], PCAPNG_OPT_IF_NAME);
+_eth_capture_put16 (&block[18], (uint16)name_len);
+memcpy (&block[20], ifname, name_len);
+len = 20 + ((name_len + 3) & ~3);
+len += 4;                                               /* opt_endofopt */
+_eth_capture_block (cap, block, len + 4);
+}
+
+static void _eth_capture_write (ETH_CAPTURE *cap, ETH_CAPTURE_SLOT *slot)
+{
+uint8 block[28 + ETH_MAX_PACKET + 4 + 16];
+uint32 pad = (slot->caplen + 3) & ~3;
+uint32 len;
+
+memset (block, 0, 28 + pad + 16);
+_eth_capture_put32 (&block[0], PCAPNG_EPB);
+_eth_capture_put32 (&block[8], 0);                      /* interface 0 */
+_eth_capture_put32 (&block[12], slot->ts_high);
+_eth_capture_put32 (&block[16], slot->ts_low);
+_eth_capture_put32 (&block[20], slot->caplen);
+_eth_capture_put32 (&block[24], slot->len);
+memcpy (&block[28], slot->msg, slot->caplen);
+len = 28 + pad;
+_eth_capture_put16 (&block[len], PCAPNG_OPT_EPB_FLAGS); /* epb_flags: direction */
+_eth_capture_put16 (&block[len+2], 4);
+_eth_capture_put32 (&block[len+4], slot->flags);
+len += 8 + 4;                                           /* option + opt_endofopt */
+_eth_capture_block (cap, block, len + 4);
+}
+
+static void *
+_eth_capture_thread (void *arg)
+{
+ETH_CAPTURE *cap = (ETH_CAPTURE *)arg;
+uint32 head, tail;
+
+pthread_mutex_lock (&cap->lock);
+while (1) {
+    while ((cap->head == cap->tail) && !cap->closing)
+        pthread_cond_wait (&cap->cond, &cap->lock);
+    if (cap->head == cap->tail)
+        break;                                          /* closing and drained */
+    head = cap->head;
+    tail = cap->tail;
+    pthread_mutex_unlock (&cap->lock);
+    /* slots between tail and head are ours until tail is advanced */
+    while (tail != head) {
+        _eth_capture_write (cap, (ETH_CAPTURE_SLOT *)(cap->ring + (tail % cap->ring_size) * cap->slot_size));
+        ++tail;
+        }
+    fflush (cap->file);
+    pthread_mutex_lock (&cap->lock);
+    cap->tail = tail;
+    }
+pthread_mutex_unlock (&cap->lock);
+return NULL;
+}
+
+static void _eth_capture (ETH_DEV *dev, const uint8 *msg, uint32 len, uint32 flags)
+{
+ETH_CAPTURE *cap = dev->capture;
+ETH_CAPTURE_SLOT *slot;
+struct timespec now;
+t_uint64 usecs;
+uint32 used;
+
+clock_gettime (CLOCK_REALTIME, &now);
+usecs = ((t_uint64)now.tv_sec) * 1000000 + (now.tv_nsec / 1000);
+pthread_mutex_lock (&cap->lock);
+if (!cap->active) {
+    pthread_mutex_unlock (&cap->lock);
+    return;
+    }
+used = cap->head - cap->tail;
+if (used >= cap->ring_size)
+    ++cap->dropped;
+else {
+    slot = (ETH_CAPTURE_SLOT *)(cap->ring + (cap->head % cap->ring_size) * cap->slot_size);
+    slot->len = len;
+    slot->caplen = (len > cap->snaplen) ? cap->snaplen : len;
+    slot->flags = flags;
+    slot->ts_high = (uint32)(usecs >> 32);
+    slot->ts_low = (uint32)usecs;
+    memcpy (slot->msg, msg, slot->caplen);
+    if (slot->caplen < len)
+        ++cap->truncated;
+    ++cap->captured;
+    ++cap->head;
+    if (++used > cap->high)
+        cap->high = used;
+    if (used == 1)
+        pthread_cond_signal (&cap->cond);
+    }
+pthread_mutex_unlock (&cap->lock);
+}
+
+static void _eth_capture_stop (ETH_DEV *dev)
+{
+ETH_CAPTURE *cap = dev->capture;
+
+if ((!cap) || (!cap->active))
+    return;
+pthread_mutex_lock (&cap->lock);
+cap->active = 0;
+cap->closing = 1;
+pthread_cond_signal (&cap->cond);
+pthread_mutex_unlock (&cap->lock);
+pthread_join (cap->thread, NULL);
+fclose (cap->file);
+cap->file = NULL;
+sim_messagef (SCPE_OK, "Eth: capture to %s closed, %u frames captured, %u dropped\n", cap->filename, cap->captured, cap->dropped);
+}
+
+/* The capture context lives until the device is closed, since the reader
+   and writer threads may be looking at it at any time */
+static void _eth_capture_free (ETH_DEV *dev)
+{
+ETH_CAPTURE *cap = dev->capture;
+
+if (!cap)
+    return;
+_eth_capture_stop (dev);
+dev->capture = NULL;
+pthread_mutex_destroy (&cap->lock);
+pthread_cond_destroy (&cap->cond);
+free (cap->filename);
+free (cap->ring);
+free (cap);
+}
+
+static t_stat _eth_capture_start (ETH_DEV *dev, const char *filename, uint32 snaplen, uint32 ring_size)
+{
+ETH_CAPTURE *cap = dev->capture;
+FILE *file;
+uint8 *ring;
+size_t slot_size = (offsetof (ETH_CAPTURE_SLOT, msg) + snaplen + 7) & ~((size_t)7);
+char ifname[CBUFSIZE];
+pthread_attr_t attr;
+
+_eth_capture_stop (dev);
+ring = (uint8 *)malloc (slot_size * ring_size);
+if (!ring)
+    return SCPE_MEM;
+file = sim_fopen (filename, "wb");
+if (!file) {
+    free (ring);
+    return sim_messagef (SCPE_OPENERR, "Eth: Can't open capture file %s: %s\n", filename, strerror (errno));
+    }
+if (!cap) {
+    cap = (ETH_CAPTURE *)calloc (1, sizeof (*cap));
+    if (!cap) {
+        fclose (file);
+        free (ring);
+        return SCPE_MEM;
+        }
+    pthread_mutex_init (&cap->lock, NULL);
+    pthread_cond_init (&cap->cond, NULL);
+    dev->capture = cap;
+    }
+/* The capture thread isn't running, so only the producers need fencing off */
+pthread_mutex_lock (&cap->lock);
+free (cap->ring);
+free (cap->filename);
+cap->ring = ring;
+cap->filename = (char *)malloc (1 + strlen (filename));
+strcpy (cap->filename, filename);
+cap->file = file;
+cap->snaplen = snaplen;
+cap->ring_size = ring_size;
+cap->slot_size = slot_size;
+cap->head = cap->tail = 0;
+cap->captured = cap->dropped = cap->truncated = cap->high = 0;
+cap->bytes = 0;
+cap->closing = 0;
+snprintf (ifname, sizeof (ifname), "%s %s", dev->dptr ? sim_dname (dev->dptr) : "", dev->name);
+_eth_capture_header (cap, ifname);
+fflush (cap->file);
+pthread_attr_init (&attr);
+pthread_attr_setscope (&attr, PTHREAD_SCOPE_SYSTEM);
+pthread_create (&cap->thread, &attr, _eth_capture_thread, (void *)cap);
+pthread_attr_destroy (&attr);
+cap->active = 1;
+pthread_mutex_unlock (&cap->lock);
+return SCPE_OK;
+}
+#endif /* USE_READER_THREAD */
+
 /* Forward declarations */
 static void
 _eth_callback(u_char* info, const struct pcap_pkthdr* header, const u_char* data);
@@ -1728,6 +2432,7 @@ switch (dev->eth_api) {
   case ETH_API_VDE:
   case ETH_API_UDP:
   case ETH_API_NAT:
+  case ETH_API_VSW:
     do_select = 1;
     select_fd = dev->fd_handle;
     break;
@@ -1755,6 +2460,12 @@ while (dev->handle) {
         sel_ret = sim_slirp_select ((SLIRP*)dev->handle, 250);
         }
       else
+#endif
+#ifdef HAVE_VSW_NETWORK
+      if (dev->eth_api == ETH_API_VSW) {
+        sel_ret = _eth_vsw_select ((VSW*)dev->handle, 250);
+        }
+      else
 #endif
         {
         fd_set setl;
@@ -1834,6 +2545,24 @@ while (dev->handle) {
         status = 1;
         break;
 #endif /* HAVE_SLIRP_NETWORK */
+#ifdef HAVE_VSW_NETWORK
+      case ETH_API_VSW:
+        if (1) {
+          struct pcap_pkthdr header;
+          int len;
+          u_char buf[ETH_MAX_PACKET];
+
+          /* drain everything queued to our switch port */
+          memset(&header, 0, sizeof(header));
+          status = 0;
+          while (dev->handle && ((len = _eth_vsw_recv ((VSW*)dev->handle, buf, sizeof(buf))) > 0)) {
+            status = 1;
+            header.caplen = header.len = len;
+            _eth_callback((u_char *)dev, &header, buf);
+            }
+          }
+        break;
+#endif /* HAVE_VSW_NETWORK */
       case ETH_API_UDP:
         if (1) {
           struct pcap_pkthdr header;
@@ -1982,6 +2711,137 @@ dev->throttle_mask = (1 << dev->throttle_burst) - 1;
 return SCPE_OK;
 }
 
+t_stat eth_set_coalesce (ETH_DEV* dev, uint32 packets, uint32 time)
+{
+if (!dev)
+  return SCPE_IERR;
+if (packets > ETH_COAL_MAX_PACKETS)
+  packets = ETH_COAL_MAX_PACKETS;
+dev->coalesce_packets = packets;
+dev->coalesce_time = time;
+return SCPE_OK;
+}
+
+/* Start or stop capturing a device's traffic to a pcapng file
+
+   cptr is "filename{;SNAPLEN=n}{;RING=n}" or NULL to stop capturing
+*/
+t_stat eth_set_capture (ETH_DEV* dev, const char* cptr)
+{
+#if !defined (USE_READER_THREAD)
+return sim_messagef (SCPE_NOFNC, "Eth: Packet capture requires a threaded network build\n");
+#else
+char fbuf[CBUFSIZE], tbuf[CBUFSIZE], gbuf[CBUFSIZE];
+const char *tptr;
+uint32 snaplen = ETH_MAX_PACKET;
+uint32 ring_size = ETH_CAP_DEFAULT_RING;
+t_stat r;
+
+if ((!dev) || (dev->eth_api == ETH_API_NONE))
+  return SCPE_UNATT;
+if ((!cptr) || (!*cptr)) {
+  _eth_capture_stop (dev);
+  return SCPE_OK;
+  }
+tptr = get_glyph_nc (cptr, fbuf, ';');
+if (!fbuf[0])
+  return SCPE_ARG;
+while (*tptr) {
+  tptr = get_glyph (tptr, tbuf, ';');
+  cptr = get_glyph (tbuf, gbuf, '=');
+  if ((NULL == cptr) || ('\0' == *cptr))
+    return SCPE_ARG;
+  if (!MATCH_CMD (gbuf, "SNAPLEN")) {
+    snaplen = (uint32)get_uint (cptr, 10, ETH_MAX_PACKET, &r);
+    if ((r != SCPE_OK) || (snaplen < 14))
+      return sim_messagef (SCPE_ARG, "Eth: SNAPLEN must be between 14 and %d\n", ETH_MAX_PACKET);
+    }
+  else
+    if (!MATCH_CMD (gbuf, "RING")) {
+      ring_size = (uint32)get_uint (cptr, 10, ETH_CAP_MAX_RING, &r);
+      if ((r != SCPE_OK) || (ring_size < 16))
+        return sim_messagef (SCPE_ARG, "Eth: RING must be between 16 and %d\n", ETH_CAP_MAX_RING);
+      }
+    else
+      return SCPE_ARG;
+  }
+return _eth_capture_start (dev, fbuf, snaplen, ring_size);
+#endif
+}
+
+t_stat eth_show_capture (FILE* st, ETH_DEV* dev)
+{
+#if defined (USE_READER_THREAD)
+if (dev && dev->capture && dev->capture->active) {
+  fprintf (st, "capture=%s;snaplen=%d;ring=%d", dev->capture->filename, dev->capture->snaplen, dev->capture->ring_size);
+  return SCPE_OK;
+  }
+#endif
+fprintf (st, "no capture");
+return SCPE_OK;
+}
+
+/* Receive interrupt coalescing
+
+   A device which has packets sitting in its receive queue asks here
+   whether to deliver them to the simulated host now or to hold them
+   so that a larger batch (and a single receive interrupt) results.
+   Delivery is held while fewer than coalesce_packets are queued and
+   the oldest waiting packet has been held less than coalesce_time
+   usecs.  While holding, uptr is scheduled to run when the hold
+   expires, so a partial batch is never stranded.
+*/
+t_bool eth_coalesce_hold (ETH_DEV* dev, int queued, UNIT* uptr)
+{
+double now, held, limit;
+int32 wait, active;
+
+if (!dev)
+  return FALSE;
+if (queued <= 0) {
+  dev->coalesce_pending = FALSE;
+  return FALSE;
+  }
+now = sim_gtime ();
+if (!dev->coalesce_pending) {
+  dev->coalesce_pending = TRUE;
+  dev->coalesce_start = now;
+  }
+if ((dev->coalesce_packets <= 1) || ((uint32)queued >= dev->coalesce_packets))
+  return FALSE;
+limit = (dev->coalesce_time * sim_timer_inst_per_sec ()) / 1000000.0;
+held = now - dev->coalesce_start;
+if (held >= limit)
+  return FALSE;
+wait = (int32)(limit - held) + 1;
+active = sim_activate_time (uptr);
+if ((active == 0) || (active > wait))
+  sim_activate_abs (uptr, wait);
+return TRUE;
+}
+
+void eth_coalesce_batch (ETH_DEV* dev, int delivered, int remaining)
+{
+double now, held;
+
+if ((!dev) || (delivered <= 0))
+  return;
+now = sim_gtime ();
+held = dev->coalesce_pending ? now - dev->coalesce_start : 0.0;
+if (dev->coalesce_batches == 0)
+  dev->coalesce_first = now;
+++dev->coalesce_batches;
+dev->coalesce_delivered += delivered;
+if ((uint32)delivered > dev->coalesce_batch_max)
+  dev->coalesce_batch_max = delivered;
+dev->coalesce_latency += held;
+if (held > dev->coalesce_latency_max)
+  dev->coalesce_latency_max = held;
+/* anything left over (host ran out of buffers) starts a new batch */
+dev->coalesce_pending = (remaining > 0);
+dev->coalesce_start = now;
+}
+
 static t_stat _eth_open_port(char *savname, int *eth_api, void **handle, SOCKET *fd_handle, char errbuf[PCAP_ERRBUF_SIZE], char *bpf_filter, void *opaque, DEVICE *dptr, uint32 dbit)
 {
 int bufsz = (BUFSIZ < ETH_MAX_PACKET) ? ETH_MAX_PACKET : BUFSIZ;
@@ -2132,71 +2992,89 @@ else { /* !tap: */
 #endif /* defined(HAVE_SLIRP_NETWORK) */
       }
     else { /* not nat: */
-      if (0 == strncmp("udp:", savname, 4)) {
-        char localport[CBUFSIZE], host[CBUFSIZE], port[CBUFSIZE];
-        char hostport[2*CBUFSIZE];
+      if (0 == strncmp("vsw:", savname, 4)) {
+#if defined(HAVE_VSW_NETWORK)
         const char *devname = savname + 4;
 
-        if (!strcmp(savname, "udp:sourceport:remotehost:remoteport"))
-          return sim_messagef (SCPE_OPENERR, "Eth: Must specify actual udp host and ports(i.e. udp:1224:somehost.com:2234)\n");
-
+        if (!strcmp(savname, "vsw:switchname"))
+          return sim_messagef (SCPE_OPENERR, "Eth: Must specify actual virtual switch name (i.e. vsw:lan1)\n");
         while (isspace(*devname))
           ++devname;
-        if (SCPE_OK != sim_parse_addr_ex (devname, host, sizeof(host), "localhost", port, sizeof(port), localport, sizeof(localport), NULL))
-          return SCPE_OPENERR;
-
-        if (localport[0] == '\0')
-          strcpy (localport, port);
-        sprintf (hostport, "%s:%s", host, port);
-        if ((SCPE_OK == sim_parse_addr (hostport, NULL, 0, NULL, NULL, 0, NULL, "localhost")) &&
-            (0 == strcmp (localport, port)))
-          return sim_messagef (SCPE_OPENERR, "Eth: Must specify different udp localhost ports\n");
-        *fd_handle = sim_connect_sock_ex (localport, hostport, NULL, NULL, SIM_SOCK_OPT_DATAGRAM);
-        if (INVALID_SOCKET == *fd_handle)
-          return SCPE_OPENERR;
-        *eth_api = ETH_API_UDP;
-        *handle = (void *)1;  /* Flag used to indicated open */
+        if ((*handle = (void*) _eth_vsw_open(devname, errbuf))) {
+          *eth_api = ETH_API_VSW;
+          *fd_handle = ((VSW*)(*handle))->doorbell;
+          }
+#else
+        strncpy(errbuf, "No support for vsw: network devices", PCAP_ERRBUF_SIZE-1);
+#endif /* defined(HAVE_VSW_NETWORK) */
         }
-      else { /* not udp:, so attempt to open the parameter as if it were an explicit device name */
+      else { /* not vsw: */
+        if (0 == strncmp("udp:", savname, 4)) {
+          char localport[CBUFSIZE], host[CBUFSIZE], port[CBUFSIZE];
+          char hostport[2*CBUFSIZE];
+          const char *devname = savname + 4;
+
+          if (!strcmp(savname, "udp:sourceport:remotehost:remoteport"))
+            return sim_messagef (SCPE_OPENERR, "Eth: Must specify actual udp host and ports(i.e. udp:1224:somehost.com:2234)\n");
+
+          while (isspace(*devname))
+            ++devname;
+          if (SCPE_OK != sim_parse_addr_ex (devname, host, sizeof(host), "localhost", port, sizeof(port), localport, sizeof(localport), NULL))
+            return SCPE_OPENERR;
+
+          if (localport[0] == '\0')
+            strcpy (localport, port);
+          sprintf (hostport, "%s:%s", host, port);
+          if ((SCPE_OK == sim_parse_addr (hostport, NULL, 0, NULL, NULL, 0, NULL, "localhost")) &&
+              (0 == strcmp (localport, port)))
+            return sim_messagef (SCPE_OPENERR, "Eth: Must specify different udp localhost ports\n");
+          *fd_handle = sim_connect_sock_ex (localport, hostport, NULL, NULL, SIM_SOCK_OPT_DATAGRAM);
+          if (INVALID_SOCKET == *fd_handle)
+            return SCPE_OPENERR;
+          *eth_api = ETH_API_UDP;
+          *handle = (void *)1;  /* Flag used to indicated open */
+          }
+        else { /* not udp:, so attempt to open the parameter as if it were an explicit device name */
 #if defined(HAVE_PCAP_NETWORK)
-        *handle = (void*) pcap_open_live(savname, bufsz, ETH_PROMISC, PCAP_READ_TIMEOUT, errbuf);
-        if (!*handle)   /* can't open device */
-          return sim_messagef (SCPE_OPENERR, "Eth: pcap_open_live error - %s\n", errbuf);
-        *eth_api = ETH_API_PCAP;
+          *handle = (void*) pcap_open_live(savname, bufsz, ETH_PROMISC, PCAP_READ_TIMEOUT, errbuf);
+          if (!*handle)   /* can't open device */
+            return sim_messagef (SCPE_OPENERR, "Eth: pcap_open_live error - %s\n", errbuf);
+          *eth_api = ETH_API_PCAP;
 #if !defined(HAS_PCAP_SENDPACKET) && defined (xBSD) && !defined (__APPLE__)
-        /* Tell the kernel that the header is fully-formed when it gets it.
-           This is required in order to fake the src address. */
-        if (1) {
-          int one = 1;
-          ioctl(pcap_fileno(*handle), BIOCSHDRCMPLT, &one);
-          }
+          /* Tell the kernel that the header is fully-formed when it gets it.
+             This is required in order to fake the src address. */
+          if (1) {
+            int one = 1;
+            ioctl(pcap_fileno(*handle), BIOCSHDRCMPLT, &one);
+            }
 #endif /* xBSD */
 #if defined(_WIN32)
-        pcap_setmintocopy ((pcap_t*)(*handle), 0);
+          pcap_setmintocopy ((pcap_t*)(*handle), 0);
 #endif
 #if !defined (USE_READER_THREAD)
 #ifdef USE_SETNONBLOCK
-        /* set ethernet device non-blocking so pcap_dispatch() doesn't hang */
-        if (pcap_setnonblock (*handle, 1, errbuf) == -1) {
-          sim_printf ("Eth: Failed to set non-blocking: %s\n", errbuf);
-          }
+          /* set ethernet device non-blocking so pcap_dispatch() doesn't hang */
+          if (pcap_setnonblock (*handle, 1, errbuf) == -1) {
+            sim_printf ("Eth: Failed to set non-blocking: %s\n", errbuf);
+            }
 #endif
 #if defined (__APPLE__)
-        if (1) {
-          /* Deliver packets immediately, needed for OS X 10.6.2 and later
-           * (Snow-Leopard).
-           * See this thread on libpcap and Mac Os X 10.6 Snow Leopard on
-           * the tcpdump mailinglist: http://seclists.org/tcpdump/2010/q1/110
-           */
-          int v = 1;
-          ioctl(pcap_fileno(*handle), BIOCIMMEDIATE, &v);
-          }
+          if (1) {
+            /* Deliver packets immediately, needed for OS X 10.6.2 and later
+             * (Snow-Leopard).
+             * See this thread on libpcap and Mac Os X 10.6 Snow Leopard on
+             * the tcpdump mailinglist: http://seclists.org/tcpdump/2010/q1/110
+             */
+            int v = 1;
+            ioctl(pcap_fileno(*handle), BIOCIMMEDIATE, &v);
+            }
 #endif /* defined (__APPLE__) */
 #endif /* !defined (USE_READER_THREAD) */
 #else
-        strncpy (errbuf, "Unknown or unsupported network device", PCAP_ERRBUF_SIZE-1);
+          strncpy (errbuf, "Unknown or unsupported network device", PCAP_ERRBUF_SIZE-1);
 #endif /* defined(HAVE_PCAP_NETWORK) */
-        } /* not udp:, so attempt to open the parameter as if it were an explicit device name */
+          } /* not udp:, so attempt to open the parameter as if it were an explicit device name */
+        } /* !vsw: */
       } /* !nat: */
     } /* !vde: */
   } /* !tap: */
@@ -2355,6 +3233,11 @@ switch (eth_api) {
   case ETH_API_NAT:
     sim_slirp_close((SLIRP*)pcap);
     break;
+#endif
+#ifdef HAVE_VSW_NETWORK
+  case ETH_API_VSW:
+    _eth_vsw_close((VSW*)pcap);
+    break;
 #endif
   case ETH_API_UDP:
     sim_close_sock(pcap_fd);
@@ -2398,6 +3281,7 @@ if (1) {
     }
   }
 ethq_destroy (&dev->read_queue);         /* release FIFO queue */
+_eth_capture_free (dev);
 #endif
 
 _eth_close_port (dev->eth_api, pcap, pcap_fd);
@@ -2428,6 +3312,9 @@ fprintf (st, "    eth2   vde:device{:switch-port-number}      (Integrated VDE su
 fprintf (st, "    eth3   nat:{optional-nat-parameters}        (Integrated NAT (SLiRP) support)\n");
 #endif
 fprintf (st, "    eth4   udp:sourceport:remotehost:remoteport (Integrated UDP bridge support)\n");
+#if defined(HAVE_VSW_NETWORK)
+fprintf (st, "    eth5   vsw:switchname                       (Integrated Virtual Switch support)\n");
+#endif
 fprintf (st, "   sim> ATTACH %s eth0\n\n", dptr->name);
 fprintf (st, "or equivalently:\n\n");
 fprintf (st, "   sim> ATTACH %s en0\n\n", dptr->name);
@@ -2617,6 +3504,9 @@ switch (dev->eth_api) {
   case ETH_API_NAT:
       netname = "nat";
       break;
+  case ETH_API_VSW:
+      netname = "vsw";
+      break;
   }
 sprintf(msg, "%s(%s): ", where, netname);
 switch (dev->eth_api) {
@@ -2713,6 +3603,11 @@ if ((packet->len >= ETH_MIN_PACKET) && (packet->len <= ETH_MAX_PACKET)) {
 #endif
   }
 
+#ifdef USE_READER_THREAD
+  if (dev->capture)
+    _eth_capture (dev, packet->msg, packet->len, PCAPNG_FLAG_OUTBOUND);
+#endif
+
     /* dispatch write request (synchronous; no need to save write info to dev) */
   switch (dev->eth_api) {
 #ifdef HAVE_PCAP_NETWORK
@@ -2749,6 +3644,11 @@ if ((packet->len >= ETH_MIN_PACKET) && (packet->len <= ETH_MAX_PACKET)) {
     case ETH_API_UDP:
       status = (((int32)packet->len == sim_write_sock (dev->fd_handle, (char *)packet->msg, (int32)packet->len)) ? 0 : -1);
       break;
+#ifdef HAVE_VSW_NETWORK
+    case ETH_API_VSW:
+      status = _eth_vsw_send((VSW*)dev->handle, packet->msg, packet->len);
+      break;
+#endif
     }
   ++dev->packets_sent;              /* basic bookkeeping */
   /* On error, correct loopback bookkeeping */
@@ -3359,6 +4259,7 @@ switch (dev->eth_api) {
   case ETH_API_VDE:
   case ETH_API_UDP:
   case ETH_API_NAT:
+  case ETH_API_VSW:
     bpf_used = 0;
     to_me = 0;
     eth_packet_trace (dev, data, header->len, "received");
@@ -3443,6 +4344,8 @@ if (bpf_used ? to_me : (to_me && !from_me)) {
       crc_len = eth_get_packet_crc32_data(data, len, crc_data);
 
     eth_packet_trace (dev, data, len, "rcvqd");
+    if (dev->capture)
+      _eth_capture (dev, data, len, PCAPNG_FLAG_INBOUND);
 
     pthread_mutex_lock (&dev->lock);
     ethq_insert_data(&dev->read_queue, ETH_ITM_NORMAL, data, 0, len, crc_len, crc_data, 0);
@@ -3576,6 +4479,25 @@ do {
           }
         }
       break;
+#ifdef HAVE_VSW_NETWORK
+    case ETH_API_VSW:
+      if (1) {
+        struct pcap_pkthdr header;
+        int len;
+        u_char buf[ETH_MAX_PACKET];
+
+        memset(&header, 0, sizeof(header));
+        len = _eth_vsw_recv ((VSW*)dev->handle, buf, sizeof(buf));
+        if (len > 0) {
+          status = 1;
+          header.caplen = header.len = len;
+          _eth_callback((u_char *)dev, &header, buf);
+          }
+        else
+          status = 0;
+        }
+      break;
+#endif /* HAVE_VSW_NETWORK */
     }
   } while ((status > 0) && (0 == packet->len));
 if (status < 0) {
@@ -3913,6 +4835,15 @@ if (used < max) {
   }
 #endif
 
+#ifdef HAVE_VSW_NETWORK
+if (used < max) {
+  sprintf(list[used].name, "%s", "vsw:switchname");
+  sprintf(list[used].desc, "%s", "Integrated Virtual Switch support");
+  list[used].eth_api = ETH_API_VSW;
+  ++used;
+  }
+#endif
+
 if (used < max) {
   sprintf(list[used].name, "%s", "udp:sourceport:remotehost:remoteport");
   sprintf(list[used].desc, "%s", "Integrated UDP bridge support");
@@ -4011,11 +4942,37 @@ fprintf(st, "  Read Queue: High:        %d\n", dev->read_queue.high);
 fprintf(st, "  Read Queue: Loss:        %d\n", dev->read_queue.loss);
 fprintf(st, "  Peak Write Queue Size:   %d\n", dev->write_queue_peak);
 #endif
+#if defined(USE_READER_THREAD)
+if (dev->capture && dev->capture->active) {
+  fprintf(st, "  Capture File:            %s\n", dev->capture->filename);
+  fprintf(st, "  Capture Snaplen:         %d\n", dev->capture->snaplen);
+  fprintf(st, "  Capture Ring: Size/High: %d/%d\n", dev->capture->ring_size, dev->capture->high);
+  fprintf(st, "  Capture Frames:          %d\n", dev->capture->captured);
+  fprintf(st, "  Capture Dropped:         %d\n", dev->capture->dropped);
+  fprintf(st, "  Capture Truncated:       %d\n", dev->capture->truncated);
+  }
+#endif
+if (dev->coalesce_packets > 1)
+  fprintf(st, "  Recv Coalescing:         %d packets or %d uSec\n", dev->coalesce_packets, dev->coalesce_time);
+if (dev->coalesce_batches) {
+  double usecs_per_inst = 1000000.0 / sim_timer_inst_per_sec ();
+  double elapsed = (sim_gtime () - dev->coalesce_first) * usecs_per_inst;
+
+  fprintf(st, "  Recv Batches:            %d\n", dev->coalesce_batches);
+  fprintf(st, "  Recv Batch Avg/Max:      %.1f/%d packets\n", (double)dev->coalesce_delivered / dev->coalesce_batches, dev->coalesce_batch_max);
+  fprintf(st, "  Recv Latency Avg/Max:    %.0f/%.0f uSec\n", (dev->coalesce_latency * usecs_per_inst) / dev->coalesce_batches, dev->coalesce_latency_max * usecs_per_inst);
+  if (elapsed > 0.0)
+    fprintf(st, "  Recv Throughput:         %.0f packets/sec\n", (dev->coalesce_delivered * 1000000.0) / elapsed);
+  }
 if (dev->bpf_filter)
   fprintf(st, "  BPF Filter: %s\n", dev->bpf_filter);
 #if defined(HAVE_SLIRP_NETWORK)
 if (dev->eth_api == ETH_API_NAT)
   sim_slirp_show ((SLIRP *)dev->handle, st);
 #endif
+#if defined(HAVE_VSW_NETWORK)
+if (dev->eth_api == ETH_API_VSW)
+  _eth_vsw_show ((VSW *)dev->handle, st);
+#endif
 }
 #endif /* USE_NETWORK */
@@ -120,6 +120,11 @@ extern "C" {
 #endif
 #endif /* USE_READER_THREAD */
 
+/* the integrated virtual switch needs POSIX shared memory and GCC style atomics */
+#if defined(HAVE_SHM_OPEN) && defined(__GNUC__) && !defined(_WIN32) && !defined(VMS)
+#define HAVE_VSW_NETWORK 1
+#endif
+
 /* give priority to USE_NETWORK over USE_SHARED */
 #if defined(USE_NETWORK) && defined(USE_SHARED)
 #undef USE_SHARED
@@ -264,6 +269,7 @@ struct eth_device {
 #define ETH_API_VDE  3                                  /* VDE API in use */
 #define ETH_API_UDP  4                                  /* UDP API in use */
 #define ETH_API_NAT  5                                  /* NAT (SLiRP) API in use */
+#define ETH_API_VSW  6                                  /* Virtual Switch API in use */
   ETH_PCALLBACK read_callback;                          /* read callback function */
   ETH_PCALLBACK write_callback;                         /* write callback function */
   ETH_PACK*     read_packet;                            /* read packet */
@@ -309,7 +315,22 @@ struct eth_device {
   uint32        throttle_events;                        /* keeps track of packet arrival values */
   uint32        throttle_packet_time;                   /* time last packet was transmitted */
   uint32        throttle_count;                         /* Total Throttle Delays */
+  /* Receive interrupt coalescing parameters: */
+  uint32        coalesce_packets;                       /* packets delivered per batch.  0 or 1 disables coalescing */
+#define ETH_COAL_MAX_PACKETS 64                         /* Largest receive batch */
+  uint32        coalesce_time;                          /* usecs to hold a partial batch */
+#define ETH_COAL_DEFAULT_TIME 500                       /* 500 usecs Default hold time */
+  /* Receive interrupt coalescing state variables: */
+  ETH_BOOL      coalesce_pending;                       /* packets are waiting to be delivered */
+  double        coalesce_start;                         /* time oldest waiting packet was seen */
+  double        coalesce_first;                         /* time first batch was delivered */
+  uint32        coalesce_batches;                       /* Total Receive Batches delivered */
+  uint32        coalesce_delivered;                     /* Total Packets delivered in batches */
+  uint32        coalesce_batch_max;                     /* Largest Receive Batch */
+  double        coalesce_latency;                       /* Total instructions batches were held */
+  double        coalesce_latency_max;                   /* Longest instructions a batch was held */
 #if defined (USE_READER_THREAD)
+  struct eth_capture *capture;                          /* pcapng packet capture context */
   int           asynch_io;                              /* Asynchronous Interrupt scheduling enabled */
   int           asynch_io_latency;                      /* instructions to delay pending interrupt */
   ETH_QUE       read_queue;
@@ -354,6 +375,15 @@ void eth_setcrc   (ETH_DEV* dev, int need_crc);         /* enable/disable CRC mo
 t_stat eth_set_async (ETH_DEV* dev, int latency);       /* set read behavior to be async */
 t_stat eth_clr_async (ETH_DEV* dev);                    /* set read behavior to be not async */
 t_stat eth_set_throttle (ETH_DEV* dev, uint32 time, uint32 burst, uint32 delay); /* set transmit throttle parameters */
+t_stat eth_set_coalesce (ETH_DEV* dev, uint32 packets, uint32 time); /* set receive coalescing parameters */
+t_stat eth_coalesce_scan (uint32* packets, uint32* time, /* scan SET <dev> COALESCE argument */
+                          const char* cptr);
+t_stat eth_set_capture (ETH_DEV* dev, const char* cptr); /* start (file{;SNAPLEN=n}{;RING=n}) or stop (NULL) pcapng capture */
+t_stat eth_show_capture (FILE* st, ETH_DEV* dev);       /* show pcapng capture state */
+t_bool eth_coalesce_hold (ETH_DEV* dev, int queued,     /* hold queued packets for a larger batch? */
+                          UNIT* uptr);                  /*  uptr scheduled for when hold expires */
+void eth_coalesce_batch (ETH_DEV* dev, int delivered,   /* record a delivered receive batch */
+                         int remaining);
 uint32 eth_crc32(uint32 crc, const void* vbuf, size_t len); /* Compute Ethernet Autodin II CRC for buffer */
 
 void eth_packet_trace (ETH_DEV* dev, const uint8 *msg, int len, const char* txt); /* trace ethernet packet header+crc */
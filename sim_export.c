@@ -0,0 +1,239 @@
+/* sim_export.c: simulator shared memory state export client API
+
+   Copyright (c) 2026, The simh contributors
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+   THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+   CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   This module provides read only access to the state a simulator publishes
+   with the EXPORT command.  It is compiled into monitoring applications,
+   not into simulators, and depends on nothing else in simh.
+*/
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sched.h>
+#endif
+#include <stdio.h>
+#include <string.h>
+
+#include "sim_export.h"
+
+#if !defined(__VAX)         /* Unsupported platform */
+
+#define SIM_EXPORT_READ_RETRIES 10000   /* attempts to capture a consistent image */
+
+struct SIM_EXPORT {
+    SIM_EXPORT_HEADER   *hdr;           /* mapped region */
+    size_t              size;           /* mapped size */
+#if defined(_WIN32)
+    HANDLE              hMapping;
+#endif
+    };
+
+static SIM_EXPORT *
+_export_validate (SIM_EXPORT *exp)
+{
+const SIM_EXPORT_HEADER *hdr = exp->hdr;
+
+if ((exp->size < sizeof (*hdr)) ||
+    (hdr->magic != SIM_EXPORT_MAGIC) ||
+    (hdr->version != SIM_EXPORT_VERSION) ||
+    ((size_t)hdr->item_offset + (size_t)hdr->item_count * sizeof (SIM_EXPORT_ITEM) > exp->size) ||
+    ((size_t)hdr->data_offset + (size_t)hdr->data_size > exp->size)) {
+    sim_export_detach (exp);
+    return NULL;
+    }
+return exp;
+}
+
+SIM_EXPORT *
+sim_export_attach (const char *name)
+{
+SIM_EXPORT *exp = (SIM_EXPORT *)calloc (1, sizeof (*exp));
+char shm_name[sizeof (SIM_EXPORT_NAME_PREFIX) + SIM_EXPORT_NAME_MAX];
+
+if (exp == NULL)
+    return NULL;
+if (strlen (name) > SIM_EXPORT_NAME_MAX) {          /* no simulator can export it */
+    free (exp);
+    return NULL;
+    }
+sprintf (shm_name, "%s%s", SIM_EXPORT_NAME_PREFIX, name);
+#if defined(_WIN32)
+if (1) {
+    MEMORY_BASIC_INFORMATION info;
+
+    exp->hMapping = OpenFileMappingA (FILE_MAP_READ, FALSE, shm_name);
+    if (exp->hMapping == NULL) {
+        free (exp);
+        return NULL;
+        }
+    exp->hdr = (SIM_EXPORT_HEADER *)MapViewOfFile (exp->hMapping, FILE_MAP_READ, 0, 0, 0);
+    if ((exp->hdr == NULL) ||
+        (0 == VirtualQuery (exp->hdr, &info, sizeof (info)))) {
+        sim_export_detach (exp);
+        return NULL;
+        }
+    exp->size = info.RegionSize;
+    }
+#else
+if (1) {
+    struct stat statb;
+    int fd = shm_open (shm_name, O_RDONLY, 0);
+
+    if (fd == -1) {
+        free (exp);
+        return NULL;
+        }
+    if ((fstat (fd, &statb)) ||
+        ((size_t)statb.st_size < sizeof (*exp->hdr))) {
+        close (fd);
+        free (exp);
+        return NULL;
+        }
+    exp->size = (size_t)statb.st_size;
+    exp->hdr = (SIM_EXPORT_HEADER *)mmap (NULL, exp->size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);
+    if (exp->hdr == (SIM_EXPORT_HEADER *)MAP_FAILED) {
+        exp->hdr = NULL;
+        sim_export_detach (exp);
+        return NULL;
+        }
+    }
+#endif
+return _export_validate (exp);
+}
+
+void
+sim_export_detach (SIM_EXPORT *exp)
+{
+if (exp == NULL)
+    return;
+#if defined(_WIN32)
+if (exp->hdr)
+    UnmapViewOfFile (exp->hdr);
+if (exp->hMapping)
+    CloseHandle (exp->hMapping);
+#else
+if (exp->hdr)
+    munmap ((void *)exp->hdr, exp->size);
+#endif
+free (exp);
+}
+
+const SIM_EXPORT_HEADER *
+sim_export_header (SIM_EXPORT *exp)
+{
+return exp->hdr;
+}
+
+const SIM_EXPORT_ITEM *
+sim_export_item (SIM_EXPORT *exp, unsigned int index)
+{
+if (index >= exp->hdr->item_count)
+    return NULL;
+return (const SIM_EXPORT_ITEM *)((const char *)exp->hdr + exp->hdr->item_offset) + index;
+}
+
+const SIM_EXPORT_ITEM *
+sim_export_find (SIM_EXPORT *exp, const char *device_name, const char *name)
+{
+unsigned int i;
+
+for (i = 0; i < exp->hdr->item_count; i++) {
+    const SIM_EXPORT_ITEM *item = sim_export_item (exp, i);
+
+    if ((!strcmp (name, item->name)) &&
+        ((device_name == NULL) || (!strcmp (device_name, item->device))))
+        return item;
+    }
+return NULL;
+}
+
+int
+sim_export_read (SIM_EXPORT *exp,
+                 void *data,
+                 unsigned long long *simulation_time,
+                 unsigned long long *updates)
+{
+const SIM_EXPORT_HEADER *hdr = exp->hdr;
+int retries;
+
+for (retries = 0; retries < SIM_EXPORT_READ_RETRIES; retries++) {
+    unsigned int seq = hdr->sequence;
+    unsigned long long t, n;
+
+    if (!hdr->active)
+        return -1;
+    if (seq & 1) {                      /* update in progress */
+#if defined(_WIN32)
+        Sleep (0);
+#else
+        sched_yield ();
+#endif
+        continue;
+        }
+    SIM_EXPORT_BARRIER ();
+    memcpy (data, (const char *)hdr + hdr->data_offset, hdr->data_size);
+    t = hdr->simulation_time;
+    n = hdr->updates;
+    SIM_EXPORT_BARRIER ();
+    if (seq == hdr->sequence) {
+        if (simulation_time)
+            *simulation_time = t;
+        if (updates)
+            *updates = n;
+        return 0;
+        }
+    }
+return -2;
+}
+
+unsigned long long
+sim_export_value (const SIM_EXPORT_ITEM *item, const void *data, unsigned int element)
+{
+const char *p = (const char *)data + item->offset + (size_t)element * item->element_size;
+
+if (element >= item->element_count)
+    return 0;
+switch (item->element_size) {
+    case 1:
+        return *(const unsigned char *)p;
+    case 2:
+        return *(const unsigned short *)p;
+    case 4:
+        return *(const unsigned int *)p;
+    default:
+        return *(const unsigned long long *)p;
+    }
+}
+
+#endif /* !defined(__VAX) */
+
+#ifdef  __cplusplus
+}
+#endif
@@ -0,0 +1,183 @@
+/* sim_export.h: simulator shared memory state export definitions
+
+   Copyright (c) 2026, The simh contributors
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+   THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+   CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   This module defines the layout of the shared memory region a simulator
+   publishes with the EXPORT command, and a small client API which external
+   monitoring tools use to read it.
+
+   The region contains a header, a table describing each exported item (a
+   register, a range of register array elements or a range of memory
+   addresses) and a data area holding the current values of the items.
+   Values are stored in host byte order, each element occupying
+   element_size bytes (1, 2, 4 or 8) at a naturally aligned offset.
+
+   The simulator rewrites the data area every EXPORT interval instructions.
+   Updates are published with a sequence lock: the sequence number is odd
+   while an update is in progress and is incremented again when it is
+   complete.  A reader copies the data and then checks that the sequence
+   number was even and unchanged across the copy, retrying otherwise.
+   Readers never make the simulator wait.
+
+   Any application which wants to use the client API needs to:
+      1) include this file in the application code
+      2) compile sim_export.c from the top level directory of the simh
+         source.
+      3) link the sim_export object module (and -lrt on older Linux hosts)
+         into the application.
+*/
+
+#ifndef SIM_EXPORT_H_
+#define SIM_EXPORT_H_     0
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h>
+
+#if !defined(__VAX)         /* Unsupported platform */
+
+#define SIM_EXPORT_MAGIC        0x58454D53      /* "SMEX" */
+#define SIM_EXPORT_VERSION      1
+
+#define SIM_EXPORT_NAME_PREFIX  "/simh-export-" /* shared memory object name prefix */
+#define SIM_EXPORT_NAME_MAX     64              /* longest export name */
+
+#define SIM_EXPORT_REGISTER     1               /* item is register element(s) */
+#define SIM_EXPORT_MEMORY       2               /* item is a range of memory */
+
+#define SIM_EXPORT_F_INDIRECT   1               /* register item holds the memory the register points at */
+
+typedef struct SIM_EXPORT_HEADER {
+    unsigned int            magic;              /* SIM_EXPORT_MAGIC */
+    unsigned int            version;            /* SIM_EXPORT_VERSION */
+    volatile unsigned int   sequence;           /* update sequence (odd while updating) */
+    volatile unsigned int   active;             /* non zero while the simulator is exporting */
+    unsigned int            pid;                /* process id of the simulator */
+    unsigned int            interval;           /* instructions between updates */
+    unsigned int            item_count;         /* number of items */
+    unsigned int            item_offset;        /* region offset of the item table */
+    unsigned int            data_offset;        /* region offset of the data area */
+    unsigned int            data_size;          /* size of the data area */
+    volatile unsigned long long updates;        /* updates published (sequence protected) */
+    volatile unsigned long long simulation_time;/* instructions executed at last update (sequence protected) */
+    char                    sim_name[64];       /* simulator name */
+    } SIM_EXPORT_HEADER;
+
+typedef struct SIM_EXPORT_ITEM {
+    char                    name[32];           /* register name or "MEMORY" */
+    char                    device[32];         /* device name */
+    unsigned int            type;               /* SIM_EXPORT_REGISTER or SIM_EXPORT_MEMORY */
+    unsigned int            flags;              /* SIM_EXPORT_F_xxx */
+    unsigned int            element_size;       /* bytes per element */
+    unsigned int            element_count;      /* number of elements */
+    unsigned int            offset;             /* data area offset of first element */
+    unsigned int            address_increment;  /* memory address units per element */
+    unsigned long long      first;              /* first register index or memory address */
+    } SIM_EXPORT_ITEM;
+
+#if defined(_WIN32)
+#define SIM_EXPORT_BARRIER() MemoryBarrier ()
+#else
+#define SIM_EXPORT_BARRIER() __sync_synchronize ()
+#endif
+
+/**
+
+    sim_export_attach       attach to a simulator's exported state
+
+        name                the name given to the simulator's EXPORT command
+
+    returns a handle to the export or NULL if the export doesn't exist or
+    has an incompatible layout.
+
+    sim_export_detach       release a handle obtained from sim_export_attach
+
+ */
+
+typedef struct SIM_EXPORT SIM_EXPORT;
+
+SIM_EXPORT *
+sim_export_attach (const char *name);
+
+void
+sim_export_detach (SIM_EXPORT *exp);
+
+/**
+
+    sim_export_header       the header of an attached export
+
+    sim_export_item         the description of an exported item
+
+        index               0 .. header->item_count - 1
+
+    sim_export_find         locate an exported item by name
+
+        device_name         the device name (NULL matches any device)
+        name                the register name (or "MEMORY")
+
+ */
+
+const SIM_EXPORT_HEADER *
+sim_export_header (SIM_EXPORT *exp);
+
+const SIM_EXPORT_ITEM *
+sim_export_item (SIM_EXPORT *exp, unsigned int index);
+
+const SIM_EXPORT_ITEM *
+sim_export_find (SIM_EXPORT *exp, const char *device_name, const char *name);
+
+/**
+
+    sim_export_read         copy a consistent image of the export's data area
+
+        data                buffer of at least header->data_size bytes
+        simulation_time     if not NULL, receives the simulation time of
+                            the copied update
+        updates             if not NULL, receives the number of the copied
+                            update
+
+    returns 0 on success, -1 if the simulator is no longer exporting into
+    this region (the simulator exited or issued NOEXPORT or another EXPORT
+    command, re-attach to follow it) or -2 if no consistent image could be
+    captured after a large number of attempts.
+
+    sim_export_value        extract an element of an item from a data area
+                            image returned by sim_export_read
+
+ */
+
+int
+sim_export_read (SIM_EXPORT *exp,
+                 void *data,
+                 unsigned long long *simulation_time,
+                 unsigned long long *updates);
+
+unsigned long long
+sim_export_value (const SIM_EXPORT_ITEM *item, const void *data, unsigned int element);
+
+#endif /* !defined(__VAX) */
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* SIM_EXPORT_H_ */
@@ -52,6 +52,7 @@
    sim_buf_swap_data -       swap data elements inplace in buffer
    sim_shmem_open            create or attach to a shared memory region
    sim_shmem_close           close a shared memory region
+   sim_shmem_unlink          remove a named shared memory region
 
 
    sim_fopen and sim_fseek are OS-dependent.  The other routines are not.
@@ -458,6 +459,11 @@ if (shmem->hMapping != INVALID_HANDLE_VALUE)
 free (shmem);
 }
 
+void sim_shmem_unlink (const char *name)
+{
+/* Windows mappings go away when the last handle to them is closed */
+}
+
 #else /* !defined(_WIN32) */
 #include <unistd.h>
 int sim_set_fsize (FILE *fptr, t_addr size)
@@ -604,6 +610,13 @@ if (shmem->shm_fd != -1)
 free (shmem);
 }
 
+void sim_shmem_unlink (const char *name)
+{
+#ifdef HAVE_SHM_OPEN
+shm_unlink (name);
+#endif
+}
+
 #endif
 
 #if defined(__VAX)
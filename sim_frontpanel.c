@@ -143,6 +143,10 @@ struct PANEL {
     REG                     *regs;
     char                    *reg_query;
     int                     new_register;
+    int                     snapshot;       /* simulator accepted the snapshot schema */
+    unsigned char           *snapshot_data;
+    size_t                  snapshot_size;
+    int                     telnet;             /* session uses telnet (IACs doubled) */
     size_t                  reg_query_size;
     unsigned long long      array_element_data;
     volatile OperationalState State;
@@ -229,6 +233,12 @@ static const char *register_dev_echo = "# REGISTERS-FOR-DEVICE:";
 static const char *register_ind_echo = "# REGISTER-INDIRECT:";
 static const char *command_status = "ECHO Status:%STATUS%-%TSTATUS%";
 static const char *command_done_echo = "# COMMAND-DONE";
+static const char *snapshot_define = "SNAPSHOT DEFINE ";
+static const char *snapshot_every = "SNAPSHOT EVERY ";
+static const char *snapshot_stop = "SNAPSHOT STOP";
+static const char *snapshot_get = "SNAPSHOT\r";
+static const char *snapshot_echo = "# SNAPSHOT:";
+static const char *snapshot_push_echo = "# SNAPSHOT-PUSH:";
 static int little_endian;
 static void *_panel_reader(void *arg);
 static void *_panel_callback(void *arg);
@@ -634,6 +644,116 @@ free (buf);
 return 0;
 }
 
+/*
+   Describe the panel's register set to the simulator once, as a SNAPSHOT 
+   schema.  From then on register values arrive as fixed layout binary 
+   snapshots (see _panel_snapshot_decode) rather than as EXAMINE output 
+   text.  A simulator which rejects the schema is polled with the text 
+   register query string instead.
+ */
+static int
+_panel_establish_snapshot (PANEL *panel)
+{
+size_t i, buf_data, buf_needed = 1 + strlen (snapshot_define);
+int cmd_stat;
+char *buf, *response = NULL, *c;
+
+pthread_mutex_lock (&panel->io_lock);
+for (i=0; i<panel->reg_count; i++) {
+    if (!panel->regs[i].bits)
+        buf_needed += 30 + strlen (panel->regs[i].name) + (panel->regs[i].device_name ? strlen (panel->regs[i].device_name) : 0);
+    }
+buf = (char *)_panel_malloc (buf_needed);
+if (!buf) {
+    panel->State = Error;
+    pthread_mutex_unlock (&panel->io_lock);
+    return -1;
+    }
+strcpy (buf, snapshot_define);
+buf_data = strlen (buf);
+for (i=0; i<panel->reg_count; i++) {
+    if (panel->regs[i].bits)
+        continue;
+    sprintf (buf + buf_data, "%s%d %s%s%s%s", (buf[buf_data - 1] != ' ') ? "," : "", 
+                                              (int)panel->regs[i].size, 
+                                              panel->regs[i].indirect ? "-I " : "", 
+                                              panel->regs[i].device_name ? panel->regs[i].device_name : "",
+                                              panel->regs[i].device_name ? " " : "",
+                                              panel->regs[i].name);
+    buf_data += strlen (buf + buf_data);
+    if (panel->regs[i].element_count > 0) {
+        sprintf (buf + buf_data, "[0:%d]", (int)(panel->regs[i].element_count - 1));
+        buf_data += strlen (buf + buf_data);
+        }
+    }
+panel->snapshot = 0;
+pthread_mutex_unlock (&panel->io_lock);
+if (_panel_sendf (panel, &cmd_stat, &response, "%s\r", buf)) {
+    free (buf);
+    return -1;
+    }
+for (c = response; c && *c && isspace (0xFF & (*c)); ++c)
+    ;
+pthread_mutex_lock (&panel->io_lock);
+panel->snapshot = ((cmd_stat == 0) && c && (*c == '\0'));
+_panel_debug (panel, DBG_REQ, "Register Snapshots %s", NULL, 0, panel->snapshot ? "Established" : "Unavailable, using Register Query");
+pthread_mutex_unlock (&panel->io_lock);
+free (response);
+free (buf);
+return 0;
+}
+
+/*
+   Store the values contained in a binary register snapshot.  The layout 
+   is positional: the simulation time, then each non bit register in 
+   declaration order, then each sampled bit register prefixed by its bit 
+   count, all little endian.
+ */
+static void
+_panel_snapshot_decode (PANEL *p, const unsigned char *data, size_t data_size)
+{
+size_t i, j, k, off;
+unsigned long long simulation_time = 0;
+
+if (data_size < 8)
+    return;
+for (off = 0; off < 8; off++)
+    simulation_time |= ((unsigned long long)data[off]) << (8 * off);
+p->simulation_time = simulation_time;
+for (i=0; i<p->reg_count; i++) {
+    REG *r = &p->regs[i];
+    size_t elements = (r->element_count > 0) ? r->element_count : 1;
+
+    if (r->bits)
+        continue;
+    for (j = 0; (j < elements) && (off + r->size <= data_size); j++, off += r->size) {
+        unsigned char *dest = (unsigned char *)r->addr + j * r->size;
+
+        if (little_endian)
+            memcpy (dest, data + off, r->size);
+        else {
+            for (k = 0; k < r->size; k++)
+                dest[k] = data[off + r->size - 1 - k];
+            }
+        }
+    }
+for (i=0; i<p->reg_count; i++) {
+    REG *r = &p->regs[i];
+    size_t width;
+
+    if (!r->bits)
+        continue;
+    if (off + 2 > data_size)
+        break;
+    width = data[off] | (data[off + 1] << 8);
+    off += 2;
+    for (j = 0; (j < width) && (off + 4 <= data_size); j++, off += 4) {
+        if (j < r->bit_count)
+            r->bits[j] = (int)(data[off] | (data[off + 1] << 8) | (data[off + 2] << 16) | ((unsigned int)data[off + 3] << 24));
+        }
+    }
+}
+
 static PANEL **panels = NULL;
 static int panel_count = 0;
 static char *sim_panel_error_buf = NULL;
@@ -731,6 +851,7 @@ if (simulator_panel) {
     strcpy (p->device_name, device_name);
     p->parent = simulator_panel;
     p->Debug = p->parent->Debug;
+    p->telnet = p->parent->telnet;
     strcpy (p->hostport, simulator_panel->hostport);
     p->sock = INVALID_SOCKET;
     }
@@ -1110,6 +1231,7 @@ if (panel) {
         }
     free (panel->regs);
     free (panel->reg_query);
+    free (panel->snapshot_data);
     free (panel->io_response);
     free (panel->halt_reason);
     free (panel->simulator_version);
@@ -1276,6 +1398,8 @@ pthread_mutex_unlock (&panel->io_lock);
 /* Now build the register query string for the whole register list */
 if (_panel_register_query_string (panel, &panel->reg_query, &panel->reg_query_size))
     return -1;
+if (_panel_establish_snapshot (panel))
+    return -1;
 if (bits) {
     for (i=0; i<bit_count; i++)
         bits[i] = (data & (1LL<<i)) ? panel->sample_depth : 0;
@@ -1354,10 +1478,21 @@ if (!panel->reg_count) {
     }
 pthread_mutex_lock (&panel->io_command_lock);
 pthread_mutex_lock (&panel->io_lock);
-if (panel->reg_query_size != _panel_send (panel, panel->reg_query, panel->reg_query_size)) {
-    pthread_mutex_unlock (&panel->io_lock);
-    pthread_mutex_unlock (&panel->io_command_lock);
-    return -1;
+if (panel->snapshot) {
+    int get_size = (int)strlen (snapshot_get);
+
+    if (get_size != _panel_send (panel, snapshot_get, get_size)) {
+        pthread_mutex_unlock (&panel->io_lock);
+        pthread_mutex_unlock (&panel->io_command_lock);
+        return -1;
+        }
+    }
+else {
+    if (panel->reg_query_size != _panel_send (panel, panel->reg_query, panel->reg_query_size)) {
+        pthread_mutex_unlock (&panel->io_lock);
+        pthread_mutex_unlock (&panel->io_command_lock);
+        return -1;
+        }
     }
 if (panel->io_response_data)
     _panel_debug (panel, DBG_RCV, "Receive Data Discarded: ", panel->io_response, panel->io_response_data);
@@ -2146,6 +2281,7 @@ if (!p->parent) {
         if (!memcmp (mantra, buf, sizeof (mantra))) {   /* strip initial telnet mantra from input stream */
             memmove (buf, buf + sizeof (mantra), 1 + buf_data - sizeof (mantra));
             buf_data -= sizeof (mantra);
+            p->telnet = 1;
             }
         if ((size_t)buf_data < strlen (sim_prompt))
             continue;
@@ -2186,6 +2322,88 @@ while ((p->sock != INVALID_SOCKET) &&
         *eol++ = '\0';
         while ((*s) && (s[strlen(s)-1] == '\r'))
             s[strlen(s)-1] = '\0';
+        if ((NULL != (e = strstr (s, snapshot_push_echo))) || 
+            (NULL != (e = strstr (s, snapshot_echo)))) {
+            int pushed = (0 == memcmp (e, snapshot_push_echo, strlen (snapshot_push_echo)));
+            size_t snapshot_data = 0;
+            size_t snapshot_needed = (size_t)strtoul (e + strlen (pushed ? snapshot_push_echo : snapshot_echo), NULL, 10);
+            char *end = &buf[buf_data];
+
+            if ((e != s) && (!memcmp ("Simulator Running...", s, 20))) {
+                _panel_debug (p, DBG_RSP, "State transitioning to Run", NULL, 0);
+                p->State = Run;
+                if ((!p->parent) && 
+                    (p->completion_string) && 
+                    (!memcmp (s, p->completion_string, strlen (p->completion_string)))) {
+                    _panel_debug (p, DBG_RCV, "*Match Command Complete - Match signaling waiting thread", NULL, 0);
+                    p->io_waiting = 0;
+                    p->completion_string = NULL;
+                    pthread_cond_signal (&p->io_done);
+                    }
+                }
+            if (snapshot_needed > p->snapshot_size) {
+                unsigned char *t = (unsigned char *)_panel_malloc (snapshot_needed);
+
+                if (t == NULL) {
+                    p->State = Error;
+                    break;
+                    }
+                free (p->snapshot_data);
+                p->snapshot_data = t;
+                p->snapshot_size = snapshot_needed;
+                }
+            /* The binary data follows the header line, with any IAC characters */
+            /* doubled when the session uses telnet */
+            while (snapshot_data < snapshot_needed) {
+                while ((snapshot_data < snapshot_needed) && (eol < end)) {
+                    if (p->telnet && (TN_IAC == (unsigned char)*eol) && (++eol == end)) {
+                        --eol;                              /* escaped IAC not yet received */
+                        break;
+                        }
+                    p->snapshot_data[snapshot_data++] = (unsigned char)*eol++;
+                    }
+                if (snapshot_data < snapshot_needed) {
+                    int new_data;
+
+                    buf_data = (int)(end - eol);
+                    memmove (buf, eol, buf_data);
+                    eol = buf;
+                    pthread_mutex_unlock (&p->io_lock);
+                    new_data = sim_read_sock (p->sock, &buf[buf_data], sizeof(buf)-(buf_data+1));
+                    pthread_mutex_lock (&p->io_lock);
+                    if (new_data <= 0) {
+                        sim_panel_set_error (NULL, "%s", sim_get_err_sock("Unexpected socket read"));
+                        _panel_debug (p, DBG_RCV, "%s", NULL, 0, sim_panel_get_error());
+                        p->State = Error;
+                        break;
+                        }
+                    _panel_debug (p, DBG_RCV, "Received %d snapshot bytes: ", &buf[buf_data], new_data, new_data);
+                    buf_data += new_data;
+                    buf[buf_data] = '\0';
+                    end = &buf[buf_data];
+                    }
+                }
+            if (snapshot_data < snapshot_needed) {
+                buf_data = 0;
+                buf[buf_data] = '\0';
+                s = buf;
+                break;
+                }
+            _panel_debug (p, DBG_RCV, "*%s Snapshot Complete (%d bytes)", NULL, 0, pushed ? "Pushed" : "Requested", (int)snapshot_data);
+            _panel_snapshot_decode (p, p->snapshot_data, snapshot_data);
+            if (pushed) {
+                if (p->callback) {
+                    pthread_mutex_unlock (&p->io_lock);
+                    p->callback (p, p->simulation_time_base + p->simulation_time, p->callback_context);
+                    pthread_mutex_lock (&p->io_lock);
+                    }
+                }
+            else {
+                p->io_waiting = 0;
+                pthread_cond_signal (&p->io_done);
+                }
+            goto Start_Next_Line;
+            }
         if (processing_register_output) {
             e = strchr (s, ':');
             if (e) {
@@ -2482,6 +2700,18 @@ while ((p->sock != INVALID_SOCKET) &&
     /*  2) update register state by polling if the simulator is halted          */
     msleep (500);
     pthread_mutex_lock (&p->io_lock);
+    if (new_register && p->snapshot) {
+        interval = p->usecs_between_callbacks;
+        pthread_mutex_unlock (&p->io_lock);
+        if ((interval == 0) ?                       /* callbacks stopped meanwhile? */
+            _panel_sendf (p, &cmd_stat, NULL, "%s", snapshot_stop) :
+            _panel_sendf (p, &cmd_stat, NULL, "%s%d%s", snapshot_every, interval, register_repeat_units)) {
+            pthread_mutex_lock (&p->io_lock);
+            break;
+            }
+        pthread_mutex_lock (&p->io_lock);
+        new_register = 0;
+        }
     if (new_register) {
         size_t repeat_data = strlen (register_repeat_prefix) +  /* prefix */
                              20                              +  /* max int width */
@@ -210,6 +210,11 @@ sim_panel_add_register_indirect_bits (PANEL *panel,
            or frontpanel interactions with the simulator may be disrupted.  
            Setting a flag, signaling an event or posting a message are 
            reasonable activities to perform in a callback routine.
+   Note 3: When the simulator supports the SNAPSHOT remote console command, 
+           register values are transferred as a single binary frame (and 
+           pushed by the simulator at the callback rate while it is running) 
+           rather than as formatted EXAMINE text.  Older simulators are 
+           transparently handled with the text query.
  */
 
 int
@@ -150,6 +150,7 @@ typedef struct serial_config {                          /* serial port configura
 static int       sim_serial_os_devices (int max, SERIAL_LIST* list);
 static SERHANDLE sim_open_os_serial    (char *name);
 static void      sim_close_os_serial   (SERHANDLE port);
+static void      sim_show_os_serial    (FILE *st, SERHANDLE port);
 static t_stat    sim_config_os_serial  (SERHANDLE port, SERCONFIG config);
 
 
@@ -363,6 +364,7 @@ if (serial_open_device_count) {
         d = sim_serial_getdesc_byname(serial_open_devices[i].name, desc);
         fprintf(st, " %s\tLn%02d %s%s%s%s\tConfig: %s\n", serial_open_devices[i].line->mp->dptr->name, (int)(serial_open_devices[i].line->mp->ldsc-serial_open_devices[i].line),
                     serial_open_devices[i].line->destination, d ? " {" : "", d ? d : "", d ? ")" : "", serial_open_devices[i].line->serconfig);
+        sim_show_os_serial (st, serial_open_devices[i].port);
         }
     }
 return SCPE_OK;
@@ -917,11 +919,34 @@ free (port);
 }
 
 
+/* Show serial port statistics */
+
+static void sim_show_os_serial (FILE *st, SERHANDLE port)
+{
+}
+
+
 
 #elif defined (__unix__) || defined(__APPLE__) || defined(__hpux)
 
+#define SER_RBUF_SIZE       4096                        /* per port read-ahead buffer size */
+#define SER_MODEM_CACHE_MS  20                          /* modem status cache lifetime (ms) */
+
 struct SERPORT {
-    int port;
+    int     port;
+    char    rbuf[SER_RBUF_SIZE];                        /* read-ahead buffer (raw PARMRK stream) */
+    int32   rbuf_ptr;                                   /* next unconsumed character */
+    int32   rbuf_cnt;                                   /* characters held */
+    int     modem_bits;                                 /* cached TIOCMGET value */
+    t_bool  modem_valid;                                /* cached value is current */
+    uint32  modem_time;                                 /* time cached value was fetched (ms) */
+    uint32  reads;                                      /* host read calls */
+    uint32  read_bytes;                                 /* host bytes read */
+    uint32  buffered_reads;                             /* reads satisfied from the read-ahead buffer */
+    uint32  modem_gets;                                 /* host modem status fetches */
+    uint32  modem_cached;                               /* modem status requests served from cache */
+    uint32  writes;                                     /* host write calls */
+    uint32  write_bytes;                                /* host bytes written */
     };
 
 #if defined(__linux) || defined(__linux__)
@@ -1267,6 +1292,15 @@ return SCPE_OK;                                         /* configuration set suc
    If unreasonable or nonsense bits_to_set or bits_to_clear bits are 
    specified, then the return status is SCPE_ARG;
    If an error occurs, SCPE_IOERR is returned.
+
+   Implementation notes:
+
+    1. Simulated modem controllers tend to fetch the modem status every
+       time the simulated OS reads a status register, which can be many
+       thousands of times a second.  The incoming bits are cached for
+       SER_MODEM_CACHE_MS milliseconds, which is far shorter than any
+       meaningful modem signal transition, and the cache is discarded
+       whenever DTR or RTS are changed.
 */
 
 t_stat sim_control_serial (SERHANDLE port, int32 bits_to_set, int32 bits_to_clear, int32 *incoming_bits)
@@ -1293,10 +1327,25 @@ if (bits_to_clear) {
         return SCPE_IOERR;                          /* return failure status */
         }
     }
+if (bits_to_set || bits_to_clear)                   /* changing outgoing signals */
+    port->modem_valid = FALSE;                      /*   may change looped back status */
 if (incoming_bits) {
-    if (ioctl (port->port, TIOCMGET, &bits)) {      /* get the modem bits */
-        sim_error_serial ("ioctl", errno);          /* report unexpected error */
-        return SCPE_IOERR;                          /* return failure status */
+    uint32 now = sim_os_msec ();
+
+    if (port->modem_valid &&                        /* cached status still current? */
+        ((now - port->modem_time) < SER_MODEM_CACHE_MS)) {
+        bits = port->modem_bits;
+        ++port->modem_cached;
+        }
+    else {
+        if (ioctl (port->port, TIOCMGET, &bits)) {  /* get the modem bits */
+            sim_error_serial ("ioctl", errno);      /* report unexpected error */
+            return SCPE_IOERR;                      /* return failure status */
+            }
+        port->modem_bits = bits;
+        port->modem_time = now;
+        port->modem_valid = TRUE;
+        ++port->modem_gets;
         }
     *incoming_bits = ((bits&TIOCM_CTS) ? TMXR_MDM_CTS : 0) |
                      ((bits&TIOCM_DSR) ? TMXR_MDM_DSR : 0) |
@@ -1323,55 +1372,88 @@ return SCPE_OK;
        bad character.  A communications line BREAK is indicated by the sequence
        \377 \000 \000.  A received \377 character is indicated by the
        two-character sequence \377 \377.  If we find any of these sequences,
-       they are replaced by the single intended character by sliding the
-       succeeding characters backward by one or two positions.  If a BREAK
-       sequence was encountered, the corresponding location in the "brk" array
-       is determined, and the flag is set.  Note that there may be multiple
+       they are replaced by the single intended character as the characters
+       are copied to the caller's buffer.  If a BREAK sequence was
+       encountered, the corresponding location in the "brk" array is
+       determined, and the flag is set.  Note that there may be multiple
        sequences in the buffer.
+
+    2. Each host read drains as much as the kernel has buffered for the
+       port (up to SER_RBUF_SIZE characters) into a per-port read-ahead
+       buffer, and requests are then satisfied from that buffer without
+       further system calls until it holds fewer characters than are
+       asked for.  A PARMRK sequence that was split between two host reads
+       is held back until the rest of it arrives.
 */
 
 int32 sim_read_serial (SERHANDLE port, char *buffer, int32 count, char *brk)
 {
 int read_count;
-char *bptr, *cptr;
-int32 remaining;
-
-read_count = read (port->port, (void *) buffer, (size_t) count);/* read from the serial port */
-
-if (read_count == -1)                                       /* read error? */
-    if (errno == EAGAIN)                                    /* no characters available? */
-        return 0;                                           /* return 0 to indicate */
-    else                                                    /* some other problem */
-        sim_error_serial ("read", errno);                   /* report unexpected error */
-
-else {                                                      /* read succeeded */
-    cptr = buffer;                                          /* point at start of buffer */
-    remaining = read_count - 1;                             /* stop search one char from end of string */
-
-    while (remaining > 0 &&                                 /* still characters to search? */
-           (bptr = (char*)memchr (cptr, '\377', remaining))) {/* search for start of PARMRK sequence */
-        remaining = remaining - (bptr - cptr) - 1;          /* calc characters remaining */
-
-        if (*(bptr + 1) == '\377') {                        /* is it a \377 \377 sequence? */
-            memmove (bptr + 1, bptr + 2, remaining);        /* slide string backward to leave first \377 */
-            remaining = remaining - 1;                      /* drop remaining count */
-            read_count = read_count - 1;                    /*   and read count by char eliminated */
-            }
-
-        else if (remaining > 0 && *(bptr + 1) == '\0') {    /* is it a \377 \000 \ccc sequence? */
-            memmove (bptr, bptr + 2, remaining);            /* slide string backward to leave \ccc */
-            remaining = remaining - 2;                      /* drop remaining count */
-            read_count = read_count - 2;                    /*   and read count by chars eliminated */
+int32 held, room, len, n = 0;
+char *rbuf = port->rbuf;
+char *bptr;
 
-            if (*bptr == '\0')                              /* is it a BREAK sequence? */
-                *(brk + (bptr - buffer)) = 1;               /* set corresponding BREAK flag */
+held = port->rbuf_cnt - port->rbuf_ptr;                     /* characters held from a prior read */
+if (held < count) {                                         /* need more than is held? */
+    if (port->rbuf_ptr) {                                   /* compact the read-ahead buffer */
+        memmove (rbuf, rbuf + port->rbuf_ptr, held);
+        port->rbuf_ptr = 0;
+        port->rbuf_cnt = held;
+        }
+    room = SER_RBUF_SIZE - port->rbuf_cnt;
+    read_count = read (port->port, (void *) (rbuf + port->rbuf_cnt), (size_t) room);/* drain the kernel buffer */
+    if (read_count == -1) {                                 /* read error? */
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {  /* something other than no characters available? */
+            sim_error_serial ("read", errno);               /* report unexpected error */
+            if (held == 0)
+                return -1;
             }
-
-        cptr = bptr + 1;                                    /* point at remainder of string */
+        }
+    else {
+        port->rbuf_cnt = port->rbuf_cnt + read_count;
+        ++port->reads;
+        port->read_bytes = port->read_bytes + read_count;
         }
     }
-
-return (int32) read_count;                                  /* return the number of characters read */
+else
+    ++port->buffered_reads;
+
+while ((n < count) && (port->rbuf_ptr < port->rbuf_cnt)) {  /* decode into the caller's buffer */
+    len = port->rbuf_cnt - port->rbuf_ptr;
+    if (len > count - n)
+        len = count - n;
+    bptr = (char *) memchr (rbuf + port->rbuf_ptr, '\377', len);/* search for start of PARMRK sequence */
+    if (bptr)
+        len = (int32) (bptr - (rbuf + port->rbuf_ptr));
+    memcpy (buffer + n, rbuf + port->rbuf_ptr, len);        /* copy the plain run */
+    n = n + len;
+    port->rbuf_ptr = port->rbuf_ptr + len;
+    if (bptr == NULL)
+        continue;
+    held = port->rbuf_cnt - port->rbuf_ptr;
+    if (held < 2)                                           /* sequence split across reads? */
+        break;                                              /*   hold it until the rest arrives */
+    if (bptr[1] == '\377') {                                /* is it a \377 \377 sequence? */
+        buffer[n++] = '\377';
+        port->rbuf_ptr = port->rbuf_ptr + 2;
+        }
+    else if (bptr[1] == '\0') {                             /* is it a \377 \000 \ccc sequence? */
+        if (held < 3)                                       /* sequence split across reads? */
+            break;                                          /*   hold it until the rest arrives */
+        buffer[n] = bptr[2];
+        if (bptr[2] == '\0')                                /* is it a BREAK sequence? */
+            brk[n] = 1;                                     /* set corresponding BREAK flag */
+        ++n;
+        port->rbuf_ptr = port->rbuf_ptr + 3;
+        }
+    else {                                                  /* not a sequence we know */
+        buffer[n++] = '\377';
+        port->rbuf_ptr = port->rbuf_ptr + 1;
+        }
+    }
+if (port->rbuf_ptr == port->rbuf_cnt)                       /* everything consumed? */
+    port->rbuf_ptr = port->rbuf_cnt = 0;
+return n;                                                   /* return the number of characters read */
 }
 
 
@@ -1387,6 +1469,7 @@ int32 sim_write_serial (SERHANDLE port, char *buffer, int32 count)
 int written;
 
 written = write (port->port, (void *) buffer, (size_t) count);/* write the buffer to the serial port */
+++port->writes;
 
 if (written == -1) {
     if (errno == EWOULDBLOCK)
@@ -1398,6 +1481,8 @@ if (written == -1) {
     else                                                    /* unexpected error? */
         sim_error_serial ("write", errno);                  /* report it */
     }
+else
+    port->write_bytes = port->write_bytes + written;
 
 return (int32) written;                                     /* return number of characters written */
 }
@@ -1415,6 +1500,18 @@ free (port);
 }
 
 
+/* Show serial port statistics */
+
+static void sim_show_os_serial (FILE *st, SERHANDLE port)
+{
+if (port->reads || port->writes)
+    fprintf (st, "\tReads: %u (%u bytes, %u buffered)  Writes: %u (%u bytes)\n",
+                 port->reads, port->read_bytes, port->buffered_reads, port->writes, port->write_bytes);
+if (port->modem_gets)
+    fprintf (st, "\tModem Status: %u fetched, %u cached\n", port->modem_gets, port->modem_cached);
+}
+
+
 #elif defined (VMS)
 
 /* VMS implementation */
@@ -1851,6 +1948,13 @@ sys$dassgn (port->port);                                /* close the port */
 free (port);
 }
 
+
+/* Show serial port statistics */
+
+static void sim_show_os_serial (FILE *st, SERHANDLE port)
+{
+}
+
 #else
 
 /* Non-implemented stubs */
@@ -1909,5 +2013,12 @@ static void sim_close_os_serial (SERHANDLE port)
 }
 
 
+/* Show serial port statistics */
+
+static void sim_show_os_serial (FILE *st, SERHANDLE port)
+{
+}
+
+
 
 #endif                                                  /* end else !implemented */
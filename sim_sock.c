@@ -50,6 +50,7 @@ extern "C" {
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <ctype.h>
 
 #if defined(AF_INET6) && defined(_WIN32)
 #include <ws2tcpip.h>
@@ -71,6 +72,12 @@ extern "C" {
 #define   NI_MAXHOST 1025
 #endif
 
+#if defined(AF_UNIX) && !defined(_WIN32) && !defined(VMS)
+#include <sys/un.h>                                     /* for sockaddr_un */
+#include <sys/stat.h>
+#define SIM_SOCK_UNIX   1                               /* Unix domain socket paths supported */
+#endif
+
 /* OS dependent routines
 
    sim_master_sock      create master socket
@@ -505,14 +512,38 @@ int load_ws2(void) {
 
    sim_parse_addr       parse a hostname/ipaddress from port and apply defaults and 
                         optionally validate an address match
+   sim_unix_sock_path   identify a Unix domain socket specifier
+*/
+
+/* sim_unix_sock_path   unix:path
+
+   Returns a pointer to the path portion of a Unix domain socket specifier 
+   or NULL if the input isn't of that form.
 */
 
+const char *sim_unix_sock_path (const char *cptr)
+{
+static const char prefix[] = "unix:";
+size_t i;
+
+if (cptr == NULL)
+    return NULL;
+for (i = 0; i < sizeof (prefix) - 1; i++)
+    if ((cptr[i] == '\0') || (tolower ((unsigned char)cptr[i]) != prefix[i]))
+        return NULL;
+return cptr + i;
+}
+
 /* sim_parse_addr       host:port
 
    Presumption is that the input, if it doesn't contain a ':' character is a port specifier.
    If the host field contains one or more colon characters (i.e. it is an IPv6 address), 
    the IPv6 address MUST be enclosed in square bracket characters (i.e. Domain Literal format)
 
+   A Unix domain socket is specified as unix:path.  The host result is then
+   "unix" and the port result is the socket path.  A Unix domain socket 
+   only validates against another Unix domain socket address.
+
    Inputs:
         cptr    =       pointer to input string
         default_host
@@ -546,6 +577,30 @@ if ((host != NULL) && (host_len != 0))
     memset (host, 0, host_len);
 if ((port != NULL) && (port_len != 0))
     memset (port, 0, port_len);
+if (sim_unix_sock_path (cptr)) {                        /* unix:path? */
+    const char *path = sim_unix_sock_path (cptr);
+
+#if defined (SIM_SOCK_UNIX)
+    if ((*path == '\0') || 
+        (strlen (path) >= sizeof (((struct sockaddr_un *)0)->sun_path)))
+        return -1;                                      /* empty or too long path */
+#else
+    return -1;                                          /* not supported on this host */
+#endif
+    if (host) {
+        if (host_len <= strlen ("unix"))
+            return -1;                                  /* no room */
+        strcpy (host, "unix");
+        }
+    if (port) {
+        if (port_len <= strlen (path))
+            return -1;                                  /* no room */
+        strcpy (port, path);
+        }
+    if (validate_addr)
+        return (sim_unix_sock_path (validate_addr) ? 0 : -1);
+    return 0;
+    }
 if ((cptr == NULL) || (*cptr == 0)) {
     if (((default_host == NULL) || (*default_host == 0)) || ((default_port == NULL) || (*default_port == 0)))
         return -1;
@@ -836,6 +891,113 @@ if (newsock == INVALID_SOCKET) {                        /* socket error? */
 return newsock;
 }
 
+#if defined (SIM_SOCK_UNIX)
+/*
+   Unix domain stream sockets carry the same byte streams as TCP connections 
+   between processes on the local host without passing through the network 
+   stack.  A listening socket's path is removed when it is closed.  A socket
+   left behind by a prior run is removed before binding, but only when
+   nothing is listening on it any more; a path which still has a listener
+   is in use, just as a bound tcp port is.
+*/
+
+static int _sim_unix_sock_addr (struct sockaddr_un *addr, const char *path)
+{
+size_t len = strlen (path);
+
+memset (addr, 0, sizeof (*addr));
+addr->sun_family = AF_UNIX;
+if (len >= sizeof (addr->sun_path)) {                   /* checked when parsed */
+    WSASetLastError (WSAENAMETOOLONG);
+    return -1;
+    }
+memcpy (addr->sun_path, path, len);
+return 0;
+}
+
+static SOCKET _sim_unix_master_sock (const char *path, int opt_flags)
+{
+SOCKET newsock;
+struct sockaddr_un addr;
+struct stat statb;
+int sta;
+
+if (_sim_unix_sock_addr (&addr, path))
+    return INVALID_SOCKET;
+newsock = sim_create_sock (AF_UNIX, 0);                 /* create socket */
+if (newsock == INVALID_SOCKET)                          /* socket error? */
+    return newsock;
+if ((0 == stat (path, &statb)) && S_ISSOCK (statb.st_mode)) {
+    SOCKET probe = sim_create_sock (AF_UNIX, 0);        /* anyone listening? */
+    int err = 0;
+
+    if (probe == INVALID_SOCKET) {
+        sim_close_sock (newsock);
+        return probe;
+        }
+    if ((SOCKET_ERROR == sim_setnonblock (probe)) ||
+        (SOCKET_ERROR == connect (probe, (struct sockaddr *)&addr, sizeof (addr))))
+        err = WSAGetLastError ();
+    sim_close_sock (probe);
+    if (err != WSAECONNREFUSED) {                       /* live listener? */
+        WSASetLastError (WSAEADDRINUSE);
+        return sim_err_sock (newsock, "bind");
+        }
+    (void)unlink (path);                                /* remove stale socket */
+    }
+sta = bind (newsock, (struct sockaddr *)&addr, sizeof (addr));
+if (sta == SOCKET_ERROR)                                /* bind error? */
+    return sim_err_sock (newsock, "bind");
+if (!(opt_flags & SIM_SOCK_OPT_BLOCKING)) {
+    sta = sim_setnonblock (newsock);                    /* set nonblocking */
+    if (sta == SOCKET_ERROR) {                          /* fcntl error? */
+        (void)unlink (path);
+        return sim_err_sock (newsock, "fcntl");
+        }
+    }
+sta = listen (newsock, 64);                             /* listen on socket */
+if (sta == SOCKET_ERROR) {                              /* listen error? */
+    (void)unlink (path);
+    return sim_err_sock (newsock, "listen");
+    }
+return newsock;                                         /* got it! */
+}
+
+static SOCKET _sim_unix_connect_sock (const char *path, int opt_flags)
+{
+SOCKET newsock;
+struct sockaddr_un addr;
+int sta, err;
+
+if (_sim_unix_sock_addr (&addr, path))
+    return INVALID_SOCKET;
+newsock = sim_create_sock (AF_UNIX, 0);                 /* create socket */
+if (newsock == INVALID_SOCKET)                          /* socket error? */
+    return newsock;
+if (!(opt_flags & SIM_SOCK_OPT_BLOCKING)) {
+    sta = sim_setnonblock (newsock);                    /* set nonblocking */
+    if (sta == SOCKET_ERROR)                            /* fcntl error? */
+        return sim_err_sock (newsock, "fcntl");
+    }
+sta = connect (newsock, (struct sockaddr *)&addr, sizeof (addr));
+if (sta == SOCKET_ERROR) {
+    err = WSAGetLastError ();
+    if ((err == WSAECONNREFUSED) ||                     /* nobody listening */
+        (err == ENOENT)) {                              /* or no socket there yet */
+        if (opt_flags & SIM_SOCK_OPT_BLOCKING) {
+            sim_close_sock (newsock);
+            return INVALID_SOCKET;
+            }
+        return newsock;                                 /* failure seen by sim_check_conn like TCP */
+        }
+    if ((err != WSAEWOULDBLOCK) &&                      /* listen backlog full */
+        (err != WSAEINPROGRESS))
+        return sim_err_sock (newsock, "connect");
+    }
+return newsock;                                         /* got it! */
+}
+#endif
+
 /*
    Some platforms and/or network stacks have varying support for listening on 
    an IPv6 socket and receiving connections from both IPv4 and IPv6 client 
@@ -857,6 +1019,10 @@ if (parse_status)
     *parse_status = r;
 if (r)
     return newsock;
+#if defined (SIM_SOCK_UNIX)
+if (sim_unix_sock_path (hostport))
+    return _sim_unix_master_sock (port, opt_flags);
+#endif
 
 memset(&hints, 0, sizeof(hints));
 hints.ai_flags = AI_PASSIVE;
@@ -942,6 +1108,13 @@ struct addrinfo *result = NULL, *source = NULL;
 
 if (sim_parse_addr (hostport, host, sizeof(host), default_host, port, sizeof(port), default_port, NULL))
     return INVALID_SOCKET;
+#if defined (SIM_SOCK_UNIX)
+if (sim_unix_sock_path (hostport)) {
+    if ((sourcehostport) || (opt_flags & SIM_SOCK_OPT_DATAGRAM))
+        return INVALID_SOCKET;                          /* stream connections only */
+    return _sim_unix_connect_sock (port, opt_flags);
+    }
+#endif
 
 memset(&hints, 0, sizeof(hints));
 hints.ai_family = AF_UNSPEC;
@@ -1056,6 +1229,10 @@ size_t size;
 #endif
 SOCKET newsock;
 struct sockaddr_storage clientname;
+#if defined (SIM_SOCK_UNIX)
+struct sockaddr_un local;
+socklen_t local_size = (socklen_t)sizeof (local);
+#endif
 
 if (master == 0)                                        /* not attached? */
     return INVALID_SOCKET;
@@ -1068,6 +1245,22 @@ if (newsock == INVALID_SOCKET) {                        /* error? */
         sim_err_sock(newsock, "accept");
     return INVALID_SOCKET;
     }
+#if defined (SIM_SOCK_UNIX)
+memset (&local, 0, sizeof (local));                     /* accept may not describe an unnamed peer */
+if ((0 == getsockname (master, (struct sockaddr *)&local, &local_size)) &&
+    (local.sun_family == AF_UNIX)) {                    /* Unix domain connection? */
+    if (connectaddr != NULL) {
+        *connectaddr = (char *)calloc(1, NI_MAXHOST+1);
+        snprintf (*connectaddr, NI_MAXHOST, "unix:%s", local.sun_path);
+        }
+    if (!(opt_flags & SIM_SOCK_OPT_BLOCKING)) {
+        sta = sim_setnonblock (newsock);                /* set nonblocking */
+        if (sta == SOCKET_ERROR)                        /* fcntl error? */
+            return sim_err_sock (newsock, "fcntl");
+        }
+    return newsock;                                     /* no TCP options apply */
+    }
+#endif
 if (connectaddr != NULL) {
     *connectaddr = (char *)calloc(1, NI_MAXHOST+1);
 #ifdef AF_INET6
@@ -1202,6 +1395,15 @@ if (peernamebuf)
     *peernamebuf = (char *)calloc(1, NI_MAXHOST+NI_MAXSERV+4);
 (void)getsockname (sock, (struct sockaddr *)&sockname, &socknamesize);
 (void)getpeername (sock, (struct sockaddr *)&peername, &peernamesize);
+#if defined (SIM_SOCK_UNIX)
+if (sockname.ss_family == AF_UNIX) {
+    if (socknamebuf != NULL)
+        snprintf (*socknamebuf, NI_MAXHOST+NI_MAXSERV+4, "unix:%s", ((struct sockaddr_un *)&sockname)->sun_path);
+    if (peernamebuf != NULL)
+        snprintf (*peernamebuf, NI_MAXHOST+NI_MAXSERV+4, "unix:%s", ((struct sockaddr_un *)&peername)->sun_path);
+    return 0;
+    }
+#endif
 if (socknamebuf != NULL) {
     _sim_getaddrname ((struct sockaddr *)&sockname, (size_t)socknamesize, hostbuf, portbuf);
     sprintf(*socknamebuf, "[%s]:%s", hostbuf, portbuf);
@@ -1259,6 +1461,19 @@ return sbytes;
 
 void sim_close_sock (SOCKET sock)
 {
+#if defined (SIM_SOCK_UNIX) && defined (SO_ACCEPTCONN)
+struct sockaddr_un addr;
+socklen_t addr_size = (socklen_t)sizeof (addr);
+int listening = 0;
+socklen_t listening_size = (socklen_t)sizeof (listening);
+
+memset (&addr, 0, sizeof (addr));
+if ((0 == getsockname (sock, (struct sockaddr *)&addr, &addr_size)) &&
+    (addr.sun_family == AF_UNIX) && (addr.sun_path[0] != '\0') &&
+    (0 == getsockopt (sock, SOL_SOCKET, SO_ACCEPTCONN, (char *)&listening, &listening_size)) &&
+    listening)
+    (void)unlink (addr.sun_path);                       /* remove listening socket's path */
+#endif
 shutdown(sock, SD_BOTH);
 closesocket (sock);
 }
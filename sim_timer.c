@@ -65,8 +65,10 @@
    sim_rtc_calb -           calibrate clock
    sim_idle -               virtual machine idle
    sim_os_msec  -           return elapsed time in msec
+   sim_os_nsec  -           return monotonic time in nsec
    sim_os_sleep -           sleep specified number of seconds
    sim_os_ms_sleep -        sleep specified number of milliseconds
+   sim_os_ns_sleep_until -  sleep until specified sim_os_nsec time
    sim_idle_ms_sleep -      sleep specified number of milliseconds
                             or until awakened by an asynchronous
                             event
@@ -86,6 +88,7 @@
 #define NOT_MUX_USING_CODE /* sim_tmxr library provider or agnostic */
 
 #include "sim_defs.h"
+#include "sim_tmxr.h"
 #include <ctype.h>
 #include <math.h>
 
@@ -98,6 +101,9 @@
 #define MAX(a,b)  (((a) > (b)) ? (a) : (b))
 #endif
 
+#define NS_PER_MS           ((t_uint64)1000000)
+#define NS_PER_SEC          ((t_uint64)1000000000)
+
 uint32 sim_idle_ms_sleep (unsigned int msec);
 
 /* MS_MIN_GRANULARITY exists here so that timing behavior for hosts systems  */
@@ -110,6 +116,7 @@ uint32 sim_idle_ms_sleep (unsigned int msec);
 uint32 real_sim_idle_ms_sleep (unsigned int msec);
 uint32 real_sim_os_msec (void);
 uint32 real_sim_os_ms_sleep (unsigned int msec);
+t_uint64 real_sim_os_nsec (void);
 static uint32 real_sim_os_sleep_min_ms = 0;
 static uint32 real_sim_os_sleep_inc_ms = 0;
 
@@ -138,6 +145,11 @@ uint32 sim_os_msec (void)
 return (real_sim_os_msec ()/MS_MIN_GRANULARITY)*MS_MIN_GRANULARITY;
 }
 
+t_uint64 sim_os_nsec (void)
+{
+return (real_sim_os_nsec ()/(MS_MIN_GRANULARITY*NS_PER_MS))*(MS_MIN_GRANULARITY*NS_PER_MS);
+}
+
 uint32 sim_os_ms_sleep (unsigned int msec)
 {
 msec = MS_MIN_GRANULARITY*((msec+MS_MIN_GRANULARITY-1)/MS_MIN_GRANULARITY);
@@ -161,10 +173,19 @@ static uint32 sim_os_clock_resoluton_ms = 0;
 static uint32 sim_os_tick_hz = 0;
 static uint32 sim_idle_stable = SIM_IDLE_STDFLT;
 static uint32 sim_idle_calib_pct = 0;
+static t_bool sim_idle_tickless = FALSE;           /* sleep across clock ticks */
+static uint32 sim_idle_tickless_max = SIM_IDLE_TLDFLT;/* longest tickless sleep (ms) */
+static t_bool sim_idle_tickless_backoff = FALSE;   /* last tickless sleep was cut short */
+static uint32 sim_idle_tickless_sleeps = 0;        /* tickless sleeps taken */
+static uint32 sim_idle_tickless_early = 0;         /* tickless sleeps cut short */
+static uint32 sim_idle_tickless_ticks = 0;         /* clock ticks slept through */
+static double sim_idle_tickless_time = 0;          /* ms spent in tickless sleeps */
 static double sim_timer_stop_time = 0;
 static uint32 sim_rom_delay = 0;
 static uint32 sim_throt_ms_start = 0;
 static uint32 sim_throt_ms_stop = 0;
+static t_uint64 sim_throt_ns_start = 0;
+static t_uint64 sim_throt_ns_stop = 0;
 static uint32 sim_throt_type = 0;
 static uint32 sim_throt_val = 0;
 static uint32 sim_throt_drift_pct = SIM_THROT_DRIFT_PCT_DFLT;
@@ -175,6 +196,23 @@ static double sim_throt_inst_start;
 static uint32 sim_throt_sleep_time = 0;
 static int32 sim_throt_wait = 0;
 static uint32 sim_throt_delay = 3;
+static t_bool sim_throt_paced = FALSE;                  /* PID paced throttling */
+static uint32 sim_throt_pace_us = SIM_THROT_PACE_DFLT;  /* paced interval (usecs) */
+static t_uint64 sim_throt_pace_epoch;                   /* host time pacing started */
+static double sim_throt_pace_inst_epoch;                /* instruction time pacing started */
+static t_uint64 sim_throt_pace_next;                    /* end of current interval */
+static t_uint64 sim_throt_pace_last;                    /* host time of last interval */
+static double sim_throt_pace_inst_last;                 /* instruction time of last interval */
+static double sim_throt_pace_integral;                  /* accumulated schedule error */
+static double sim_throt_pace_err;                       /* schedule error (insts behind) */
+static double sim_throt_pace_err_max;                   /* peak schedule error */
+static uint32 sim_throt_pace_intervals;                 /* intervals paced */
+static uint32 sim_throt_pace_late;                      /* intervals which overran */
+static uint32 sim_throt_pace_resyncs;                   /* schedule resynchronizations */
+static double sim_throt_pace_overshoot;                 /* total sleep overshoot (ns) */
+static double sim_throt_pace_overshoot_max;             /* peak sleep overshoot (ns) */
+static int32 sim_throt_pace_wait_min;                   /* smallest interval cycles */
+static int32 sim_throt_pace_wait_max;                   /* largest interval cycles */
 #define CLK_TPS 10
 #define CLK_INIT (SIM_INITIAL_IPS/CLK_TPS)
 static int32 sim_int_clk_tps;
@@ -230,6 +268,7 @@ return sim_os_sleep_min_ms;
 #define sim_idle_ms_sleep   real_sim_idle_ms_sleep 
 #define sim_os_msec         real_sim_os_msec 
 #define sim_os_ms_sleep     real_sim_os_ms_sleep
+#define sim_os_nsec         real_sim_os_nsec
 
 #endif /* defined(MS_MIN_GRANULARITY) && (MS_MIN_GRANULARITY != 1) */
 
@@ -271,6 +310,10 @@ return sim_os_ms_sleep (msec);
 /* allowing the feature and/or platform dependent code to provide it */
 #define NEED_THREAD_PRIORITY
 
+/* Likewise for the nanosecond monotonic clock and sleep routines, */
+/* which hosts without a native source derive from sim_os_msec */
+#define NEED_OS_NSEC
+
 /* If we've got pthreads support then use pthreads mechanisms */
 #if defined(USE_READER_THREAD)
 
@@ -454,6 +497,31 @@ Sleep (msec);
 return sim_os_msec () - stime;
 }
 
+#undef NEED_OS_NSEC
+t_uint64 sim_os_nsec (void)
+{
+static LARGE_INTEGER freq = { 0 };
+LARGE_INTEGER now;
+
+if ((freq.QuadPart == 0) && 
+    (!QueryPerformanceFrequency (&freq)))
+    freq.QuadPart = -1;
+if ((freq.QuadPart <= 0) ||
+    (!QueryPerformanceCounter (&now)))
+    return ((t_uint64)timeGetTime ()) * NS_PER_MS;
+return (((t_uint64)(now.QuadPart / freq.QuadPart)) * NS_PER_SEC) + 
+       ((((t_uint64)(now.QuadPart % freq.QuadPart)) * NS_PER_SEC) / freq.QuadPart);
+}
+
+t_uint64 sim_os_ns_sleep_until (t_uint64 deadline)
+{
+t_uint64 now = sim_os_nsec ();
+
+if (deadline > now + NS_PER_MS)                 /* Sleep() only has ms resolution */
+    Sleep ((DWORD)((deadline - now) / NS_PER_MS));
+return sim_os_nsec ();
+}
+
 #if defined(NEED_CLOCK_GETTIME)
 int clock_gettime(int clk_id, struct timespec *tp)
 {
@@ -622,6 +690,45 @@ treq.tv_nsec = (milliseconds % MILLIS_PER_SEC) * NANOS_PER_MILLI;
 return sim_os_msec () - stime;
 }
 
+#undef NEED_OS_NSEC
+t_uint64 sim_os_nsec (void)
+{
+struct timeval cur;
+
+#if defined(CLOCK_MONOTONIC)
+struct timespec now;
+
+if (clock_gettime (CLOCK_MONOTONIC, &now) == 0)
+    return (((t_uint64)now.tv_sec) * NS_PER_SEC) + (t_uint64)now.tv_nsec;
+#endif
+gettimeofday (&cur, NULL);
+return (((t_uint64)cur.tv_sec) * NS_PER_SEC) + (((t_uint64)cur.tv_usec) * 1000);
+}
+
+/* Sleep until an absolute sim_os_nsec time.  Sleeping to an absolute */
+/* deadline keeps the wakeup latency of one sleep from accumulating */
+/* into the next one the way successive relative sleeps do */
+
+t_uint64 sim_os_ns_sleep_until (t_uint64 deadline)
+{
+struct timespec treq;
+t_uint64 now = sim_os_nsec ();
+
+if (deadline <= now)
+    return now;
+#if defined(CLOCK_MONOTONIC) && defined(TIMER_ABSTIME) && defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0)
+treq.tv_sec = (time_t)(deadline / NS_PER_SEC);
+treq.tv_nsec = (long)(deadline % NS_PER_SEC);
+while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &treq, NULL) == EINTR)
+    ;
+#else
+treq.tv_sec = (time_t)((deadline - now) / NS_PER_SEC);
+treq.tv_nsec = (long)((deadline - now) % NS_PER_SEC);
+(void) nanosleep (&treq, NULL);
+#endif
+return sim_os_nsec ();
+}
+
 #if defined(NEED_THREAD_PRIORITY)
 #undef NEED_THREAD_PRIORITY
 #include <sys/time.h>
@@ -663,11 +770,35 @@ return SCPE_OK;
 }
 #endif
 
+/* Hosts without a native nanosecond clock extend the millisecond one */
+#if defined(NEED_OS_NSEC)
+t_uint64 sim_os_nsec (void)
+{
+static uint32 last_msec = 0;
+static t_uint64 nsec = 0;
+uint32 msec = sim_os_msec ();
+
+nsec += ((t_uint64)(uint32)(msec - last_msec)) * NS_PER_MS;/* 32 bit wrap safe */
+last_msec = msec;
+return nsec;
+}
+
+t_uint64 sim_os_ns_sleep_until (t_uint64 deadline)
+{
+t_uint64 now = sim_os_nsec ();
+
+if (deadline > now)
+    sim_os_ms_sleep ((unsigned int)((deadline - now) / NS_PER_MS));
+return sim_os_nsec ();
+}
+#endif
+
 #if defined(MS_MIN_GRANULARITY) && (MS_MIN_GRANULARITY != 1)
 /* Make sure to use the substitute routines */
 #undef sim_idle_ms_sleep
 #undef sim_os_msec
 #undef sim_os_ms_sleep
+#undef sim_os_nsec
 #endif /* defined(MS_MIN_GRANULARITY) && (MS_MIN_GRANULARITY != 1) */
 
 /* diff = min - sub */
@@ -695,6 +826,7 @@ while (diff->tv_nsec > 1000000000) {
 static double _timespec_to_double (struct timespec *time);
 static void _double_to_timespec (struct timespec *time, double dtime);
 static t_bool _rtcn_tick_catchup_check (int32 tmr, int32 time);
+static t_bool _sim_idle_tickless (uint32 tmr);
 static void _rtcn_configure_calibrated_clock (int32 newtmr);
 static t_bool _sim_coschedule_cancel (UNIT *uptr);
 static t_bool _sim_wallclock_cancel (UNIT *uptr);
@@ -731,10 +863,10 @@ else
 static int32 rtc_ticks[SIM_NTIMERS+1] = { 0 };            /* ticks */
 static uint32 rtc_hz[SIM_NTIMERS+1] = { 0 };              /* tick rate */
 static uint32 rtc_last_hz[SIM_NTIMERS+1] = { 0 };         /* prior tick rate */
-static uint32 rtc_rtime[SIM_NTIMERS+1] = { 0 };           /* real time */
-static uint32 rtc_vtime[SIM_NTIMERS+1] = { 0 };           /* virtual time */
+static t_uint64 rtc_rtime[SIM_NTIMERS+1] = { 0 };         /* real time (ns) */
+static t_uint64 rtc_vtime[SIM_NTIMERS+1] = { 0 };         /* virtual time (ns) */
 static double rtc_gtime[SIM_NTIMERS+1] = { 0 };           /* instruction time */
-static uint32 rtc_nxintv[SIM_NTIMERS+1] = { 0 };          /* next interval */
+static uint32 rtc_nxintv[SIM_NTIMERS+1] = { 0 };          /* next interval (ns) */
 static int32 rtc_based[SIM_NTIMERS+1] = { 0 };            /* base delay */
 static int32 rtc_currd[SIM_NTIMERS+1] = { 0 };            /* current delay */
 static int32 rtc_initd[SIM_NTIMERS+1] = { 0 };            /* initial delay */
@@ -762,6 +894,11 @@ static uint32 rtc_clock_time_idled_last[SIM_NTIMERS+1] = { 0 };/* total time idl
 static uint32 rtc_clock_calib_skip_idle[SIM_NTIMERS+1] = { 0 };/* Calibrations skipped due to idling */
 static uint32 rtc_clock_calib_gap2big[SIM_NTIMERS+1] = { 0 };/* Calibrations skipped Gap Too Big */
 static uint32 rtc_clock_calib_backwards[SIM_NTIMERS+1] = { 0 };/* Calibrations skipped Clock Running Backwards */
+static t_uint64 rtc_tick_last_ns[SIM_NTIMERS+1] = { 0 };  /* host time of prior tick */
+static uint32 rtc_tick_jitter_samples[SIM_NTIMERS+1] = { 0 };/* tick intervals measured */
+static double rtc_tick_jitter_sum[SIM_NTIMERS+1] = { 0 }; /* sum of interval deviations (ns) */
+static double rtc_tick_jitter_sumsq[SIM_NTIMERS+1] = { 0 };/* sum of squared interval deviations */
+static double rtc_tick_jitter_max[SIM_NTIMERS+1] = { 0 }; /* largest interval deviation (ns) */
 static uint32 sim_idle_cyc_ms = 0;                      /* Cycles per millisecond while not idling */
 
 UNIT sim_timer_units[SIM_NTIMERS+1];                    /* Clock assist units                         */
@@ -845,10 +982,11 @@ if (uptr) {
         sim_register_clock_unit_tmr (uptr, tmr);
     }
 rtc_clock_start_gtime[tmr] = sim_gtime();
-rtc_rtime[tmr] = sim_os_msec ();
+rtc_rtime[tmr] = sim_os_nsec ();
 rtc_vtime[tmr] = rtc_rtime[tmr];
-rtc_nxintv[tmr] = 1000;
+rtc_nxintv[tmr] = (uint32)NS_PER_SEC;
 rtc_ticks[tmr] = 0;
+rtc_tick_last_ns[tmr] = 0;
 rtc_last_hz[tmr] = rtc_hz[tmr];
 rtc_hz[tmr] = 0;
 rtc_based[tmr] = time;
@@ -872,10 +1010,33 @@ _rtcn_configure_calibrated_clock (tmr);
 return time;
 }
 
+/* Record how far the host interval since the prior tick strayed from  */
+/* the nominal tick size.  Catchup ticks are deliberately early, so they  */
+/* only move the reference point.                                         */
+
+static void _rtcn_tick_jitter (int32 tmr, t_bool catchup)
+{
+t_uint64 now = sim_os_nsec ();
+double dev;
+
+if ((!catchup) && (rtc_tick_last_ns[tmr] != 0) && (now >= rtc_tick_last_ns[tmr])) {
+    dev = (double)(now - rtc_tick_last_ns[tmr]) - ((double)NS_PER_SEC / rtc_hz[tmr]);
+    if (fabs (dev) < (double)NS_PER_SEC) {          /* ignore host stalls */
+        ++rtc_tick_jitter_samples[tmr];
+        rtc_tick_jitter_sum[tmr] += dev;
+        rtc_tick_jitter_sumsq[tmr] += dev * dev;
+        if (fabs (dev) > rtc_tick_jitter_max[tmr])
+            rtc_tick_jitter_max[tmr] = fabs (dev);
+        }
+    }
+rtc_tick_last_ns[tmr] = now;
+}
+
 int32 sim_rtcn_calb (int32 ticksper, int32 tmr)
 {
-uint32 new_rtime, delta_rtime, last_idle_pct;
-int32 delta_vtime;
+t_uint64 new_rtime, delta_rtime;
+uint32 last_idle_pct;
+double delta_vtime;
 double new_gtime;
 int32 new_currd;
 int32 itmr;
@@ -899,6 +1060,7 @@ if (rtc_hz[tmr] != ticksper) {                          /* changing tick rate? *
     }
 if (ticksper == 0)                                      /* running? */
     return 10000;
+_rtcn_tick_jitter (tmr, rtc_clock_catchup_pending[tmr]);
 if (sim_clock_unit[tmr] == NULL) {                      /* Not using TIMER units? */
     rtc_clock_ticks[tmr] += 1;
     rtc_calib_tick_time[tmr] += rtc_clock_tick_size[tmr];
@@ -919,22 +1081,21 @@ if (sim_calb_tmr != tmr) {
     sim_debug (DBG_CAL, &sim_timer_dev, "calibrated tmr=%d against internal system tmr=%d, tickper=%d (result: %d)\n", tmr, sim_calb_tmr, ticksper, rtc_currd[tmr]);
     return rtc_currd[tmr];
     }
-new_rtime = sim_os_msec ();                             /* wall time */
+new_rtime = sim_os_nsec ();                             /* wall time */
 ++rtc_calibrations[tmr];                                /* count calibrations */
 sim_debug (DBG_TRC, &sim_timer_dev, "sim_rtcn_calb(ticksper=%d, tmr=%d)\n", ticksper, tmr);
 if (new_rtime < rtc_rtime[tmr]) {                       /* time running backwards? */
-    /* This happens when the value returned by sim_os_msec wraps (as an uint32) */
-    /* Wrapping will happen initially sometime before a simulator has been running */
-    /* for 49 days approximately every 49 days thereafter. */
+    /* The host clock is monotonic where one is available, but hosts */
+    /* which lack one fall back to a clock which can be set backwards. */
     ++rtc_clock_calib_backwards[tmr];                   /* Count statistic */
-    sim_debug (DBG_CAL, &sim_timer_dev, "time running backwards - OldTime: %u, NewTime: %u, result: %d\n", rtc_rtime[tmr], new_rtime, rtc_currd[tmr]);
+    sim_debug (DBG_CAL, &sim_timer_dev, "time running backwards - OldTime: %" LL_FMT "u, NewTime: %" LL_FMT "u, result: %d\n", rtc_rtime[tmr], new_rtime, rtc_currd[tmr]);
     rtc_rtime[tmr] = new_rtime;                         /* reset wall time */
     return rtc_currd[tmr];                              /* can't calibrate */
     }
 delta_rtime = new_rtime - rtc_rtime[tmr];               /* elapsed wtime */
 rtc_rtime[tmr] = new_rtime;                             /* adv wall time */
-rtc_vtime[tmr] = rtc_vtime[tmr] + 1000;                 /* adv sim time */
-if (delta_rtime > 30000) {                              /* gap too big? */
+rtc_vtime[tmr] = rtc_vtime[tmr] + NS_PER_SEC;           /* adv sim time */
+if (delta_rtime > 30*NS_PER_SEC) {                      /* gap too big? */
     /* This simulator process has somehow been suspended for a significant */
     /* amount of time.  This will certainly happen if the host system has  */
     /* slept or hibernated.  It also might happen when a simulator         */
@@ -943,19 +1104,19 @@ if (delta_rtime > 30000) {                              /* gap too big? */
     /* ignore what happened and proceed from here.                         */
     ++rtc_clock_calib_gap2big[tmr];                     /* Count statistic */
     rtc_vtime[tmr] = rtc_rtime[tmr];                    /* sync virtual and real time */
-    rtc_nxintv[tmr] = 1000;                             /* reset next interval */
+    rtc_nxintv[tmr] = (uint32)NS_PER_SEC;               /* reset next interval */
     rtc_gtime[tmr] = sim_gtime();                       /* save instruction time */
-    sim_debug (DBG_CAL, &sim_timer_dev, "gap too big: delta = %d - result: %d\n", delta_rtime, rtc_currd[tmr]);
+    sim_debug (DBG_CAL, &sim_timer_dev, "gap too big: delta = %d ms - result: %d\n", (int)(delta_rtime / NS_PER_MS), rtc_currd[tmr]);
     return rtc_currd[tmr];                              /* can't calibr */
     }
 if (delta_rtime == 0)                                   /* avoid divide by zero  */
     last_idle_pct = 0;                                  /* force calibration */
 else
-    last_idle_pct = MIN(100, (uint32)(100.0 * (((double)(rtc_clock_time_idled[tmr] - rtc_clock_time_idled_last[tmr])) / ((double)delta_rtime))));
+    last_idle_pct = MIN(100, (uint32)(100.0 * (((double)(rtc_clock_time_idled[tmr] - rtc_clock_time_idled_last[tmr]) * NS_PER_MS) / ((double)delta_rtime))));
 rtc_clock_time_idled_last[tmr] = rtc_clock_time_idled[tmr];
 if (last_idle_pct > (100 - sim_idle_calib_pct)) {
     rtc_rtime[tmr] = new_rtime;                         /* save wall time */
-    rtc_vtime[tmr] = rtc_vtime[tmr] + 1000;             /* adv sim time */
+    rtc_vtime[tmr] = rtc_vtime[tmr] + NS_PER_SEC;       /* adv sim time */
     rtc_gtime[tmr] = sim_gtime();                       /* save instruction time */
     ++rtc_clock_calib_skip_idle[tmr];
     sim_debug (DBG_CAL, &sim_timer_dev, "skipping calibration due to idling (%d%%) - result: %d\n", last_idle_pct, rtc_currd[tmr]);
@@ -963,7 +1124,7 @@ if (last_idle_pct > (100 - sim_idle_calib_pct)) {
     }
 new_gtime = sim_gtime();
 if ((last_idle_pct == 0) && (delta_rtime != 0))
-    sim_idle_cyc_ms = (uint32)((new_gtime - rtc_gtime[tmr]) / delta_rtime);
+    sim_idle_cyc_ms = (uint32)(((new_gtime - rtc_gtime[tmr]) * NS_PER_MS) / delta_rtime);
 if (sim_asynch_timer) {
     /* An asynchronous clock, merely needs to divide the number of */
     /* instructions actually executed by the clock rate. */
@@ -988,14 +1149,17 @@ if (delta_rtime == 0)                                   /* gap too small? */
 else
     rtc_based[tmr] = (int32) (((double) rtc_based[tmr] * (double) rtc_nxintv[tmr]) /
                                 ((double) delta_rtime));/* new base rate */
-delta_vtime = rtc_vtime[tmr] - rtc_rtime[tmr];          /* gap */
-if (delta_vtime > SIM_TMAX)                             /* limit gap */
-    delta_vtime = SIM_TMAX;
-else if (delta_vtime < -SIM_TMAX)
-    delta_vtime = -SIM_TMAX;
-rtc_nxintv[tmr] = 1000 + delta_vtime;                   /* next wtime */
+if (rtc_vtime[tmr] >= rtc_rtime[tmr])                   /* gap */
+    delta_vtime = (double)(rtc_vtime[tmr] - rtc_rtime[tmr]);
+else
+    delta_vtime = -(double)(rtc_rtime[tmr] - rtc_vtime[tmr]);
+if (delta_vtime > (double)(SIM_TMAX*NS_PER_MS))         /* limit gap */
+    delta_vtime = (double)(SIM_TMAX*NS_PER_MS);
+else if (delta_vtime < -(double)(SIM_TMAX*NS_PER_MS))
+    delta_vtime = -(double)(SIM_TMAX*NS_PER_MS);
+rtc_nxintv[tmr] = (uint32)((double)NS_PER_SEC + delta_vtime);/* next wtime */
 rtc_currd[tmr] = (int32) (((double) rtc_based[tmr] * (double) rtc_nxintv[tmr]) /
-    1000.0);                                            /* next delay */
+    (double)NS_PER_SEC);                                /* next delay */
 if (rtc_based[tmr] <= 0)                                /* never negative or zero! */
     rtc_based[tmr] = 1;
 if (rtc_currd[tmr] <= 0)                                /* never negative or zero! */
@@ -1086,6 +1250,15 @@ fprintf (st, "Execution Rate:                %s cycles/sec\n", sim_fmt_numeric (
 if (sim_idle_enab) {
     fprintf (st, "Idling:                        Enabled\n");
     fprintf (st, "Time before Idling starts:     %d seconds\n", sim_idle_stable);
+    if (sim_idle_tickless)
+        fprintf (st, "Tickless Idling:               Enabled, sleeping up to %d ms%s\n", sim_idle_tickless_max, 
+                                                    sim_catchup_ticks ? "" : " (inactive, catchup ticks disabled)");
+    if (sim_idle_tickless_sleeps) {
+        fprintf (st, "Tickless Sleeps:               %s\n", sim_fmt_numeric ((double)sim_idle_tickless_sleeps));
+        fprintf (st, "Tickless Sleeps Cut Short:     %s\n", sim_fmt_numeric ((double)sim_idle_tickless_early));
+        fprintf (st, "Tickless Time Slept:           %s\n", sim_fmt_secs (sim_idle_tickless_time / 1000.0));
+        fprintf (st, "Clock Ticks Slept Through:     %s\n", sim_fmt_numeric ((double)sim_idle_tickless_ticks));
+        }
     }
 if (sim_throt_type != SIM_THROT_NONE) {
     sim_show_throt (st, NULL, uptr, val, desc);
@@ -1133,9 +1306,9 @@ for (tmr=clocks=0; tmr<=SIM_NTIMERS; ++tmr) {
     if (rtc_gtime[tmr])
         fprintf (st, "  Instruction Time:          %.0f\n", rtc_gtime[tmr]);
     if ((!sim_asynch_timer) && (sim_throt_type == SIM_THROT_NONE)) {
-        fprintf (st, "  Real Time:                 %u\n",   rtc_rtime[tmr]);
-        fprintf (st, "  Virtual Time:              %u\n",   rtc_vtime[tmr]);
-        fprintf (st, "  Next Interval:             %s\n",   sim_fmt_numeric ((double)rtc_nxintv[tmr]));
+        fprintf (st, "  Real Time:                 %" LL_FMT "u ns\n", rtc_rtime[tmr]);
+        fprintf (st, "  Virtual Time:              %" LL_FMT "u ns\n", rtc_vtime[tmr]);
+        fprintf (st, "  Next Interval:             %s\n",   sim_fmt_secs ((double)rtc_nxintv[tmr] / NS_PER_SEC));
         fprintf (st, "  Base Tick Delay:           %s\n",   sim_fmt_numeric ((double)rtc_based[tmr]));
         fprintf (st, "  Initial Insts Per Tick:    %s\n",   sim_fmt_numeric ((double)rtc_initd[tmr]));
         }
@@ -1146,6 +1319,14 @@ for (tmr=clocks=0; tmr<=SIM_NTIMERS; ++tmr) {
         fprintf (st, "  Total Ticks:               %s\n", sim_fmt_numeric ((double)(rtc_clock_ticks_tot[tmr]+rtc_clock_ticks[tmr])));
     if (rtc_clock_skew_max[tmr] != 0.0)
         fprintf (st, "  Peak Clock Skew:           %s%s\n", sim_fmt_secs (fabs(rtc_clock_skew_max[tmr])), (rtc_clock_skew_max[tmr] < 0) ? " fast" : " slow");
+    if (rtc_tick_jitter_samples[tmr]) {
+        double mean = rtc_tick_jitter_sum[tmr] / rtc_tick_jitter_samples[tmr];
+        double var = (rtc_tick_jitter_sumsq[tmr] / rtc_tick_jitter_samples[tmr]) - (mean * mean);
+
+        fprintf (st, "  Tick Intervals Measured:   %s\n", sim_fmt_numeric ((double)rtc_tick_jitter_samples[tmr]));
+        fprintf (st, "  Tick Jitter (usecs):       mean %.1f, std dev %.1f, peak %.1f\n", mean / 1000.0, 
+                                                    ((var > 0.0) ? sqrt (var) : 0.0) / 1000.0, rtc_tick_jitter_max[tmr] / 1000.0);
+        }
     if (rtc_calib_ticks_acked[tmr])
         fprintf (st, "  Ticks Acked:               %s\n",   sim_fmt_numeric ((double)rtc_calib_ticks_acked[tmr]));
     if (rtc_calib_ticks_acked_tot[tmr]+rtc_calib_ticks_acked[tmr] != rtc_calib_ticks_acked[tmr])
@@ -1312,6 +1493,32 @@ fprintf (st, "Calibrated Ticks%s", sim_catchup_ticks ? " with Catchup Ticks" : "
 return SCPE_OK;
 }
 
+/* Set/Clear tickless idling */
+
+t_stat sim_timer_set_tickless (int32 flag, CONST char *cptr)
+{
+t_stat r;
+uint32 newmax;
+
+if (flag) {
+    if (cptr && *cptr) {
+        newmax = (uint32) get_uint (cptr, 10, SIM_IDLE_TLMAX, &r);
+        if ((r != SCPE_OK) || (newmax < SIM_IDLE_TLMIN))
+            return sim_messagef (SCPE_ARG, "Invalid tickless sleep limit: %s.  Valid values range from %d to %d ms.\n", cptr, SIM_IDLE_TLMIN, SIM_IDLE_TLMAX);
+        sim_idle_tickless_max = newmax;
+        }
+    if (!sim_catchup_ticks)
+        sim_printf ("Tickless idling stays inactive while catchup ticks are disabled (see SET CLOCK CATCHUP)\n");
+    sim_idle_tickless = TRUE;
+    }
+else {
+    if (cptr && *cptr)
+        return SCPE_2MARG;
+    sim_idle_tickless = FALSE;
+    }
+return SCPE_OK;
+}
+
 /* Set idle calibration threshold */
 
 t_stat sim_timer_set_idle_pct (int32 flag, CONST char *cptr)
@@ -1376,6 +1583,8 @@ static CTAB set_timer_tab[] = {
 #endif
     { "CATCHUP",    &sim_timer_set_catchup,  1 },
     { "NOCATCHUP",  &sim_timer_set_catchup,  0 },
+    { "TICKLESS",   &sim_timer_set_tickless, 1 },
+    { "NOTICKLESS", &sim_timer_set_tickless, 0 },
     { "CALIB",      &sim_timer_set_idle_pct, 0 },
     { "STOP",       &sim_timer_set_stop, 0 },
     { NULL, NULL, 0 }
@@ -1460,6 +1669,179 @@ while (*cptr != 0) {                                    /* do all mods */
 return SCPE_OK;
 }
 
+/* Tickless idling
+
+   Normally sim_idle sleeps at most until the next simulated clock tick,
+   so an idle simulator still wakes up rtc_hz times a second just to
+   deliver a clock tick to a system which has nothing to do with it.
+
+   With SET CLOCK TICKLESS, once the calibrated clock is delivering
+   catchup ticks (which requires that the simulator acknowledges its
+   clock interrupts with sim_rtcn_tick_ack), sim_idle instead sleeps
+   until the next scheduled event which isn't a clock tick or a
+   multiplexer or console input poll, bounded by sim_idle_tickless_max.
+   The sleep ends early when multiplexer or console input arrives (see
+   tmxr_idle_wait) or an asynchronous I/O completes.  On wakeup the
+   pending clock tick fires immediately and _rtcn_tick_catchup_check
+   then delivers the ticks which were slept through as catchup ticks.
+   A sleep which runs past the pending event schedules the first of
+   those catchup ticks right away rather than waiting for the next tick
+   acknowledgement to notice that the clock is behind.
+*/
+
+#if defined(SIM_ASYNCH_IO) && !defined(_WIN32) && !defined(VMS)
+static int sim_idle_wake_fd[2] = {-1, -1};              /* asynch I/O wakeup pipe */
+
+/* sim_idle_wake - end a tickless sleep due to an asynchronous event
+
+   Called by the asynchronous event queueing code when sim_idle_wait
+   indicates the simulator is idling.
+*/
+
+void sim_idle_wake (void)
+{
+if (sim_idle_wake_fd[1] >= 0) {
+    ssize_t written = write (sim_idle_wake_fd[1], "", 1);
+
+    (void)written;                                      /* a full pipe is already a wakeup */
+    }
+}
+
+static int32 _sim_idle_tickless_sleep (uint32 msec)
+{
+int32 waited;
+char drain[64];
+
+if (!sim_asynch_enabled)
+    return tmxr_idle_wait (msec, -1);
+if ((sim_idle_wake_fd[0] == -1) && (0 == pipe (sim_idle_wake_fd))) {
+    fcntl (sim_idle_wake_fd[0], F_SETFL, fcntl (sim_idle_wake_fd[0], F_GETFL, 0) | O_NONBLOCK);
+    fcntl (sim_idle_wake_fd[1], F_SETFL, fcntl (sim_idle_wake_fd[1], F_GETFL, 0) | O_NONBLOCK);
+    }
+if (sim_idle_wake_fd[0] == -1)
+    return -1;
+pthread_mutex_lock (&sim_asynch_lock);
+sim_idle_wait = TRUE;
+pthread_mutex_unlock (&sim_asynch_lock);
+if (AIO_QUEUE_VAL != QUEUE_LIST_END)                    /* event already arrived? */
+    waited = -1;
+else
+    waited = tmxr_idle_wait (msec, sim_idle_wake_fd[0]);
+pthread_mutex_lock (&sim_asynch_lock);
+sim_idle_wait = FALSE;
+pthread_mutex_unlock (&sim_asynch_lock);
+while (read (sim_idle_wake_fd[0], drain, sizeof (drain)) > 0)
+    ;
+if (AIO_QUEUE_VAL != QUEUE_LIST_END) {
+    sim_asynch_check = 0;                               /* force check of asynch queue now */
+    AIO_UPDATE_QUEUE;
+    }
+return waited;
+}
+#else
+void sim_idle_wake (void)
+{
+}
+
+static int32 _sim_idle_tickless_sleep (uint32 msec)
+{
+return tmxr_idle_wait (msec, -1);
+}
+#endif
+
+/* _sim_idle_tickless_ms - milliseconds until the next event which can't be
+                           slept through (bounded by sim_idle_tickless_max) */
+
+static uint32 _sim_idle_tickless_ms (void)
+{
+double limit = (double)sim_idle_tickless_max;
+double accum = 0.0;
+UNIT *uptr;
+int32 tmr;
+
+for (uptr = sim_clock_queue; uptr != QUEUE_LIST_END; uptr = uptr->next) {
+    t_bool tick = FALSE;
+
+    if (uptr == sim_clock_queue)
+        accum = (sim_interval > 0) ? (double)sim_interval : 0.0;
+    else
+        accum += uptr->time;
+    for (tmr = 0; tmr <= SIM_NTIMERS; tmr++)
+        if ((uptr == &sim_timer_units[tmr]) && (rtc_clock_catchup_eligible[tmr]))
+            tick = TRUE;
+    if (tick || tmxr_idle_poll_unit (uptr))             /* deferrable? */
+        continue;
+    accum += (uptr->usecs_remaining * sim_idle_cyc_ms) / 1000.0;
+    limit = MIN (limit, accum / sim_idle_cyc_ms);
+    break;
+    }
+for (tmr = 0; tmr <= SIM_NTIMERS; tmr++) {              /* coscheduled events */
+    int32 ticks = 0;
+
+    if ((sim_clock_unit[tmr] == NULL) || (rtc_hz[tmr] == 0))
+        continue;
+    for (uptr = sim_clock_cosched_queue[tmr]; uptr != QUEUE_LIST_END; uptr = uptr->next) {
+        if (!tmxr_idle_poll_unit (uptr)) {
+            limit = MIN (limit, (1000.0 * (ticks + 1)) / rtc_hz[tmr]);
+            break;
+            }
+        ticks += uptr->time;
+        }
+    }
+return (uint32)limit;
+}
+
+/* _sim_idle_tickless - sleep across clock ticks if possible
+
+   Returns TRUE if a tickless sleep was taken (and accounted for)
+*/
+
+static t_bool _sim_idle_tickless (uint32 tmr)
+{
+uint32 w_ms, n_ms, act_ms;
+int32 waited;
+double act_cyc;
+
+if ((!sim_catchup_ticks)                 ||             /* catchup disabled? */
+    (!rtc_clock_catchup_eligible[tmr])   ||             /*   or not yet active? */
+    (rtc_hz[tmr] == 0)                   ||             /*   or clock stopped? */
+    (sim_asynch_timer))                                 /*   or asynch clocks? */
+    return FALSE;
+if (sim_idle_tickless_backoff) {                        /* last sleep cut short? */
+    sim_idle_tickless_backoff = FALSE;                  /* just idle one tick now */
+    return FALSE;
+    }
+n_ms = (uint32)sim_interval / sim_idle_cyc_ms;          /* ms to the pending event */
+w_ms = _sim_idle_tickless_ms ();
+if (w_ms < n_ms + (1000 / rtc_hz[tmr]) + sim_idle_rate_ms) /* not at least a tick past that? */
+    return FALSE;
+sim_debug (DBG_IDL, &sim_timer_dev, "tickless sleep for up to %d ms - pending event on %s in %d instructions\n", w_ms, sim_uname(sim_clock_queue), sim_interval);
+sim_putchar_flush ();                                   /* show batched output before sleeping */
+waited = _sim_idle_tickless_sleep (w_ms);
+if (waited < 0) {
+    sim_debug (DBG_IDL, &sim_timer_dev, "tickless sleep not possible - input pending\n");
+    return FALSE;
+    }
+act_ms = (uint32)waited;
+++sim_idle_tickless_sleeps;
+if (act_ms + sim_idle_rate_ms < w_ms) {                 /* woken early? */
+    ++sim_idle_tickless_early;
+    sim_idle_tickless_backoff = TRUE;
+    }
+sim_idle_tickless_time += act_ms;
+sim_idle_tickless_ticks += (act_ms * rtc_hz[tmr]) / 1000;
+rtc_clock_time_idled[tmr] += act_ms;
+act_cyc = (double)act_ms * sim_idle_cyc_ms;
+if ((double)sim_interval > act_cyc)
+    sim_interval = sim_interval - (int32)act_cyc;       /* count down sim_interval */
+else {                                                  /* overslept the event? */
+    sim_interval = 0;                                   /* fire it immediately */
+    _rtcn_tick_catchup_check (tmr, 0);                  /* and catch up the ticks */
+    }
+sim_debug (DBG_IDL, &sim_timer_dev, "tickless slept for %d ms - pending event on %s in %d instructions\n", act_ms, sim_uname(sim_clock_queue), sim_interval);
+return TRUE;
+}
+
 /* sim_idle - idle simulator until next event or for specified interval
 
    Inputs:
@@ -1533,6 +1915,8 @@ if ((sim_idle_rate_ms == 0) || (sim_idle_cyc_ms == 0)) {/* not possible? */
     sim_debug (DBG_IDL, &sim_timer_dev, "not possible idle_rate_ms=%d - cyc/ms=%d\n", sim_idle_rate_ms, sim_idle_cyc_ms);
     return FALSE;
     }
+if ((sim_idle_tickless) && (_sim_idle_tickless (tmr)))  /* slept across clock ticks? */
+    return TRUE;
 w_ms = (uint32) sim_interval / sim_idle_cyc_ms;         /* ms to wait */
 /* When the host system has a clock tick which is less frequent than the    */
 /* simulated system's clock, idling will cause delays which will miss       */
@@ -1552,6 +1936,7 @@ if (sim_clock_queue == QUEUE_LIST_END)
     sim_debug (DBG_IDL, &sim_timer_dev, "sleeping for %d ms - pending event in %d instructions\n", w_ms, sim_interval);
 else
     sim_debug (DBG_IDL, &sim_timer_dev, "sleeping for %d ms - pending event on %s in %d instructions\n", w_ms, sim_uname(sim_clock_queue), sim_interval);
+sim_putchar_flush ();                                   /* show batched output before sleeping */
 act_ms = sim_idle_ms_sleep (w_ms);                      /* wait */
 rtc_clock_time_idled[tmr] += act_ms;
 act_cyc = act_ms * sim_idle_cyc_ms;
@@ -1601,7 +1986,7 @@ return SCPE_OK;
 t_stat sim_show_idle (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
 {
 if (sim_idle_enab)
-    fprintf (st, "idle enabled");
+    fprintf (st, "idle enabled%s", sim_idle_tickless ? " (tickless)" : "");
 else
     fprintf (st, "idle disabled");
 if (sim_switches & SWMASK ('D'))
@@ -1616,6 +2001,9 @@ t_stat sim_set_throt (int32 arg, CONST char *cptr)
 CONST char *tptr;
 char c;
 t_value val, val2 = 0;
+int32 type;
+t_bool paced = FALSE;
+uint32 pace_us = sim_throt_pace_us;
 
 if (arg == 0) {
     if ((cptr != NULL) && (*cptr != 0))
@@ -1632,7 +2020,6 @@ else {
     val = strtotv (cptr, &tptr, 10);
     if (cptr == tptr)
         return sim_messagef (SCPE_ARG, "Invalid throttle specification: %s\n", cptr);
-    sim_throt_sleep_time = sim_idle_rate_ms;
     c = (char)toupper (*tptr++);
     if (c == '/') {
         val2 = strtotv (tptr, &tptr, 10);
@@ -1640,14 +2027,37 @@ else {
             return sim_messagef (SCPE_ARG, "Invalid throttle delay specifier: %s\n", cptr);
         }
     if (c == 'M') 
-        sim_throt_type = SIM_THROT_MCYC;
+        type = SIM_THROT_MCYC;
     else if (c == 'K')
-        sim_throt_type = SIM_THROT_KCYC;
+        type = SIM_THROT_KCYC;
     else if ((c == '%') && (val > 0) && (val < 100))
-        sim_throt_type = SIM_THROT_PCT;
+        type = SIM_THROT_PCT;
     else if ((c == '/') && (val2 != 0))
-        sim_throt_type = SIM_THROT_SPC;
+        type = SIM_THROT_SPC;
     else return sim_messagef (SCPE_ARG, "Invalid throttle specification: %s\n", cptr);
+    if (type != SIM_THROT_SPC) {
+        while (sim_isspace (*tptr))
+            ++tptr;
+        if (*tptr != '\0') {
+            char gbuf[CBUFSIZE];
+            t_stat r;
+
+            tptr = get_glyph (tptr, gbuf, '=');
+            if (MATCH_CMD (gbuf, "PACED") != 0)
+                return sim_messagef (SCPE_ARG, "Invalid throttle specification: %s\n", cptr);
+            pace_us = SIM_THROT_PACE_DFLT;
+            if (*tptr != '\0') {
+                pace_us = (uint32) get_uint (tptr, 10, SIM_THROT_PACE_MAX, &r);
+                if ((r != SCPE_OK) || (pace_us < SIM_THROT_PACE_MIN))
+                    return sim_messagef (SCPE_ARG, "Invalid pacing interval: %s - must be %d to %d usecs\n", tptr, SIM_THROT_PACE_MIN, SIM_THROT_PACE_MAX);
+                }
+            paced = TRUE;
+            }
+        }
+    sim_throt_type = type;                              /* all valid, commit */
+    sim_throt_paced = paced;
+    sim_throt_pace_us = pace_us;
+    sim_throt_sleep_time = sim_idle_rate_ms;
     if (sim_idle_enab) {
         sim_printf ("Idling disabled\n");
         sim_clr_idle (NULL, 0, NULL, NULL);
@@ -1669,6 +2079,9 @@ else {
         sim_throt_state = SIM_THROT_STATE_THROTTLE;         /* force state */
         sim_throt_wait = sim_throt_val;
         }
+    sim_throt_pace_intervals = sim_throt_pace_late = sim_throt_pace_resyncs = 0;
+    sim_throt_pace_overshoot = sim_throt_pace_overshoot_max = sim_throt_pace_err_max = 0.0;
+    sim_throt_pace_wait_min = sim_throt_pace_wait_max = 0;
     }
 sim_register_internal_device (&sim_throttle_dev);       /* Register Throttle Device */
 if (sim_throt_type == SIM_THROT_SPC)    /* Set initial value while correct one is determined */
@@ -1687,20 +2100,21 @@ else {
 
     case SIM_THROT_MCYC:
         fprintf (st, "Throttle:                      %d megacycles\n", sim_throt_val);
-        if (sim_throt_wait)
+        if ((sim_throt_wait) && (!sim_throt_paced))
             fprintf (st, "Throttling by sleeping for:    %d ms every %d cycles\n", sim_throt_sleep_time, sim_throt_wait);
         break;
 
     case SIM_THROT_KCYC:
         fprintf (st, "Throttle:                      %d kilocycles\n", sim_throt_val);
-        if (sim_throt_wait)
+        if ((sim_throt_wait) && (!sim_throt_paced))
             fprintf (st, "Throttling by sleeping for:    %d ms every %d cycles\n", sim_throt_sleep_time, sim_throt_wait);
         break;
 
     case SIM_THROT_PCT:
         if (sim_throt_wait) {
             fprintf (st, "Throttle:                      %d%% of %s cycles per second\n", sim_throt_val, sim_fmt_numeric (sim_throt_peak_cps));
-            fprintf (st, "Throttling by sleeping for:    %d ms every %d cycles\n", sim_throt_sleep_time, sim_throt_wait);
+            if (!sim_throt_paced)
+                fprintf (st, "Throttling by sleeping for:    %d ms every %d cycles\n", sim_throt_sleep_time, sim_throt_wait);
             }
         else
             fprintf (st, "Throttle:                      %d%%\n", sim_throt_val);
@@ -1716,20 +2130,131 @@ else {
         break;
         }
     if (sim_throt_type != SIM_THROT_NONE) {
+        if (sim_throt_paced)
+            fprintf (st, "Throttle Pacing:               PID controlled, every %d usecs\n", sim_throt_pace_us);
         if (sim_throt_state != SIM_THROT_STATE_THROTTLE)
             fprintf (st, "Throttle State:                %s - wait: %d\n", (sim_throt_state == SIM_THROT_STATE_INIT) ? "Waiting for Init" : "Timing", sim_throt_wait);
         }
+    if (sim_throt_pace_intervals) {
+        fprintf (st, "Paced Intervals:               %s", sim_fmt_numeric ((double)sim_throt_pace_intervals));
+        fprintf (st, " (%u overran, %u resyncs)\n", sim_throt_pace_late, sim_throt_pace_resyncs);
+        fprintf (st, "Cycles Per Interval:           %d (range %d - %d)\n", sim_throt_wait, sim_throt_pace_wait_min, sim_throt_pace_wait_max);
+        if (sim_throt_pace_intervals > sim_throt_pace_late)
+            fprintf (st, "Sleep Overshoot (usecs):       mean %.1f, peak %.1f\n", 
+                     (sim_throt_pace_overshoot / (sim_throt_pace_intervals - sim_throt_pace_late)) / 1000.0, sim_throt_pace_overshoot_max / 1000.0);
+        fprintf (st, "Schedule Error (usecs):        now %.1f, peak %.1f\n", 
+                     (1000000.0 * sim_throt_pace_err) / sim_throt_cps, (1000000.0 * sim_throt_pace_err_max) / sim_throt_cps);
+        if (sim_throt_pace_last > sim_throt_pace_epoch)
+            fprintf (st, "Paced Execution Rate:          %s cycles/sec\n", 
+                     sim_fmt_numeric (((sim_throt_pace_inst_last - sim_throt_pace_inst_epoch) * NS_PER_SEC) / (double)(sim_throt_pace_last - sim_throt_pace_epoch)));
+        }
     }
 return SCPE_OK;
 }
 
+/* Mark the start of a throttle measurement interval */
+
+static void _sim_throt_start (void)
+{
+sim_throt_ns_start = sim_os_nsec ();
+sim_throt_ms_start = (uint32)(sim_throt_ns_start / NS_PER_MS);
+sim_throt_inst_start = sim_gtime ();
+}
+
+/* Paced throttling
+
+   Rather than executing long bursts separated by millisecond sleeps,
+   paced throttling divides time into short fixed intervals and sleeps
+   until the absolute end of each one.  The number of cycles executed
+   in the next interval is the nominal amount plus a PID correction of
+   the schedule error: how many instructions the simulator is behind
+   (or ahead of) where the desired rate says it should be by now.
+   Sleeping to absolute deadlines keeps host wakeup latency from
+   accumulating, and the controller absorbs what latency remains.
+*/
+
+static int32 _sim_throt_pace_nominal (void)
+{
+double nominal = (sim_throt_cps * sim_throt_pace_us) / 1000000.0;
+
+return (nominal < SIM_THROT_WMIN) ? SIM_THROT_WMIN : (int32)nominal;
+}
+
+static void _sim_throt_pace_reset (void)
+{
+sim_throt_pace_last = sim_throt_pace_epoch = sim_os_nsec ();
+sim_throt_pace_inst_last = sim_throt_pace_inst_epoch = sim_gtime ();
+sim_throt_pace_next = sim_throt_pace_epoch + ((t_uint64)sim_throt_pace_us) * 1000;
+sim_throt_pace_integral = 0.0;
+sim_throt_pace_err = 0.0;
+sim_throt_wait = _sim_throt_pace_nominal ();
+}
+
+static void _sim_throt_pace (void)
+{
+t_uint64 pace_ns = ((t_uint64)sim_throt_pace_us) * 1000;
+t_uint64 now = sim_os_nsec ();
+double nominal = (double)_sim_throt_pace_nominal ();
+double err, last_err, wait;
+
+++sim_throt_pace_intervals;
+if (now < sim_throt_pace_next) {                    /* ahead of schedule? */
+    double overshoot;
+
+    now = sim_os_ns_sleep_until (sim_throt_pace_next);
+    overshoot = (now > sim_throt_pace_next) ? (double)(now - sim_throt_pace_next) : 0.0;
+    sim_throt_pace_overshoot += overshoot;
+    if (overshoot > sim_throt_pace_overshoot_max)
+        sim_throt_pace_overshoot_max = overshoot;
+    }
+else {
+    ++sim_throt_pace_late;
+    if (now - sim_throt_pace_next > SIM_THROT_PACE_RESYNC * pace_ns) {
+        /* Far behind schedule (the host was busy or the process was  */
+        /* suspended).  Rather than running flat out to make up the    */
+        /* lost time, start a new schedule from here.                  */
+        ++sim_throt_pace_resyncs;
+        sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc(PACE) Resynchronizing %.0f usecs behind schedule\n", 
+                                            (double)(now - sim_throt_pace_next) / 1000.0);
+        _sim_throt_pace_reset ();
+        return;
+        }
+    }
+sim_throt_pace_next += pace_ns;
+sim_throt_pace_last = now;
+sim_throt_pace_inst_last = sim_gtime ();
+err = ((double)(now - sim_throt_pace_epoch) * sim_throt_cps) / NS_PER_SEC -
+      (sim_throt_pace_inst_last - sim_throt_pace_inst_epoch);/* insts behind schedule */
+last_err = sim_throt_pace_err;
+sim_throt_pace_err = err;
+if (fabs (err) > sim_throt_pace_err_max)
+    sim_throt_pace_err_max = fabs (err);
+sim_throt_pace_integral += err;
+if (sim_throt_pace_integral > 10.0 * nominal)       /* limit windup */
+    sim_throt_pace_integral = 10.0 * nominal;
+else if (sim_throt_pace_integral < -10.0 * nominal)
+    sim_throt_pace_integral = -10.0 * nominal;
+wait = nominal + (SIM_THROT_PID_KP * err) + (SIM_THROT_PID_KI * sim_throt_pace_integral) + 
+                 (SIM_THROT_PID_KD * (err - last_err));
+if (wait < SIM_THROT_WMIN)
+    wait = SIM_THROT_WMIN;
+else if (wait > 4.0 * nominal)
+    wait = 4.0 * nominal;
+sim_throt_wait = (int32)wait;
+if ((sim_throt_pace_wait_min == 0) || (sim_throt_wait < sim_throt_pace_wait_min))
+    sim_throt_pace_wait_min = sim_throt_wait;
+if (sim_throt_wait > sim_throt_pace_wait_max)
+    sim_throt_pace_wait_max = sim_throt_wait;
+}
+
 void sim_throt_sched (void)
 {
 if (sim_throt_type != SIM_THROT_NONE) {
     if (sim_throt_state == SIM_THROT_STATE_THROTTLE) {  /* Previously calibrated? */
         /* Reset recalibration reference times */
-        sim_throt_ms_start = sim_os_msec ();
-        sim_throt_inst_start = sim_gtime ();
+        _sim_throt_start ();
+        if (sim_throt_paced)
+            _sim_throt_pace_reset ();
         /* Start with prior calibrated delay */
         sim_activate (&sim_throttle_unit, sim_throt_wait);
         }
@@ -1758,7 +2283,7 @@ sim_cancel (&sim_throttle_unit);
 t_stat sim_throt_svc (UNIT *uptr)
 {
 int32 tmr;
-uint32 delta_ms;
+double delta_ms;
 double a_cps, d_cps, delta_inst;
 
 switch (sim_throt_state) {
@@ -1766,8 +2291,7 @@ switch (sim_throt_state) {
     case SIM_THROT_STATE_INIT:                          /* take initial reading */
         if ((sim_calb_tmr != -1) && (rtc_hz[sim_calb_tmr] != 0)) {
             if (rtc_calibrations[sim_calb_tmr] < sim_throt_delay) {
-                sim_throt_ms_start = sim_os_msec ();
-                sim_throt_inst_start = sim_gtime ();
+                _sim_throt_start ();
                 sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc(INIT) Deferring until stable (%d more seconds)\n", (int)(sim_throt_delay - rtc_calibrations[sim_calb_tmr]));
                 return sim_activate (uptr, rtc_hz[sim_calb_tmr]*rtc_currd[sim_calb_tmr]);
                 }
@@ -1780,8 +2304,7 @@ switch (sim_throt_state) {
         else
             sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc(INIT) Calibrated timer not available. Falling back to legacy method\n");
         sim_idle_ms_sleep (sim_idle_rate_ms);           /* start on a tick boundary to calibrate */
-        sim_throt_ms_start = sim_os_msec ();
-        sim_throt_inst_start = sim_gtime ();
+        _sim_throt_start ();
         if (sim_throt_type != SIM_THROT_SPC) {          /* dynamic? */
             switch (sim_throt_type) {
                 case SIM_THROT_PCT:
@@ -1805,8 +2328,9 @@ switch (sim_throt_state) {
         break;                                          /* reschedule */
 
     case SIM_THROT_STATE_TIME:                          /* take final reading */
-        sim_throt_ms_stop = sim_os_msec ();
-        delta_ms = sim_throt_ms_stop - sim_throt_ms_start;
+        sim_throt_ns_stop = sim_os_nsec ();
+        sim_throt_ms_stop = (uint32)(sim_throt_ns_stop / NS_PER_MS);
+        delta_ms = (double)(sim_throt_ns_stop - sim_throt_ns_start) / NS_PER_MS;
         delta_inst = sim_gtime () - sim_throt_inst_start;
         if (delta_ms < SIM_THROT_MSMIN) {               /* not enough time? */
             if (delta_inst >= 100000000.0) {            /* too many inst? */
@@ -1818,12 +2342,11 @@ switch (sim_throt_state) {
             sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Not enough time.  %d ms executing %.f instructions.\n", 
                                 (int)delta_ms, delta_inst);
             sim_throt_wait = (int32)(delta_inst * SIM_THROT_WMUL);
-            sim_throt_inst_start = sim_gtime();
             sim_idle_ms_sleep (sim_idle_rate_ms);       /* start on a tick boundart to calibrate */
-            sim_throt_ms_start = sim_os_msec ();
+            _sim_throt_start ();
             }
         else {                                          /* long enough */
-            a_cps = (((double) delta_inst) * 1000.0) / (double) delta_ms;
+            a_cps = (((double) delta_inst) * 1000.0) / delta_ms;
             if (sim_throt_type == SIM_THROT_MCYC)       /* calc desired cps */
                 d_cps = (double) sim_throt_val * 1000000.0;
             else
@@ -1842,7 +2365,7 @@ switch (sim_throt_state) {
                 sim_set_throt (0, NULL);
                 return SCPE_OK;
                 }
-            while (1) {
+            while (!sim_throt_paced) {
                 sim_throt_wait = (int32)                /* cycles between sleeps */
                     ((a_cps * d_cps * ((double) sim_throt_sleep_time)) /
                      (1000.0 * (a_cps - d_cps)));
@@ -1852,21 +2375,24 @@ switch (sim_throt_state) {
                 sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Wait too small, increasing sleep time to %d ms.  Values a_cps = %f, d_cps = %f, wait = %d\n", 
                                                     sim_throt_sleep_time, a_cps, d_cps, sim_throt_wait);
                 }
+            sim_throt_ns_start = sim_throt_ns_stop;
             sim_throt_ms_start = sim_throt_ms_stop;
             sim_throt_inst_start = sim_gtime();
             sim_throt_state = SIM_THROT_STATE_THROTTLE;
             sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Throttle values a_cps = %f, d_cps = %f, wait = %d, sleep = %d ms\n", 
                                                 a_cps, d_cps, sim_throt_wait, sim_throt_sleep_time);
             sim_throt_cps = d_cps;                  /* save the desired rate */
+            if (sim_throt_paced)
+                _sim_throt_pace_reset ();
             /* Run through all timers and adjust the calibration for each */
             /* one that is running to reflect the throttle rate */
             for (tmr=0; tmr<=SIM_NTIMERS; tmr++) {
                 if (rtc_hz[tmr]) {                                      /* running? */
                     rtc_currd[tmr] = (int32)(sim_throt_cps / rtc_hz[tmr]);/* use throttle calibration */
                     rtc_ticks[tmr] = rtc_hz[tmr] - 1;                     /* force clock calibration on next tick */
-                    rtc_rtime[tmr] = sim_throt_ms_start - 1000 + 1000/rtc_hz[tmr];/* adjust calibration parameters to reflect throttled rate */
+                    rtc_rtime[tmr] = sim_throt_ns_start - NS_PER_SEC + NS_PER_SEC/rtc_hz[tmr];/* adjust calibration parameters to reflect throttled rate */
                     rtc_gtime[tmr] = sim_throt_inst_start - sim_throt_cps + sim_throt_cps/rtc_hz[tmr];
-                    rtc_nxintv[tmr] = 1000;
+                    rtc_nxintv[tmr] = (uint32)NS_PER_SEC;
                     rtc_based[tmr] = rtc_currd[tmr];
                     if (sim_clock_unit[tmr])
                         sim_activate_abs (sim_clock_unit[tmr], rtc_currd[tmr]);/* reschedule next tick */
@@ -1876,12 +2402,16 @@ switch (sim_throt_state) {
         break;
 
     case SIM_THROT_STATE_THROTTLE:                      /* throttling */
+        if (sim_throt_paced) {
+            _sim_throt_pace ();
+            break;
+            }
         sim_idle_ms_sleep (sim_throt_sleep_time);
-        delta_ms = sim_os_msec () - sim_throt_ms_start;
-        if (delta_ms >= 10000) {                        /* recompute every 10 sec */
+        delta_ms = (double)(sim_os_nsec () - sim_throt_ns_start) / NS_PER_MS;
+        if (delta_ms >= 10000.0) {                      /* recompute every 10 sec */
             double delta_insts = sim_gtime() - sim_throt_inst_start;
 
-            a_cps = (delta_insts * 1000.0) / (double) delta_ms;
+            a_cps = (delta_insts * 1000.0) / delta_ms;
             if (sim_throt_type != SIM_THROT_SPC) {      /* when not dynamic throttling */
                 if (sim_throt_type == SIM_THROT_MCYC)   /* calc desired cps */
                     d_cps = (double) sim_throt_val * 1000000.0;
@@ -1916,16 +2446,14 @@ switch (sim_throt_state) {
                     sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Throttle values a_cps = %f, d_cps = %f, wait = %d, sleep = %d ms\n", 
                                                         a_cps, d_cps, sim_throt_wait, sim_throt_sleep_time);
                     sim_throt_cps = d_cps;                      /* save the desired rate */
-                    sim_throt_ms_start = sim_os_msec ();
-                    sim_throt_inst_start = sim_gtime();
+                    _sim_throt_start ();
                     }
                 }
             else {                                      /* record instruction rate */
                 sim_throt_cps = (int32)a_cps;
                 sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Recalibrating Special %d/%u Cycles Per Second of %f\n", 
                                                     sim_throt_wait, sim_throt_sleep_time, sim_throt_cps);
-                sim_throt_inst_start = sim_gtime();
-                sim_throt_ms_start = sim_os_msec ();
+                _sim_throt_start ();
                 }
             }
         break;
@@ -2058,7 +2586,8 @@ static t_bool _rtcn_tick_catchup_check (int32 tmr, int32 time)
 if ((!sim_catchup_ticks) || 
     ((tmr < 0) || (tmr >= SIM_NTIMERS)))
     return FALSE;
-if ((rtc_hz[tmr] > sim_os_tick_hz) &&           /* faster than host tick */
+if (((rtc_hz[tmr] > sim_os_tick_hz) ||         /* faster than host tick */
+     (sim_idle_tickless)) &&                    /*   or sleeping across ticks */
     (!rtc_clock_catchup_eligible[tmr]) &&       /* not eligible yet? */
     (time != -1)) {                             /* called from ack? */
     rtc_clock_catchup_base_time[tmr] = sim_timenow_double();
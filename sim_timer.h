@@ -83,6 +83,9 @@ int clock_gettime(int clock_id, struct timespec *tp);
 #define SIM_IDLE_STMIN  2                           /* min sec for stability */
 #define SIM_IDLE_STDFLT 20                          /* dft sec for stability */
 #define SIM_IDLE_STMAX  600                         /* max sec for stability */
+#define SIM_IDLE_TLMIN  20                          /* min ms tickless sleep limit */
+#define SIM_IDLE_TLDFLT 250                         /* dft ms tickless sleep limit */
+#define SIM_IDLE_TLMAX  10000                       /* max ms tickless sleep limit */
 
 #define SIM_THROT_WINIT           1000              /* cycles to skip */
 #define SIM_THROT_WST             10000             /* initial wait */
@@ -98,6 +101,13 @@ int clock_gettime(int clock_id, struct timespec *tp);
 #define SIM_THROT_STATE_INIT      0                 /* Starting */
 #define SIM_THROT_STATE_TIME      1                 /* Checking Time */
 #define SIM_THROT_STATE_THROTTLE  2                 /* Throttling  */
+#define SIM_THROT_PACE_MIN        100               /* min usecs paced interval */
+#define SIM_THROT_PACE_DFLT       1000              /* dft usecs paced interval */
+#define SIM_THROT_PACE_MAX        100000            /* max usecs paced interval */
+#define SIM_THROT_PACE_RESYNC     100               /* intervals behind before resync */
+#define SIM_THROT_PID_KP          0.5               /* paced proportional gain */
+#define SIM_THROT_PID_KI          0.05              /* paced integral gain */
+#define SIM_THROT_PID_KD          0.1               /* paced derivative gain */
 
 #define TIMER_DBG_IDLE  0x001                       /* Debug Flag for Idle Debugging */
 #define TIMER_DBG_QUEUE 0x002                       /* Debug Flag for Asynch Queue Debugging */
@@ -123,12 +133,15 @@ t_stat sim_show_throt (FILE *st, DEVICE *dnotused, UNIT *unotused, int32 flag, C
 t_stat sim_set_idle (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat sim_clr_idle (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat sim_show_idle (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+void sim_idle_wake (void);
 void sim_throt_sched (void);
 void sim_throt_cancel (void);
 uint32 sim_os_msec (void);
 void sim_os_sleep (unsigned int sec);
 uint32 sim_os_ms_sleep (unsigned int msec);
 uint32 sim_os_ms_sleep_init (void);
+t_uint64 sim_os_nsec (void);
+t_uint64 sim_os_ns_sleep_until (t_uint64 deadline);
 void sim_start_timer_services (void);
 void sim_stop_timer_services (void);
 t_stat sim_timer_change_asynch (void);
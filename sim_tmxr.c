@@ -114,6 +114,10 @@
    tmxr_show_cstat -                    show line connections or status
    tmxr_show_lines -                    show number of lines
    tmxr_show_open_devices -             show info about all open tmxr devices 
+   tmxr_loadtest_cmd -                  start or stop a multiplexer load test
+   tmxr_show_loadtest -                 show multiplexer load test results
+   tmxr_idle_poll_unit -                identify multiplexer and console input polling units
+   tmxr_idle_wait -                     wait for multiplexer or console input while idling
 
    All routines are OS-independent.
 
@@ -2173,9 +2177,14 @@ if ((lp->txbfd && !lp->notelnet) || (TXBUF_AVAIL(lp) > 1)) {/* room for char (+
     sim_exp_check (&lp->expect, chr);                   /* process expect rules as needed */
     if (!sim_is_running) {                              /* attach message or other non simulation time message? */
         tmxr_send_buffered_data (lp);                   /* put data on wire */
-        sim_os_ms_sleep(((lp->txbps) && (lp->txdelta > 1000)) ? /* rate limiting output slower than 1000 cps */
-                        (lp->txdelta - 1000) / 1000 : 
-                        10);                           /* wait an approximate character delay */
+        if (lp->txbps)                                  /* rate limiting output? */
+            sim_os_ms_sleep(lp->txdelta > 1000 ?        /* rate limiting output slower than 1000 cps */
+                            (lp->txdelta - 1000) / 1000 : 
+                            10);                       /* wait an approximate character delay */
+        else {
+            if (tmxr_tqln (lp))                         /* wire didn't take it all? */
+                sim_os_ms_sleep (10);                   /* give it time to drain */
+            }
         }
     return SCPE_OK;                                     /* char sent */
     }
@@ -2183,6 +2192,89 @@ if ((lp->txbfd && !lp->notelnet) || (TXBUF_AVAIL(lp) > 1)) {/* room for char (+
 return SCPE_STALL;                                      /* char not sent */
 }
 
+/* Store a block of characters in line buffer
+
+   Inputs:
+        *lp     =       pointer to line descriptor
+        *buf    =       pointer to data
+        size    =       size of data
+   Outputs:
+        status  =       ok, connection lost, or stall
+
+   Implementation notes:
+
+    1. The data is buffered exactly as tmxr_putc_ln would buffer each 
+       character, but it is only written to the wire as the buffer fills 
+       and once at the end, rather than after every character while the 
+       simulator isn't running.
+    2. While the simulator isn't running this routine waits for the wire 
+       to accept the data rather than stalling or (on buffered lines) 
+       discarding undelivered output.
+    3. While the simulator is running (i.e. when called from a unit 
+       service routine) the block is either buffered in full or, if the 
+       line doesn't have room for all of it, dropped and SCPE_STALL is
+       returned, so the caller never waits on the wire.
+*/
+
+t_stat tmxr_putblk_ln (TMLN *lp, const uint8 *buf, size_t size)
+{
+size_t i;
+
+if ((lp->conn == FALSE) &&                              /* no conn & not buffered telnet? */
+    (!lp->txbfd || lp->notelnet)) {
+    lp->txdrp += (int32)size;                           /* lost */
+    return SCPE_LOST;
+    }
+tmxr_debug_trace_line (lp, "tmxr_putblk_ln()");
+if (sim_is_running) {                                   /* can't wait for the wire? */
+    size_t need = size + 1;
+
+    if (!lp->notelnet)                                  /* telnet session? */
+        for (i = 0; i < size; i++)                      /* count the IACs to stuff */
+            need += (TN_IAC == buf[i]);
+    if ((size_t)TXBUF_AVAIL(lp) < need)
+        tmxr_send_buffered_data (lp);                   /* make what room we can */
+    if ((size_t)TXBUF_AVAIL(lp) < need) {               /* still no room for it all? */
+        ++lp->txstall;
+        lp->txdrp += (int32)size;                       /* lost */
+        return SCPE_STALL;
+        }
+    }
+if (lp->txbps) {                                        /* rate limited? */
+    for (i = 0; i < size; i++)                          /* let putc pace the data */
+        while (SCPE_STALL == tmxr_putc_ln (lp, buf[i]))
+            if (lp->txbsz == tmxr_send_buffered_data (lp))
+                sim_os_ms_sleep (10);
+    return lp->conn ? SCPE_OK : SCPE_LOST;
+    }
+for (i = 0; i < size; i++) {
+    while (TXBUF_AVAIL(lp) < 2) {                       /* no room for char (+ IAC)? */
+        tmxr_send_buffered_data (lp);                   /* put data on wire */
+        if (!lp->conn) {
+            lp->txdrp += (int32)(size - i);             /* lost */
+            return SCPE_LOST;
+            }
+        if (TXBUF_AVAIL(lp) < 2)                        /* still full? */
+            sim_os_ms_sleep (10);                       /* wait for the wire to drain */
+        }
+    if ((TN_IAC == buf[i]) && (!lp->notelnet))          /* char == IAC in telnet session? */
+        TXBUF_CHAR (lp, TN_IAC);                        /* stuff extra IAC char */
+    TXBUF_CHAR (lp, buf[i]);                            /* buffer char & adv pointer */
+    if (lp->txlog) {                                    /* log if available */
+        extern TMLN *sim_oline;                         /* Make sure to avoid recursion */
+        TMLN *save_oline = sim_oline;                   /* when logging to a socket */
+
+        sim_oline = NULL;                               /* save output socket */
+        fputc (buf[i], lp->txlog);                      /* log to actual file */
+        sim_oline = save_oline;                         /* resture output socket */
+        }
+    sim_exp_check (&lp->expect, buf[i]);                /* process expect rules as needed */
+    }
+lp->xmte = 1;                                           /* enable line transmit */
+tmxr_send_buffered_data (lp);                           /* put data on wire */
+return SCPE_OK;
+}
+
 /* Store packet in line buffer
 
    Inputs:
@@ -2657,7 +2749,7 @@ while (*tptr) {
             cptr = get_glyph (gbuf, port, ';');
             if (sim_parse_addr (port, NULL, 0, NULL, NULL, 0, NULL, NULL))
                 return sim_messagef (SCPE_ARG, "Invalid Port Specifier: %s\n", port);
-            if (cptr) {
+            if ((cptr) && (*cptr)) {
                 char *tptr = gbuf + (cptr - gbuf);
                 get_glyph (cptr, tptr, 0);                  /* upcase this string */
                 if (0 == MATCH_CMD (cptr, "NOTELNET"))
@@ -4205,6 +4297,132 @@ sim_cancel (uptr);
 return tmxr_clock_coschedule_tmr (uptr, tmr, ticks);
 }
 
+/* Tickless idle support
+
+   tmxr_idle_poll_unit  - TRUE if a unit's activations exist only to poll
+                          for multiplexer or console input
+   tmxr_idle_wait       - wait for multiplexer or console input
+
+   A tickless idle sleep spans many clock ticks, so the multiplexer and
+   console input polls which are normally coscheduled with the clock are
+   deferred while it sleeps.  tmxr_idle_wait stands in for those polls
+   by sleeping in select() on every open multiplexer listen socket and
+   connected line as well as the console keyboard, so that a connection
+   request or arriving data ends the sleep just as a poll would have
+   noticed it.
+
+   tmxr_idle_wait returns the number of milliseconds actually waited, or
+   -1 if the input sources can't be waited for.  That is the case when
+   any line has buffered receive, transmit, loopback or SEND data which
+   a poll still has to move, when a line is connected to a serial port,
+   when there has been any line activity since the previous call (so
+   that the device's own poll gets a chance to notice the completion of
+   that activity), and on hosts without select() support for the
+   console.  The caller then falls back to idling a single clock tick.
+
+   wake_fd is an optional additional descriptor (or -1) whose readability
+   also ends the wait.  The timer code uses it to be woken when an
+   asynchronous I/O completes.
+*/
+
+t_bool tmxr_idle_poll_unit (UNIT *uptr)
+{
+extern TMLN sim_con_ldsc;
+
+return ((uptr->dynflags & UNIT_TM_POLL) || 
+        ((uptr == sim_con_ldsc.uptr) && (uptr != NULL)));
+}
+
+#if !defined(_WIN32) && !defined(VMS)
+static uint32 tmxr_idle_activity = 0;
+
+static t_bool _tmxr_idle_line_busy (TMLN *lp, uint32 *activity)
+{
+*activity += (uint32)(lp->rxcnt + lp->txcnt + lp->rxbpr + lp->txbpi + lp->sessions);
+return ((lp->serport != 0)                  ||
+        (lp->rxbpi != lp->rxbpr)            ||
+        (lp->txbpi != lp->txbpr)            ||
+        (lp->rxpboffset != 0)               ||
+        (lp->txppoffset != 0)               ||
+        (lp->loopback && (lp->lpbcnt != 0)) ||
+        (lp->send.extoff < lp->send.insoff));
+}
+
+int32 tmxr_idle_wait (uint32 msec, int wake_fd)
+{
+extern TMXR sim_con_tmxr;
+extern SEND sim_con_send;
+fd_set readfds, writefds;
+struct timeval timeout;
+SOCKET max_fd = -1;
+uint32 activity = 0;
+uint32 start;
+int i, j;
+
+FD_ZERO (&readfds);
+FD_ZERO (&writefds);
+if (sim_con_tmxr.master == 0) {                         /* console on the keyboard? */
+    if ((sim_con_tmxr.ldsc->serport != 0) || 
+        (!sim_ttisatty ()))
+        return -1;
+    FD_SET (0, &readfds);
+    max_fd = 0;
+    }
+if (sim_con_send.extoff < sim_con_send.insoff)          /* console SEND data pending? */
+    return -1;
+for (i=0; i<tmxr_open_device_count; ++i) {
+    TMXR *mp = tmxr_open_devices[i];
+
+    if (mp->master) {
+        FD_SET (mp->master, &readfds);
+        if (mp->master > max_fd)
+            max_fd = mp->master;
+        }
+    for (j=0; j<mp->lines; ++j) {
+        TMLN *lp = &mp->ldsc[j];
+
+        if (_tmxr_idle_line_busy (lp, &activity))
+            return -1;
+        if (lp->master) {
+            FD_SET (lp->master, &readfds);
+            if (lp->master > max_fd)
+                max_fd = lp->master;
+            }
+        if ((lp->sock) && (lp->rcve)) {
+            FD_SET (lp->sock, &readfds);
+            if (lp->sock > max_fd)
+                max_fd = lp->sock;
+            }
+        if (lp->connecting) {
+            FD_SET (lp->connecting, &writefds);
+            if (lp->connecting > max_fd)
+                max_fd = lp->connecting;
+            }
+        }
+    }
+if (activity != tmxr_idle_activity) {                   /* anything happen since last time? */
+    tmxr_idle_activity = activity;
+    return -1;
+    }
+if (wake_fd >= 0) {
+    FD_SET (wake_fd, &readfds);
+    if (wake_fd > max_fd)
+        max_fd = wake_fd;
+    }
+start = sim_os_msec ();
+timeout.tv_sec = msec / 1000;
+timeout.tv_usec = (msec % 1000) * 1000;
+if (select ((int)(max_fd + 1), &readfds, &writefds, NULL, &timeout) < 0)
+    sim_debug (TIMER_DBG_IDLE, &sim_timer_dev, "tmxr_idle_wait() - select error: %s\n", strerror (errno));
+return (int32)(sim_os_msec () - start);
+}
+#else
+int32 tmxr_idle_wait (uint32 msec, int wake_fd)
+{
+return -1;
+}
+#endif
+
 /* Generic Multiplexer attach help */
 
 t_stat tmxr_attach_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
@@ -4394,6 +4612,12 @@ else {
     fprintf (st, "using commands of the form:\n\n");
     fprintf (st, "   sim> ATTACH %s Line=n,{interface:}port{;notelnet}\n\n", dptr->name);
     }
+fprintf (st, "On hosts which support them, Unix domain sockets may be used in place of\n");
+fprintf (st, "tcp ports for listening ports and connection destinations by specifying\n");
+fprintf (st, "unix:path.  Local connections made this way avoid the host's network\n");
+fprintf (st, "stack and otherwise behave like tcp connections:\n\n");
+fprintf (st, "   sim> ATTACH %s %sunix:/tmp/mux.sock{;notelnet}\n", dptr->name, single_line ? "" : "Line=n,");
+fprintf (st, "   sim> ATTACH %s %sConnect=unix:/tmp/peer.sock{;notelnet}\n\n", dptr->name, single_line ? "" : "Line=n,");
 fprintf (st, "Direct computer to computer connections (Virutal Null Modem cables) may\n");
 fprintf (st, "be established using the telnet protocol or via raw tcp sockets.\n\n");
 fprintf (st, "   sim> ATTACH %s Line=n,Connect=host:port{;notelnet}\n\n", dptr->name);
@@ -4446,6 +4670,397 @@ if (dptr->modifiers) {
 return SCPE_OK;
 }
 
+/* Multiplexer load test
+
+   The LOADTEST command opens a number of client sessions to the listening
+   port of an attached multiplexer, exactly as a population of users with
+   terminal emulators would.  Once a session's connection greeting (and
+   anything the simulated system says when a line comes up) has quieted
+   down, the session sends one character of its script at a time and
+   measures the time until the simulated system responds (normally with
+   the echo of that character).  Telnet protocol sequences sent by the
+   multiplexer are skipped and never count as a response.
+
+   The sessions are driven from an internal unit which runs while the
+   simulator is running, so the results reflect the full path from the
+   host socket layer through tmxr_poll_conn/tmxr_poll_rx, the simulated
+   device and the simulated operating system, and back.
+*/
+
+#define TMXR_LT_SETTLE_USECS    250000                  /* quiet time before a session starts */
+#define TMXR_LT_TIMEOUT_USECS   5000000                 /* response timeout */
+#define TMXR_LT_POLL_USECS      1000                    /* session service interval */
+#define TMXR_LT_MAX_SAMPLES     (1024*1024)             /* max latency samples kept */
+
+typedef enum {
+    TMXR_LT_CONNECTING,
+    TMXR_LT_SETTLING,
+    TMXR_LT_RUNNING,
+    TMXR_LT_CLOSED
+    } TMXR_LT_STATE;
+
+typedef struct {
+    SOCKET          sock;
+    TMXR_LT_STATE   state;
+    int             telnet;                             /* telnet sequence parse state */
+    size_t          script_pos;                         /* next script character */
+    double          last_rcv;                           /* time of last data (settling) */
+    double          sent_at;                            /* time outstanding character sent */
+    double          next_send;                          /* time next character may be sent */
+    t_bool          outstanding;                        /* awaiting response */
+    } TMXR_LT_SESSION;
+
+static struct {
+    TMXR            *mp;                                /* multiplexer under test */
+    char            port[CBUFSIZE];                     /* listening port connected to */
+    uint8           script[CBUFSIZE];                   /* characters to send */
+    uint32          script_size;
+    uint32          sessions;                           /* session count */
+    uint32          interval;                           /* usecs between characters per session */
+    uint32          duration;                           /* seconds to run */
+    TMXR_LT_SESSION *session;
+    t_bool          active;
+    double          start;                              /* wall time first session ran */
+    double          stop;                               /* wall time test completed */
+    clock_t         cpu_start;                          /* host process CPU time at start */
+    clock_t         cpu_stop;
+    uint32          connected;
+    uint32          disconnects;
+    uint32          timeouts;
+    t_uint64        chars_sent;
+    t_uint64        chars_rcvd;
+    uint32          *samples;                           /* response latencies (usecs) */
+    uint32          sample_count;
+    uint32          sample_size;
+    } tmxr_lt;
+
+static t_stat _tmxr_loadtest_svc (UNIT *uptr);
+
+static UNIT tmxr_loadtest_unit = { UDATA (&_tmxr_loadtest_svc, UNIT_DIS|UNIT_IDLE, 0) };
+
+static const char *_tmxr_loadtest_description (DEVICE *dptr)
+{
+return "Multiplexer Load Test Facility";
+}
+
+static DEVICE tmxr_loadtest_dev = {
+    "MUX-LOADTEST", &tmxr_loadtest_unit, NULL, NULL, 
+    1, 0, 0, 0, 0, 0, 
+    NULL, NULL, NULL, NULL, NULL, NULL, 
+    NULL, DEV_NOSAVE, 0, NULL,
+    NULL, NULL, NULL, NULL, NULL, _tmxr_loadtest_description};
+
+static double _tmxr_loadtest_usecs (void)
+{
+struct timespec now;
+
+clock_gettime (CLOCK_REALTIME, &now);
+return (((double)now.tv_sec) * 1000000.0) + (((double)now.tv_nsec) / 1000.0);
+}
+
+static void _tmxr_loadtest_close (TMXR_LT_SESSION *s)
+{
+if (s->sock != INVALID_SOCKET)
+    sim_close_sock (s->sock);
+s->sock = INVALID_SOCKET;
+s->state = TMXR_LT_CLOSED;
+}
+
+static void _tmxr_loadtest_finish (void)
+{
+uint32 i;
+
+for (i = 0; i < tmxr_lt.sessions; i++)
+    _tmxr_loadtest_close (&tmxr_lt.session[i]);
+if (tmxr_lt.active) {
+    tmxr_lt.stop = _tmxr_loadtest_usecs ();
+    tmxr_lt.cpu_stop = clock ();
+    }
+tmxr_lt.active = FALSE;
+sim_cancel (&tmxr_loadtest_unit);
+}
+
+/* Count the data bytes in a received buffer, skipping telnet sequences */
+
+static int32 _tmxr_loadtest_data (TMXR_LT_SESSION *s, const uint8 *buf, int32 len)
+{
+int32 i, data = 0;
+
+for (i = 0; i < len; i++) {
+    uint8 c = buf[i];
+
+    switch (s->telnet) {
+        case 0:                                         /* normal data */
+            if ((c == TN_IAC) && (!tmxr_lt.mp->notelnet))
+                s->telnet = 1;
+            else
+                ++data;
+            break;
+        case 1:                                         /* IAC seen */
+            if (c == TN_IAC) {                          /* escaped data byte */
+                ++data;
+                s->telnet = 0;
+                }
+            else if (c == TN_SB)
+                s->telnet = 3;
+            else if ((c == TN_WILL) || (c == TN_WONT) || (c == TN_DO) || (c == TN_DONT))
+                s->telnet = 2;
+            else
+                s->telnet = 0;
+            break;
+        case 2:                                         /* option byte */
+            s->telnet = 0;
+            break;
+        case 3:                                         /* in sub-negotiation */
+            if (c == TN_IAC)
+                s->telnet = 4;
+            break;
+        case 4:                                         /* IAC in sub-negotiation */
+            s->telnet = (c == TN_SE) ? 0 : 3;
+            break;
+        }
+    }
+return data;
+}
+
+static t_stat _tmxr_loadtest_svc (UNIT *uptr)
+{
+double now = _tmxr_loadtest_usecs ();
+uint8 buf[TMXR_MAXBUF];
+uint32 i;
+
+if (!tmxr_lt.active)
+    return SCPE_OK;
+if (tmxr_lt.start == 0.0) {
+    tmxr_lt.start = now;
+    tmxr_lt.cpu_start = clock ();
+    }
+for (i = 0; i < tmxr_lt.sessions; i++) {
+    TMXR_LT_SESSION *s = &tmxr_lt.session[i];
+    int32 len, data;
+
+    switch (s->state) {
+        case TMXR_LT_CLOSED:
+            continue;
+        case TMXR_LT_CONNECTING:
+            switch (sim_check_conn (s->sock, FALSE)) {
+                case 0:                                 /* still pending */
+                    continue;
+                case 1:                                 /* connected */
+                    s->state = TMXR_LT_SETTLING;
+                    s->last_rcv = now;
+                    ++tmxr_lt.connected;
+                    break;
+                default:                                /* failed */
+                    ++tmxr_lt.disconnects;
+                    _tmxr_loadtest_close (s);
+                    continue;
+                }
+            break;
+        default:
+            break;
+        }
+    len = sim_read_sock (s->sock, (char *)buf, sizeof (buf));
+    if (len < 0) {                                      /* disconnected? */
+        ++tmxr_lt.disconnects;
+        _tmxr_loadtest_close (s);
+        continue;
+        }
+    data = _tmxr_loadtest_data (s, buf, len);
+    tmxr_lt.chars_rcvd += data;
+    if (s->state == TMXR_LT_SETTLING) {
+        if (data)
+            s->last_rcv = now;
+        else
+            if ((now - s->last_rcv) >= TMXR_LT_SETTLE_USECS) {
+                s->state = TMXR_LT_RUNNING;
+                s->next_send = now;
+                }
+        continue;
+        }
+    if (s->outstanding) {
+        if (data) {                                     /* response arrived */
+            if ((tmxr_lt.sample_count == tmxr_lt.sample_size) &&
+                (tmxr_lt.sample_size < TMXR_LT_MAX_SAMPLES)) {
+                tmxr_lt.sample_size = tmxr_lt.sample_size ? 2 * tmxr_lt.sample_size : 4096;
+                tmxr_lt.samples = (uint32 *)realloc (tmxr_lt.samples, tmxr_lt.sample_size * sizeof (*tmxr_lt.samples));
+                }
+            if (tmxr_lt.sample_count < tmxr_lt.sample_size)
+                tmxr_lt.samples[tmxr_lt.sample_count++] = (uint32)(now - s->sent_at);
+            s->outstanding = FALSE;
+            s->next_send = s->sent_at + tmxr_lt.interval;
+            }
+        else
+            if ((now - s->sent_at) >= TMXR_LT_TIMEOUT_USECS) {
+                ++tmxr_lt.timeouts;
+                s->outstanding = FALSE;
+                s->next_send = now;
+                }
+        }
+    if ((!s->outstanding) && (now >= s->next_send)) {
+        char c = (char)tmxr_lt.script[s->script_pos];
+        int32 written = sim_write_sock (s->sock, &c, 1);
+
+        if (written < 0) {
+            ++tmxr_lt.disconnects;
+            _tmxr_loadtest_close (s);
+            continue;
+            }
+        if (written == 1) {
+            ++tmxr_lt.chars_sent;
+            s->script_pos = (s->script_pos + 1) % tmxr_lt.script_size;
+            s->sent_at = now;
+            s->outstanding = TRUE;
+            }
+        }
+    }
+if ((now - tmxr_lt.start) >= (1000000.0 * tmxr_lt.duration)) {
+    _tmxr_loadtest_finish ();
+    sim_printf ("Load test of %s complete\n", tmxr_lt.mp->dptr->name);
+    return SCPE_OK;
+    }
+return sim_activate_after (uptr, TMXR_LT_POLL_USECS);
+}
+
+/* LOADTEST dev {SESSIONS=n,}{INTERVAL=usecs,}{DURATION=secs,}{"script"}
+   NOLOADTEST */
+
+t_stat tmxr_loadtest_cmd (int32 flag, CONST char *cptr)
+{
+char gbuf[CBUFSIZE];
+CONST char *tptr;
+DEVICE *dptr;
+TMXR *mp = NULL;
+uint32 sessions = 1, interval = 100000, duration = 30;
+uint8 script[CBUFSIZE];
+uint32 script_size = 0;
+uint32 i;
+t_stat r;
+
+if (!flag) {                                            /* NOLOADTEST */
+    if (*cptr)
+        return SCPE_2MARG;
+    _tmxr_loadtest_finish ();
+    return SCPE_OK;
+    }
+if (tmxr_lt.active)
+    return sim_messagef (SCPE_ALATT, "A load test of %s is already running\n", tmxr_lt.mp->dptr->name);
+cptr = get_glyph (cptr, gbuf, ',');
+dptr = find_dev (gbuf);
+if (!dptr)
+    return sim_messagef (SCPE_NXDEV, "Non-existent device: %s\n", gbuf);
+for (i = 0; i < (uint32)tmxr_open_device_count; i++)
+    if (tmxr_open_devices[i]->dptr == dptr)
+        mp = tmxr_open_devices[i];
+if ((mp == NULL) || (mp->port == NULL) || (mp->datagram))
+    return sim_messagef (SCPE_UNATT, "%s is not listening on a stream port\n", gbuf);
+while (*cptr) {
+    if ((*cptr == '"') || (*cptr == '\''))
+        break;
+    tptr = get_glyph (cptr, gbuf, ',');
+    if ((!strncmp (gbuf, "SESSIONS=", 9)) && (gbuf[9])) {
+        sessions = (uint32)get_uint (&gbuf[9], 10, 4096, &r);
+        if ((r != SCPE_OK) || (sessions == 0))
+            return sim_messagef (SCPE_ARG, "Invalid Sessions Value\n");
+        }
+    else if ((!strncmp (gbuf, "INTERVAL=", 9)) && (gbuf[9])) {
+        interval = (uint32)get_uint (&gbuf[9], 10, 60000000, &r);
+        if (r != SCPE_OK)
+            return sim_messagef (SCPE_ARG, "Invalid Interval Value\n");
+        }
+    else if ((!strncmp (gbuf, "DURATION=", 9)) && (gbuf[9])) {
+        duration = (uint32)get_uint (&gbuf[9], 10, 86400, &r);
+        if ((r != SCPE_OK) || (duration == 0))
+            return sim_messagef (SCPE_ARG, "Invalid Duration Value\n");
+        }
+    else
+        return sim_messagef (SCPE_ARG, "Unexpected argument: %s\n", gbuf);
+    cptr = tptr;
+    }
+if (*cptr) {
+    cptr = get_glyph_quoted (cptr, gbuf, 0);
+    if (*cptr != '\0')
+        return SCPE_2MARG;
+    if (SCPE_OK != sim_decode_quoted_string (gbuf, script, &script_size))
+        return sim_messagef (SCPE_ARG, "Invalid String\n");
+    }
+if (script_size == 0) {
+    strcpy ((char *)script, "abcdefghijklmnopqrstuvwxyz");
+    script_size = (uint32)strlen ((char *)script);
+    }
+
+_tmxr_loadtest_finish ();                               /* discard any prior results */
+free (tmxr_lt.session);
+free (tmxr_lt.samples);
+memset (&tmxr_lt, 0, sizeof (tmxr_lt));
+tmxr_lt.mp = mp;
+strlcpy (tmxr_lt.port, mp->port, sizeof (tmxr_lt.port));
+memcpy (tmxr_lt.script, script, script_size);
+tmxr_lt.script_size = script_size;
+tmxr_lt.sessions = sessions;
+tmxr_lt.interval = interval;
+tmxr_lt.duration = duration;
+tmxr_lt.session = (TMXR_LT_SESSION *)calloc (sessions, sizeof (*tmxr_lt.session));
+for (i = 0; i < sessions; i++) {
+    TMXR_LT_SESSION *s = &tmxr_lt.session[i];
+
+    s->sock = sim_connect_sock_ex (NULL, tmxr_lt.port, "localhost", NULL, SIM_SOCK_OPT_NODELAY);
+    s->state = (s->sock == INVALID_SOCKET) ? TMXR_LT_CLOSED : TMXR_LT_CONNECTING;
+    s->script_pos = (i * 7) % script_size;              /* stagger the sessions' input */
+    }
+sim_register_internal_device (&tmxr_loadtest_dev);
+tmxr_lt.active = TRUE;
+sim_activate_after (&tmxr_loadtest_unit, TMXR_LT_POLL_USECS);
+if (!sim_is_running)
+    sim_messagef (SCPE_OK, "Load test of %s will run when the simulator is running\n", dptr->name);
+return SCPE_OK;
+}
+
+static int _tmxr_loadtest_cmp (const void *a, const void *b)
+{
+uint32 ua = *(const uint32 *)a, ub = *(const uint32 *)b;
+
+return (ua < ub) ? -1 : ((ua > ub) ? 1 : 0);
+}
+
+t_stat tmxr_show_loadtest (FILE* st, DEVICE *dptr, UNIT* uptr, int32 val, CONST char* desc)
+{
+double elapsed, cpu;
+uint32 n = tmxr_lt.sample_count;
+
+if (tmxr_lt.mp == NULL) {
+    fprintf (st, "No load test has been run\n");
+    return SCPE_OK;
+    }
+if (tmxr_lt.start == 0.0) {
+    fprintf (st, "Load test of %s on %s with %u sessions has not started\n", tmxr_lt.mp->dptr->name, tmxr_lt.port, tmxr_lt.sessions);
+    return SCPE_OK;
+    }
+elapsed = ((tmxr_lt.active ? _tmxr_loadtest_usecs () : tmxr_lt.stop) - tmxr_lt.start) / 1000000.0;
+cpu = ((double)((tmxr_lt.active ? clock () : tmxr_lt.cpu_stop) - tmxr_lt.cpu_start)) / CLOCKS_PER_SEC;
+if (elapsed <= 0.0)
+    elapsed = 1.0e-6;
+fprintf (st, "Load test of %s on %s: %s %.1f seconds\n", tmxr_lt.mp->dptr->name, tmxr_lt.port, 
+             tmxr_lt.active ? "running for" : "ran for", elapsed);
+fprintf (st, "  Sessions:              %u (%u connected, %u disconnected)\n", tmxr_lt.sessions, tmxr_lt.connected, tmxr_lt.disconnects);
+fprintf (st, "  Characters Sent:       %" LL_FMT "u (%.1f/sec)\n", (unsigned LL_TYPE)tmxr_lt.chars_sent, tmxr_lt.chars_sent / elapsed);
+fprintf (st, "  Characters Received:   %" LL_FMT "u (%.1f/sec)\n", (unsigned LL_TYPE)tmxr_lt.chars_rcvd, tmxr_lt.chars_rcvd / elapsed);
+fprintf (st, "  Response Timeouts:     %u\n", tmxr_lt.timeouts);
+if (n) {
+    uint32 *sorted = (uint32 *)malloc (n * sizeof (*sorted));
+
+    memcpy (sorted, tmxr_lt.samples, n * sizeof (*sorted));
+    qsort (sorted, n, sizeof (*sorted), _tmxr_loadtest_cmp);
+    fprintf (st, "  Echo Latency (usecs):  %u samples\n", n);
+    fprintf (st, "    min %u, 50%% %u, 90%% %u, 99%% %u, 99.9%% %u, max %u\n", sorted[0], 
+                 sorted[(n - 1) / 2], sorted[(uint32)((n - 1) * 0.90)], sorted[(uint32)((n - 1) * 0.99)], 
+                 sorted[(uint32)((n - 1) * 0.999)], sorted[n - 1]);
+    free (sorted);
+    }
+fprintf (st, "  Host CPU:              %.1f seconds (%.1f%% of one processor)\n", cpu, 100.0 * cpu / elapsed);
+return SCPE_OK;
+}
+
 /* Stub examine and deposit */
 
 t_stat tmxr_ex (t_value *vptr, t_addr addr, UNIT *uptr, int32 sw)
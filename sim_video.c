@@ -362,6 +362,35 @@ SDL_Texture *vid_texture;                               /* video buffer in GPU *
 SDL_Renderer *vid_renderer;
 SDL_Window *vid_window;                                 /* window handle */
 uint32 vid_windowID;
+
+/* Damage tracked framebuffer
+
+   vid_draw copies into a framebuffer shared with the video thread and
+   marks the tiles it touched.  Only the first vid_draw after the video
+   thread last caught up posts an EVENT_DRAW.  The video thread then
+   takes the tile map and copies just the dirty tiles into its own
+   buffer while holding the lock, and afterwards coalesces them into
+   rectangles and uploads those to the texture without the lock, so
+   vid_draw never waits on the renderer.  This avoids allocating and
+   copying a private buffer for every vid_draw call, and keeps a
+   device which draws faster than the screen refreshes from flooding
+   the event queue.
+*/
+#define VID_TILE_SHIFT  5                               /* 32 x 32 pixel tiles */
+#define VID_TILE_SIZE   (1 << VID_TILE_SHIFT)
+
+static uint32 *vid_fb = NULL;                           /* framebuffer shared with video thread */
+static uint8 *vid_damage = NULL;                        /* dirty tile map */
+static uint32 *vid_fb_upload = NULL;                    /* video thread copy of dirty tiles */
+static uint8 *vid_damage_upload = NULL;                 /* tile map being uploaded */
+static int32 vid_tiles_x;                               /* tile map width */
+static int32 vid_tiles_y;                               /* tile map height */
+static t_bool vid_damage_pending = FALSE;               /* EVENT_DRAW outstanding */
+static SDL_mutex *vid_fb_lock = NULL;                   /* framebuffer and tile map lock */
+static uint32 vid_draw_calls = 0;                       /* vid_draw calls */
+static uint32 vid_draw_events = 0;                      /* EVENT_DRAWs processed */
+static uint32 vid_damage_rects = 0;                     /* rectangles uploaded */
+static double vid_damage_pixels = 0;                    /* pixels uploaded */
 #endif
 SDL_Thread *vid_thread_handle = NULL;                   /* event thread handle */
 SDL_Cursor *vid_cursor = NULL;                          /* current cursor */
@@ -505,6 +534,24 @@ return SCPE_OK;
 }
 #endif
 
+#if SDL_MAJOR_VERSION != 1
+static void vid_free_framebuffer (void)
+{
+free (vid_fb);
+vid_fb = NULL;
+free (vid_damage);
+vid_damage = NULL;
+free (vid_fb_upload);
+vid_fb_upload = NULL;
+free (vid_damage_upload);
+vid_damage_upload = NULL;
+if (vid_fb_lock) {
+    SDL_DestroyMutex (vid_fb_lock);
+    vid_fb_lock = NULL;
+    }
+}
+#endif
+
 t_stat vid_open (DEVICE *dptr, const char *title, uint32 width, uint32 height, int flags)
 {
 if (!vid_active) {
@@ -533,6 +580,24 @@ if (!vid_active) {
 
     vid_dev = dptr;
 
+#if SDL_MAJOR_VERSION != 1
+    vid_tiles_x = (vid_width + VID_TILE_SIZE - 1) >> VID_TILE_SHIFT;
+    vid_tiles_y = (vid_height + VID_TILE_SIZE - 1) >> VID_TILE_SHIFT;
+    vid_fb = (uint32 *)calloc (vid_width * vid_height, sizeof (*vid_fb));
+    vid_damage = (uint8 *)calloc (vid_tiles_x * vid_tiles_y, sizeof (*vid_damage));
+    vid_fb_upload = (uint32 *)calloc (vid_width * vid_height, sizeof (*vid_fb_upload));
+    vid_damage_upload = (uint8 *)calloc (vid_tiles_x * vid_tiles_y, sizeof (*vid_damage_upload));
+    vid_fb_lock = SDL_CreateMutex ();
+    vid_damage_pending = FALSE;
+    vid_draw_calls = vid_draw_events = vid_damage_rects = 0;
+    vid_damage_pixels = 0;
+    if ((vid_fb == NULL) || (vid_damage == NULL) || (vid_fb_lock == NULL) ||
+        (vid_fb_upload == NULL) || (vid_damage_upload == NULL)) {
+        vid_active = FALSE;
+        vid_free_framebuffer ();
+        return SCPE_MEM;
+        }
+#endif
     stat = vid_create_window ();
     if (stat != SCPE_OK)
         return stat;
@@ -574,6 +639,9 @@ if (vid_active) {
         SDL_DestroySemaphore(vid_key_events.sem);
         vid_key_events.sem = NULL;
         }
+#if SDL_MAJOR_VERSION != 1
+    vid_free_framebuffer ();
+#endif
     }
 return SCPE_OK;
 }
@@ -640,35 +708,37 @@ for (i = 0; i < h; i++)
     memcpy (pixels + ((i + y) * vid_width) + x, buf + w*i, w*sizeof(*pixels));
 #else
 SDL_Event user_event;
-SDL_Rect *vid_dst;
-uint32 *vid_data;
+int32 i, tx1, tx2, ty;
+t_bool post;
 
 sim_debug (SIM_VID_DBG_VIDEO, vid_dev, "vid_draw(%d, %d, %d, %d)\n", x, y, w, h);
 
-vid_dst = (SDL_Rect *)malloc (sizeof(*vid_dst));
-if (!vid_dst) {
-    sim_printf ("%s: vid_draw() memory allocation error\n", vid_dev ? sim_dname(vid_dev) : "Video Device");
+if ((!vid_fb) ||
+    (x < 0) || (y < 0) || (w <= 0) || (h <= 0) ||
+    (x + w > vid_width) || (y + h > vid_height))
     return;
-    }
-vid_dst->x = x;
-vid_dst->y = y;
-vid_dst->w = w;
-vid_dst->h = h;
-vid_data = (uint32 *)malloc (w*h*sizeof(*buf));
-if (!vid_data) {
-    sim_printf ("%s: vid_draw() memory allocation error\n", vid_dev ? sim_dname(vid_dev) : "Video Device");
-    free (vid_dst);
+tx1 = x >> VID_TILE_SHIFT;
+tx2 = (x + w - 1) >> VID_TILE_SHIFT;
+SDL_LockMutex (vid_fb_lock);
+for (i = 0; i < h; i++)
+    memcpy (vid_fb + ((i + y) * vid_width) + x, buf + w*i, w*sizeof(*buf));
+for (ty = y >> VID_TILE_SHIFT; ty <= ((y + h - 1) >> VID_TILE_SHIFT); ty++)
+    memset (vid_damage + (ty * vid_tiles_x) + tx1, 1, tx2 - tx1 + 1);
+++vid_draw_calls;
+post = !vid_damage_pending;
+vid_damage_pending = TRUE;
+SDL_UnlockMutex (vid_fb_lock);
+if (!post)                                              /* video thread already notified? */
     return;
-    }
-memcpy (vid_data, buf, w*h*sizeof(*buf));
 user_event.type = SDL_USEREVENT;
 user_event.user.code = EVENT_DRAW;
-user_event.user.data1 = (void *)vid_dst;
-user_event.user.data2 = (void *)vid_data;
+user_event.user.data1 = NULL;
+user_event.user.data2 = NULL;
 if (SDL_PushEvent (&user_event) < 0) {
     sim_printf ("%s: vid_draw() SDL_PushEvent error: %s\n", vid_dev ? sim_dname(vid_dev) : "Video Device", SDL_GetError());
-    free (vid_dst);
-    free (vid_data);
+    SDL_LockMutex (vid_fb_lock);
+    vid_damage_pending = FALSE;                         /* retry with the next draw */
+    SDL_UnlockMutex (vid_fb_lock);
     }
 #endif
 }
@@ -1409,32 +1479,74 @@ SDL_WarpMouseInWindow (NULL, vid_cursor_x, vid_cursor_y);
 SDL_PumpEvents ();
 }
 
-void vid_draw_region (SDL_UserEvent *event)
+#if SDL_MAJOR_VERSION != 1
+/* Upload the damaged parts of the framebuffer to the texture.  The
+   tile map is swapped out and the dirty tiles copied under the lock;
+   the uploads then run without it.  Each horizontal run of dirty tiles
+   is extended down through the rows below which have the same run
+   dirty, so typical damage (a few scanlines, a character cell, a
+   moving cursor) becomes one or two rectangles.
+*/
+void vid_draw_damage (void)
 {
-SDL_Rect *vid_dst = (SDL_Rect *)event->data1;
-uint32 *buf = (uint32 *)event->data2;
-
-sim_debug (SIM_VID_DBG_VIDEO, vid_dev, "Draw Region Event: (%d,%d,%d,%d)\n", vid_dst->x, vid_dst->x, vid_dst->w, vid_dst->h);
-
-#if SDL_MAJOR_VERSION == 1
-if (1) {
-    int32 i;
-    uint32* pixels;
-
-    pixels = (uint32 *)vid_image->pixels;
-
-    for (i = 0; i < vid_dst->h; i++)
-        memcpy (pixels + ((i + vid_dst->y) * vid_width) + vid_dst->x, buf + vid_dst->w*i, vid_dst->w*sizeof(*pixels));
+SDL_Rect rect;
+int32 tx, tx2, ty, ty2, t, y, ylim, w;
+uint8 *row, *map;
+size_t off;
+
+SDL_LockMutex (vid_fb_lock);
+vid_damage_pending = FALSE;
+++vid_draw_events;
+map = vid_damage;                                       /* take the dirty map */
+vid_damage = vid_damage_upload;                         /* vid_draw marks a clean one */
+vid_damage_upload = map;
+for (ty = 0; ty < vid_tiles_y; ty++) {
+    row = map + (ty * vid_tiles_x);
+    ylim = ((ty + 1) << VID_TILE_SHIFT) < vid_height ? (ty + 1) << VID_TILE_SHIFT : vid_height;
+    for (tx = 0; tx < vid_tiles_x; tx++) {
+        if (!row[tx])
+            continue;
+        for (tx2 = tx; (tx2 < vid_tiles_x) && row[tx2]; tx2++)
+            ;                                           /* copy whole run */
+        w = ((tx2 << VID_TILE_SHIFT) < vid_width) ? (tx2 << VID_TILE_SHIFT) - (tx << VID_TILE_SHIFT) : vid_width - (tx << VID_TILE_SHIFT);
+        for (y = ty << VID_TILE_SHIFT; y < ylim; y++) {
+            off = (size_t)y * vid_width + (tx << VID_TILE_SHIFT);
+            memcpy (vid_fb_upload + off, vid_fb + off, w * sizeof (*vid_fb));
+            }
+        tx = tx2;
+        }
+    }
+SDL_UnlockMutex (vid_fb_lock);
+for (ty = 0; ty < vid_tiles_y; ty++) {
+    row = map + (ty * vid_tiles_x);
+    for (tx = 0; tx < vid_tiles_x; tx++) {
+        if (!row[tx])
+            continue;
+        for (tx2 = tx; (tx2 < vid_tiles_x) && row[tx2]; tx2++)
+            row[tx2] = 0;                               /* horizontal run */
+        for (ty2 = ty + 1; ty2 < vid_tiles_y; ty2++) {  /* same run below? */
+            uint8 *below = map + (ty2 * vid_tiles_x);
+
+            for (t = tx; (t < tx2) && below[t]; t++)
+                ;
+            if (t < tx2)
+                break;
+            memset (below + tx, 0, tx2 - tx);
+            }
+        rect.x = tx << VID_TILE_SHIFT;
+        rect.y = ty << VID_TILE_SHIFT;
+        rect.w = ((tx2 << VID_TILE_SHIFT) < vid_width) ? (tx2 << VID_TILE_SHIFT) - rect.x : vid_width - rect.x;
+        rect.h = ((ty2 << VID_TILE_SHIFT) < vid_height) ? (ty2 << VID_TILE_SHIFT) - rect.y : vid_height - rect.y;
+        sim_debug (SIM_VID_DBG_VIDEO, vid_dev, "Draw Damage Event: (%d,%d,%d,%d)\n", rect.x, rect.y, rect.w, rect.h);
+        if (SDL_UpdateTexture (vid_texture, &rect, vid_fb_upload + (rect.y * vid_width) + rect.x, vid_width*sizeof(*vid_fb_upload)))
+            sim_printf ("%s: vid_draw() - SDL_UpdateTexture error: %s\n", sim_dname(vid_dev), SDL_GetError());
+        ++vid_damage_rects;
+        vid_damage_pixels += (double)rect.w * rect.h;
+        tx = tx2;
+        }
     }
-#else
-if (SDL_UpdateTexture(vid_texture, vid_dst, buf, vid_dst->w*sizeof(*buf)))
-    sim_printf ("%s: vid_draw() - SDL_UpdateTexture error: %s\n", sim_dname(vid_dev), SDL_GetError());
-#endif
-
-free (vid_dst);
-free (buf);
-event->data1 = NULL;
 }
+#endif
 
 int vid_video_events (void)
 {
@@ -1745,7 +1857,9 @@ if (0)                        while (SDL_PeepEvents (&event, 1, SDL_GETEVENT, SD
                         event.user.code = 0;    /* Mark as done */
                         }
                     if (event.user.code == EVENT_DRAW) {
-                        vid_draw_region ((SDL_UserEvent*)&event);
+#if SDL_MAJOR_VERSION != 1
+                        vid_draw_damage ();
+#endif
                         event.user.code = 0;    /* Mark as done */
                         }
                     if (event.user.code == EVENT_SHOW) {
@@ -1984,6 +2098,10 @@ if (vid_active) {
 
     SDL_GetRendererInfo (vid_renderer, &info);
     fprintf (st, "  Currently Active Renderer: %s\n", info.name);
+    fprintf (st, "  Draw Calls: %s", sim_fmt_numeric ((double)vid_draw_calls));
+    fprintf (st, ", Texture Updates: %s", sim_fmt_numeric ((double)vid_draw_events));
+    fprintf (st, ", Damage Rectangles: %s", sim_fmt_numeric ((double)vid_damage_rects));
+    fprintf (st, ", Pixels Uploaded: %s\n", sim_fmt_numeric (vid_damage_pixels));
     }
 if (1) {
     static const char *hints[] = {
@@ -2300,18 +2418,79 @@ vid_beep_event ();
 SDL_Delay (vid_beep_duration + 100);/* Wait for sound to finnish */
 }
 
+t_stat vid_set_video (int32 flag, CONST char *cptr)
+{
+return sim_messagef (SCPE_NOFNC, "Frame recording is only available in simulators built without libSDL\n");
+}
+
 #else /* !(defined(USE_SIM_VIDEO) && defined(HAVE_LIBSDL)) */
-/* Non-implemented versions */
+/* Headless video
+
+   Without libSDL there is no window to display into, but the simulated
+   video devices still run.  vid_open allocates an in-memory framebuffer
+   which vid_draw keeps current, and which the SCREENSHOT command saves.
+
+   SET VIDEO RECORD=prefix samples the framebuffer at every vid_refresh
+   (every nth one with SET VIDEO SAMPLE=n) and writes each sample which
+   differs from the last frame written to prefix-nnnnnnnn.png (.bmp when
+   libpng isn't available), nnnnnnnn being the refresh count since the
+   display was opened.  Unchanged samples cost a flag test, so recording
+   a mostly static display is cheap and the frame files only appear when
+   something was drawn, which is what GUI regression tests compare.
+*/
+
+#if defined(HAVE_LIBPNG)
+#include <png.h>
+#endif
 
 uint32 vid_mono_palette[2];                             /* Monochrome Color Map */
+static DEVICE *vid_dev;
+static uint32 *vid_fb = NULL;                           /* framebuffer */
+static int32 vid_width;
+static int32 vid_height;
+static t_bool vid_fb_changed;                           /* changed since last frame written */
+static char *vid_record_prefix = NULL;                  /* frame file prefix */
+static uint32 vid_record_sample = 1;                    /* sample every n refreshes */
+static uint32 vid_draw_calls;                           /* statistics */
+static t_uint64 vid_draw_pixels;
+static t_uint64 vid_changed_pixels;
+static uint32 vid_refreshes;
+static uint32 vid_frames_written;
+static uint32 vid_frames_unchanged;
+static t_uint64 vid_record_bytes;
+static t_uint64 vid_record_ns;
 
 t_stat vid_open (DEVICE *dptr, const char *title, uint32 width, uint32 height, int flags)
 {
-return SCPE_NOFNC;
+if (!vid_active) {
+    vid_fb = (uint32 *)calloc (width * height, sizeof (*vid_fb));
+    if (vid_fb == NULL)
+        return SCPE_MEM;
+    vid_mono_palette[0] = sim_end ? 0xFF000000 : 0x000000FF;/* Black */
+    vid_mono_palette[1] = 0xFFFFFFFF;                   /* White */
+    vid_dev = dptr;
+    vid_width = width;
+    vid_height = height;
+    vid_fb_changed = TRUE;
+    vid_draw_calls = vid_refreshes = 0;
+    vid_frames_written = vid_frames_unchanged = 0;
+    vid_draw_pixels = vid_changed_pixels = 0;
+    vid_record_bytes = vid_record_ns = 0;
+    vid_active = TRUE;
+    sim_debug (SIM_VID_DBG_VIDEO, vid_dev, "vid_open() - Headless %dx%d\n", vid_width, vid_height);
+    }
+return SCPE_OK;
 }
 
 t_stat vid_close (void)
 {
+if (vid_active) {
+    sim_debug (SIM_VID_DBG_VIDEO, vid_dev, "vid_close()\n");
+    vid_active = FALSE;
+    free (vid_fb);
+    vid_fb = NULL;
+    vid_dev = NULL;
+    }
 return SCPE_OK;
 }
 
@@ -2327,22 +2506,198 @@ return SCPE_EOF;
 
 void vid_draw (int32 x, int32 y, int32 w, int32 h, uint32 *buf)
 {
-return;
+int32 i;
+uint32 *row;
+
+if ((!vid_fb) ||
+    (x < 0) || (y < 0) || (w <= 0) || (h <= 0) ||
+    (x + w > vid_width) || (y + h > vid_height))
+    return;
+++vid_draw_calls;
+vid_draw_pixels += w * h;
+for (i = 0; i < h; i++) {
+    row = vid_fb + ((i + y) * vid_width) + x;
+    if (memcmp (row, buf + w*i, w*sizeof(*buf))) {      /* only note real changes */
+        memcpy (row, buf + w*i, w*sizeof(*buf));
+        vid_changed_pixels += w;
+        vid_fb_changed = TRUE;
+        }
+    }
 }
 
 t_stat vid_set_cursor (t_bool visible, uint32 width, uint32 height, uint8 *data, uint8 *mask, uint32 hot_x, uint32 hot_y)
 {
-return SCPE_NOFNC;
+return SCPE_OK;
 }
 
 void vid_set_cursor_position (int32 x, int32 y)
 {
-return;
+vid_cursor_x = x;
+vid_cursor_y = y;
+}
+
+#if defined(HAVE_LIBPNG)
+/* Write the framebuffer as an RGB PNG file
+
+   The framebuffer pixels are B, G, R, A in memory on either endian host
+   (see vid_mono_palette), so libpng is told to swap to RGB and drop the
+   alpha byte rather than converting a copy of the image.  Row filtering
+   is turned off: simulated displays are mostly flat areas which deflate
+   well as they are, and libpng's adaptive filter selection makes every
+   frame many times slower to write.
+*/
+
+static int vid_write_png (FILE *f)
+{
+png_structp png_ptr;
+png_infop info_ptr;
+png_bytep *row_pointers;
+int32 i;
+
+png_ptr = png_create_write_struct (PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+if (!png_ptr)
+    return -1;
+info_ptr = png_create_info_struct (png_ptr);
+if (!info_ptr) {
+    png_destroy_write_struct (&png_ptr, NULL);
+    return -1;
+    }
+row_pointers = (png_bytep *)malloc (vid_height * sizeof (*row_pointers));
+if ((row_pointers == NULL) || setjmp (png_jmpbuf (png_ptr))) {
+    png_destroy_write_struct (&png_ptr, &info_ptr);
+    free (row_pointers);
+    return -1;
+    }
+png_init_io (png_ptr, f);
+png_set_IHDR (png_ptr, info_ptr, vid_width, vid_height, 8, PNG_COLOR_TYPE_RGB,
+    PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+png_set_filter (png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+png_write_info (png_ptr, info_ptr);
+png_set_bgr (png_ptr);
+png_set_filler (png_ptr, 0, PNG_FILLER_AFTER);
+for (i = 0; i < vid_height; i++)
+    row_pointers[i] = (png_bytep)(vid_fb + i * vid_width);
+png_write_image (png_ptr, row_pointers);
+png_write_end (png_ptr, info_ptr);
+png_destroy_write_struct (&png_ptr, &info_ptr);
+free (row_pointers);
+return 0;
+}
+#endif /* defined(HAVE_LIBPNG) */
+
+/* Write the framebuffer as a 24 bit BMP file */
+
+static void vid_put_le (uint8 *p, uint32 val, int bytes)
+{
+while (bytes--) {
+    *p++ = val & 0xFF;
+    val >>= 8;
+    }
+}
+
+static int vid_write_bmp (FILE *f)
+{
+uint32 pitch = (vid_width * 3 + 3) & ~3;                /* rows are longword aligned */
+uint8 hdr[54];
+uint8 *line;
+uint8 *src;
+int32 x, y;
+
+memset (hdr, 0, sizeof (hdr));
+hdr[0] = 'B';
+hdr[1] = 'M';
+vid_put_le (&hdr[2], sizeof (hdr) + pitch * vid_height, 4);/* file size */
+vid_put_le (&hdr[10], sizeof (hdr), 4);                 /* pixel data offset */
+vid_put_le (&hdr[14], 40, 4);                           /* BITMAPINFOHEADER */
+vid_put_le (&hdr[18], vid_width, 4);
+vid_put_le (&hdr[22], vid_height, 4);                   /* bottom up */
+vid_put_le (&hdr[26], 1, 2);                            /* planes */
+vid_put_le (&hdr[28], 24, 2);                           /* bits per pixel */
+vid_put_le (&hdr[34], pitch * vid_height, 4);
+if (fwrite (hdr, sizeof (hdr), 1, f) != 1)
+    return -1;
+line = (uint8 *)calloc (pitch, 1);
+if (line == NULL)
+    return -1;
+for (y = vid_height - 1; y >= 0; y--) {
+    src = (uint8 *)(vid_fb + y * vid_width);
+    for (x = 0; x < vid_width; x++, src += 4)           /* B, G, R, A in memory */
+        memcpy (&line[x * 3], src, 3);
+    if (fwrite (line, pitch, 1, f) != 1) {
+        free (line);
+        return -1;
+        }
+    }
+free (line);
+return 0;
+}
+
+/* Save the framebuffer, in the format given by the file name's extension */
+
+static t_stat vid_save_frame (const char *filename, t_uint64 *bytes)
+{
+FILE *f;
+int stat;
+
+f = fopen (filename, "wb");
+if (f == NULL)
+    return SCPE_OPENERR;
+#if defined(HAVE_LIBPNG)
+if (!match_ext (filename, "bmp"))
+    stat = vid_write_png (f);
+else
+#endif
+    stat = vid_write_bmp (f);
+if (bytes)
+    *bytes += (t_uint64)ftell (f);
+if (fclose (f))
+    stat = -1;
+return stat ? SCPE_IOERR : SCPE_OK;
+}
+
+static void vid_record_stop (void)
+{
+free (vid_record_prefix);
+vid_record_prefix = NULL;
 }
 
 void vid_refresh (void)
 {
-return;
+char *filename;
+t_uint64 start;
+t_stat r;
+
+if (!vid_active)
+    return;
+++vid_refreshes;
+if ((vid_record_prefix == NULL) ||
+    (vid_refreshes % vid_record_sample))
+    return;
+if (!vid_fb_changed) {
+    ++vid_frames_unchanged;
+    return;
+    }
+filename = (char *)malloc (strlen (vid_record_prefix) + 14);
+if (filename == NULL)
+    return;
+#if defined(HAVE_LIBPNG)
+sprintf (filename, "%s-%08u.png", vid_record_prefix, vid_refreshes);
+#else
+sprintf (filename, "%s-%08u.bmp", vid_record_prefix, vid_refreshes);
+#endif
+start = sim_os_nsec ();
+r = vid_save_frame (filename, &vid_record_bytes);
+vid_record_ns += sim_os_nsec () - start;
+if (r != SCPE_OK) {
+    sim_printf ("Error writing video frame %s, recording stopped\n", filename);
+    vid_record_stop ();
+    }
+else {
+    sim_debug (SIM_VID_DBG_VIDEO, vid_dev, "vid_refresh() - Frame written to %s\n", filename);
+    ++vid_frames_written;
+    vid_fb_changed = FALSE;
+    }
+free (filename);
 }
 
 void vid_beep (void)
@@ -2352,7 +2707,11 @@ return;
 
 const char *vid_version (void)
 {
+#if defined(USE_SIM_VIDEO)
+return "No Video Support (headless frame capture only)";
+#else
 return "No Video Support";
+#endif
 }
 
 t_stat vid_set_release_key (FILE* st, UNIT* uptr, int32 val, CONST void* desc)
@@ -2366,15 +2725,102 @@ fprintf (st, "no release key");
 return SCPE_OK;
 }
 
+/* SET VIDEO RECORD=prefix, NORECORD and SAMPLE=n */
+
+t_stat vid_set_video (int32 flag, CONST char *cptr)
+{
+char *cvptr, gbuf[CBUFSIZE];
+t_stat r;
+int32 val;
+
+if ((cptr == NULL) || (*cptr == 0))
+    return SCPE_2FARG;
+while (*cptr != 0) {                                    /* do all mods */
+    cptr = get_glyph_nc (cptr, gbuf, ',');              /* get modifier */
+    if ((cvptr = strchr (gbuf, '=')))                   /* = value? */
+        *cvptr++ = 0;
+    get_glyph (gbuf, gbuf, 0);                          /* modifier to UC */
+    if (MATCH_CMD (gbuf, "RECORD") == 0) {
+        if ((cvptr == NULL) || (*cvptr == 0))
+            return sim_messagef (SCPE_2FARG, "Missing frame file prefix\n");
+        vid_record_stop ();
+        vid_record_prefix = (char *)malloc (strlen (cvptr) + 1);
+        if (vid_record_prefix == NULL)
+            return SCPE_MEM;
+        strcpy (vid_record_prefix, cvptr);
+        vid_fb_changed = TRUE;                          /* first sample is always written */
+        }
+    else if (MATCH_CMD (gbuf, "NORECORD") == 0) {
+        if (cvptr)
+            return SCPE_2MARG;
+        vid_record_stop ();
+        }
+    else if (MATCH_CMD (gbuf, "SAMPLE") == 0) {
+        if ((cvptr == NULL) || (*cvptr == 0))
+            return SCPE_2FARG;
+        val = (int32) get_uint (cvptr, 10, 1000000, &r);
+        if ((r != SCPE_OK) || (val == 0))
+            return sim_messagef (SCPE_ARG, "Invalid sample interval: %s\n", cvptr);
+        vid_record_sample = val;
+        }
+    else
+        return SCPE_NOPARAM;
+    }
+return SCPE_OK;
+}
+
 t_stat vid_show_video (FILE* st, UNIT* uptr, int32 val, CONST void* desc)
 {
-fprintf (st, "video support unavailable");
+fprintf (st, "Headless video support (no libSDL)\n");
+if (vid_active)
+    fprintf (st, "  Currently Active Display: %s (%d by %d pixels)\n", vid_dev ? sim_dname (vid_dev) : "", vid_width, vid_height);
+else
+    fprintf (st, "  No display currently active\n");
+if (vid_record_prefix)
+    fprintf (st, "  Recording changed frames to: %s-nnnnnnnn.%s every %u refresh%s\n", vid_record_prefix,
+#if defined(HAVE_LIBPNG)
+                 "png",
+#else
+                 "bmp",
+#endif
+                 vid_record_sample, (vid_record_sample == 1) ? "" : "es");
+else
+    fprintf (st, "  Not recording frames\n");
+fprintf (st, "  Draw Calls: %u, Pixels Drawn: %" LL_FMT "u, Pixels Changed: %" LL_FMT "u\n", vid_draw_calls, vid_draw_pixels, vid_changed_pixels);
+fprintf (st, "  Refreshes: %u, Frames Written: %u, Unchanged Samples: %u\n", vid_refreshes, vid_frames_written, vid_frames_unchanged);
+if (vid_frames_written)
+    fprintf (st, "  Bytes Written: %" LL_FMT "u, Average Frame Write Time: %.3f ms\n", vid_record_bytes, ((double)vid_record_ns / vid_frames_written) / 1000000.0);
 return SCPE_OK;
 }
 
 t_stat vid_screenshot (const char *filename)
 {
-sim_printf ("video support unavailable\n");
-return SCPE_NOFNC|SCPE_NOMESSAGE;
+char *fullname;
+t_stat r;
+
+if (!vid_active) {
+    sim_printf ("No video display is active\n");
+    return SCPE_UDIS | SCPE_NOMESSAGE;
+    }
+fullname = (char *)malloc (strlen(filename) + 5);
+if (!fullname)
+    return SCPE_MEM;
+#if defined(HAVE_LIBPNG)
+if (!match_ext (filename, "bmp"))
+    sprintf (fullname, "%s%s", filename, match_ext (filename, "png") ? "" : ".png");
+else
+    sprintf (fullname, "%s", filename);
+#else
+sprintf (fullname, "%s%s", filename, match_ext (filename, "bmp") ? "" : ".bmp");
+#endif
+r = vid_save_frame (fullname, NULL);
+if (r != SCPE_OK)
+    sim_printf ("Error saving screenshot to %s\n", fullname);
+else {
+    if (!sim_quiet)
+        sim_printf ("Screenshot saved to %s\n", fullname);
+    }
+free (fullname);
+return (r != SCPE_OK) ? (r | SCPE_NOMESSAGE) : SCPE_OK;
 }
 #endif /* defined(USE_SIM_VIDEO) */
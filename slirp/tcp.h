@@ -38,8 +38,11 @@ typedef	uint32_t tcp_seq;
 #define      PR_SLOWHZ       2               /* 2 slow timeouts per second (approx) */
 #define      PR_FASTHZ       5               /* 5 fast timeouts per second (not important) */
 
-#define TCP_SNDSPACE 8192
-#define TCP_RCVSPACE 8192
+/* Large enough to keep a fast guest transfer streaming, yet (after being
+   rounded up to a multiple of the MSS) still below TCP_MAXWIN since window
+   scaling isn't negotiated with the guest */
+#define TCP_SNDSPACE (60*1024)
+#define TCP_RCVSPACE (60*1024)
 
 /*
  * TCP header.
@@ -0,0 +1,553 @@
+/* nat_bench.c: NAT (SLiRP) throughput benchmark
+
+   Copyright (c) 2026, The simh developers
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+   THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+   CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   This program measures TCP throughput through the NAT (nat:) network
+   attachment, iperf style.  It opens the same SLiRP engine a simulated
+   Ethernet device would, plays the part of the guest with a minimal TCP
+   sender and receiver, and runs the engine's select/dispatch loop itself,
+   the way the device reader thread does.  A host thread listens on the
+   loopback address and is reached by the guest at the NAT gateway address.
+
+   Two transfers are timed: guest to host, which ends when the host side
+   has read every byte, and host to guest, which ends when the guest has
+   received every byte.  The NAT statistics shown by SHOW <dev> ETH are
+   printed afterwards.
+
+   Build with "make natbench" and run as
+
+        natbench {megabytes {port}}
+
+   The default is 64 megabytes each way on port 5201.  The exit status is
+   non-zero if a transfer fails or stalls.
+*/
+
+#include "sim_defs.h"
+#include "sim_sock.h"
+#include "sim_slirp.h"
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#define BENCH_MSS       1460                            /* guest segment size */
+#define BENCH_WINDOW    65535                           /* guest receive window */
+#define BENCH_RTO_MS    250                             /* go back after no progress */
+#define BENCH_STALL_MS  10000                           /* give up after no progress */
+
+#define ETH_HDR         14
+#define IP_HDR          20
+#define TCP_HDR         20
+
+#define TH_FIN          0x01
+#define TH_SYN          0x02
+#define TH_RST          0x04
+#define TH_PUSH         0x08
+#define TH_ACK          0x10
+
+#define SEQ_LT(a,b)     ((int32)((a) - (b)) < 0)
+#define SEQ_GT(a,b)     ((int32)((a) - (b)) > 0)
+
+#define GET16(p)        (((uint32)(p)[0] << 8) | (p)[1])
+#define GET32(p)        ((GET16(p) << 16) | GET16((p) + 2))
+#define PUT16(p,v)      ((p)[0] = (uint8)((v) >> 8), (p)[1] = (uint8)(v))
+#define PUT32(p,v)      (PUT16((p), (v) >> 16), PUT16((p) + 2, (v)))
+
+typedef enum {
+    GTCP_CLOSED,
+    GTCP_SYN_SENT,
+    GTCP_ESTABLISHED,
+    GTCP_FAILED
+    } GTCP_STATE;
+
+typedef struct {
+    SLIRP           *slirp;
+    t_bool          gw_known;                           /* gateway MAC learned */
+    uint8           gw_mac[6];
+    GTCP_STATE      state;
+    uint16          lport;                              /* guest port */
+    uint16          rport;                              /* host port */
+    uint32          snd_una;                            /* oldest unacknowledged */
+    uint32          snd_nxt;                            /* next to send */
+    uint32          snd_max;                            /* highest sent */
+    uint32          snd_end;                            /* sequence after last byte */
+    uint32          snd_bytes;                          /* bytes to send */
+    uint32          snd_wnd;                            /* peer's window */
+    uint32          rcv_nxt;                            /* next expected */
+    t_bool          ack_needed;
+    t_uint64        received;                           /* bytes delivered to guest */
+    double          progress;                           /* time of last progress */
+    } GUEST;
+
+typedef struct {
+    SOCKET          master;
+    t_uint64        total;                              /* bytes per transfer */
+    pthread_mutex_t lock;
+    t_uint64        received;                           /* bytes read from guest */
+    t_bool          failed;
+    } HOST;
+
+static const uint8 guest_mac[6] = { 0x52, 0x54, 0x00, 0x12, 0x34, 0x56 };
+static const uint8 guest_ip[4] = { 10, 0, 2, 15 };
+static const uint8 gw_ip[4] = { 10, 0, 2, 2 };
+static uint8 payload[BENCH_MSS];
+
+/* The scp routines which the NAT code calls */
+
+#define BENCH_SPACE(c)  (((c) == ' ') || ((c) == '\t'))
+#define BENCH_UPPER(c)  ((((c) >= 'a') && ((c) <= 'z')) ? ((c) - 'a' + 'A') : (c))
+
+FILE *sim_deb = NULL;
+FILE *sim_log = NULL;
+
+int Fprintf (FILE *f, const char *fmt, ...)
+{
+va_list arglist;
+int r;
+
+va_start (arglist, fmt);
+r = vfprintf (f, fmt, arglist);
+va_end (arglist);
+return r;
+}
+
+void sim_printf (const char *fmt, ...)
+{
+va_list arglist;
+
+va_start (arglist, fmt);
+vprintf (fmt, arglist);
+va_end (arglist);
+}
+
+void _sim_debug_device (uint32 dbits, DEVICE* dptr, const char* fmt, ...)
+{
+}
+
+int sim_strncasecmp (const char *string1, const char *string2, size_t len)
+{
+size_t i;
+int c1, c2;
+
+for (i = 0; i < len; i++) {
+    c1 = BENCH_UPPER (string1[i]);
+    c2 = BENCH_UPPER (string2[i]);
+    if (c1 != c2)
+        return (c1 < c2) ? -1 : 1;
+    if (c1 == 0)
+        break;
+    }
+return 0;
+}
+
+static CONST char *bench_glyph (const char *iptr, char *optr, char mchar, t_bool uc)
+{
+while (BENCH_SPACE (*iptr))
+    iptr++;
+while ((*iptr != 0) && !BENCH_SPACE (*iptr) && (*iptr != mchar)) {
+    *optr++ = uc ? BENCH_UPPER (*iptr) : *iptr;
+    iptr++;
+    }
+*optr = 0;
+if ((mchar != 0) && (*iptr == mchar))
+    iptr++;
+while (BENCH_SPACE (*iptr))
+    iptr++;
+return iptr;
+}
+
+CONST char *get_glyph (const char *iptr, char *optr, char mchar)
+{
+return bench_glyph (iptr, optr, mchar, TRUE);
+}
+
+CONST char *get_glyph_nc (const char *iptr, char *optr, char mchar)
+{
+return bench_glyph (iptr, optr, mchar, FALSE);
+}
+
+static double bench_ms (void)
+{
+struct timeval now;
+
+gettimeofday (&now, NULL);
+return (now.tv_sec * 1000.0) + (now.tv_usec / 1000.0);
+}
+
+/* Internet checksum over buf, starting from a partial sum */
+
+static uint32 bench_sum (uint32 sum, const uint8 *buf, int len)
+{
+while (len > 1) {
+    sum += GET16 (buf);
+    buf += 2;
+    len -= 2;
+    }
+if (len)
+    sum += buf[0] << 8;
+return sum;
+}
+
+static uint16 bench_cksum (uint32 sum)
+{
+while (sum >> 16)
+    sum = (sum & 0xFFFF) + (sum >> 16);
+return (uint16)~sum;
+}
+
+/* Guest side: build and transmit an ARP request or a TCP segment */
+
+static void guest_arp (GUEST *g)
+{
+uint8 pkt[60];
+
+memset (pkt, 0, sizeof (pkt));
+memset (pkt, 0xFF, 6);                                  /* broadcast */
+memcpy (pkt + 6, guest_mac, 6);
+PUT16 (pkt + 12, 0x0806);
+PUT16 (pkt + 14, 1);                                    /* Ethernet */
+PUT16 (pkt + 16, 0x0800);                               /* IP */
+pkt[18] = 6;
+pkt[19] = 4;
+PUT16 (pkt + 20, 1);                                    /* request */
+memcpy (pkt + 22, guest_mac, 6);
+memcpy (pkt + 28, guest_ip, 4);
+memcpy (pkt + 38, gw_ip, 4);
+sim_slirp_send (g->slirp, (char *)pkt, sizeof (pkt), 0);
+}
+
+static void guest_tcp (GUEST *g, uint32 flags, uint32 seq, int len)
+{
+uint8 pkt[ETH_HDR + IP_HDR + TCP_HDR + 4 + BENCH_MSS];
+uint8 *ip = pkt + ETH_HDR;
+uint8 *tcp = ip + IP_HDR;
+int hlen = TCP_HDR + ((flags & TH_SYN) ? 4 : 0);
+uint32 sum;
+static uint16 ip_id = 0;
+
+memcpy (pkt, g->gw_mac, 6);
+memcpy (pkt + 6, guest_mac, 6);
+PUT16 (pkt + 12, 0x0800);
+ip[0] = 0x45;
+ip[1] = 0;
+PUT16 (ip + 2, IP_HDR + hlen + len);
+PUT16 (ip + 4, ++ip_id);
+PUT16 (ip + 6, 0x4000);                                 /* don't fragment */
+ip[8] = 64;
+ip[9] = 6;                                              /* TCP */
+PUT16 (ip + 10, 0);
+memcpy (ip + 12, guest_ip, 4);
+memcpy (ip + 16, gw_ip, 4);
+PUT16 (ip + 10, bench_cksum (bench_sum (0, ip, IP_HDR)));
+PUT16 (tcp, g->lport);
+PUT16 (tcp + 2, g->rport);
+PUT32 (tcp + 4, seq);
+PUT32 (tcp + 8, (flags & TH_ACK) ? g->rcv_nxt : 0);
+tcp[12] = (uint8)((hlen / 4) << 4);
+tcp[13] = (uint8)flags;
+PUT16 (tcp + 14, BENCH_WINDOW);
+PUT16 (tcp + 16, 0);
+PUT16 (tcp + 18, 0);
+if (flags & TH_SYN) {
+    tcp[20] = 2;                                        /* MSS option */
+    tcp[21] = 4;
+    PUT16 (tcp + 22, BENCH_MSS);
+    }
+memcpy (tcp + hlen, payload, len);
+sum = bench_sum (0, ip + 12, 8);                        /* pseudo header */
+sum += 6 + hlen + len;
+PUT16 (tcp + 16, bench_cksum (bench_sum (sum, tcp, hlen + len)));
+sim_slirp_send (g->slirp, (char *)pkt, ETH_HDR + IP_HDR + hlen + len, 0);
+}
+
+/* Guest side: packets from the NAT engine */
+
+static void guest_receive (void *opaque, const unsigned char *buf, int len)
+{
+GUEST *g = (GUEST *)opaque;
+const uint8 *ip = buf + ETH_HDR;
+const uint8 *tcp;
+uint32 flags, seq, ack, dlen;
+int ihl, thl;
+
+if (len < ETH_HDR + 28)
+    return;
+if (GET16 (buf + 12) == 0x0806) {                       /* ARP */
+    if ((GET16 (buf + 20) == 2) &&                      /* reply from gateway? */
+        (memcmp (buf + 28, gw_ip, 4) == 0)) {
+        memcpy (g->gw_mac, buf + 22, 6);
+        g->gw_known = TRUE;
+        }
+    return;
+    }
+if ((GET16 (buf + 12) != 0x0800) || (ip[9] != 6))       /* TCP only */
+    return;
+ihl = (ip[0] & 0xF) * 4;
+tcp = ip + ihl;
+thl = (tcp[12] >> 4) * 4;
+if ((GET16 (tcp) != g->rport) || (GET16 (tcp + 2) != g->lport) ||
+    (g->state == GTCP_CLOSED))
+    return;
+flags = tcp[13];
+seq = GET32 (tcp + 4);
+ack = GET32 (tcp + 8);
+dlen = GET16 (ip + 2) - ihl - thl;
+if (flags & TH_RST) {
+    g->state = GTCP_FAILED;
+    return;
+    }
+if (g->state == GTCP_SYN_SENT) {
+    if ((flags & (TH_SYN | TH_ACK)) != (TH_SYN | TH_ACK))
+        return;
+    if (!(flags & TH_ACK) || (ack != g->snd_una + 1))
+        return;
+    g->snd_una = g->snd_nxt = g->snd_max = ack;
+    g->snd_end = ack + g->snd_bytes;
+    g->snd_wnd = GET16 (tcp + 14);
+    g->rcv_nxt = seq + 1;
+    g->state = GTCP_ESTABLISHED;
+    g->ack_needed = TRUE;
+    return;
+    }
+else if (dlen || (flags & TH_FIN)) {
+    if (seq == g->rcv_nxt) {                            /* in order? */
+        g->rcv_nxt += dlen;
+        g->received += dlen;
+        if (flags & TH_FIN)
+            g->rcv_nxt += 1;
+        g->progress = bench_ms ();
+        }
+    g->ack_needed = TRUE;                               /* ack or dup ack */
+    }
+if (flags & TH_ACK) {
+    if (SEQ_GT (ack, g->snd_una) && !SEQ_GT (ack, g->snd_max)) {
+        g->snd_una = ack;
+        if (SEQ_LT (g->snd_nxt, ack))
+            g->snd_nxt = ack;
+        g->progress = bench_ms ();
+        }
+    g->snd_wnd = GET16 (tcp + 14);
+    }
+}
+
+/* Guest side: send what the window allows, and any pending ack */
+
+static void guest_output (GUEST *g)
+{
+uint32 len;
+
+while (SEQ_LT (g->snd_nxt, g->snd_end) &&
+       ((g->snd_nxt - g->snd_una) + BENCH_MSS <= g->snd_wnd)) {
+    len = g->snd_end - g->snd_nxt;
+    if (len > BENCH_MSS)
+        len = BENCH_MSS;
+    guest_tcp (g, TH_ACK | TH_PUSH, g->snd_nxt, len);
+    g->snd_nxt += len;
+    if (SEQ_GT (g->snd_nxt, g->snd_max))
+        g->snd_max = g->snd_nxt;
+    g->ack_needed = FALSE;
+    }
+if (g->ack_needed) {
+    guest_tcp (g, TH_ACK, g->snd_nxt, 0);
+    g->ack_needed = FALSE;
+    }
+}
+
+/* One pass of the NAT engine, as the device reader thread makes it */
+
+static void bench_pass (GUEST *g)
+{
+if (sim_slirp_select (g->slirp, 10) > 0)
+    sim_slirp_dispatch (g->slirp);
+}
+
+/* Connect to the host side and move total bytes in one direction */
+
+static t_stat guest_transfer (GUEST *g, HOST *h, uint16 lport, t_bool upload, double *elapsed)
+{
+double start = 0, now, sent_syn = 0;
+t_bool done = FALSE;
+
+g->state = GTCP_SYN_SENT;
+g->lport = lport;
+g->snd_una = g->snd_nxt = g->snd_max = g->snd_end = 0x10000000;
+g->snd_bytes = upload ? (uint32)h->total : 0;
+g->snd_wnd = 0;
+g->rcv_nxt = 0;
+g->received = 0;
+g->ack_needed = FALSE;
+g->progress = bench_ms ();
+while (!done) {
+    now = bench_ms ();
+    if (g->state == GTCP_FAILED) {
+        printf ("Connection reset by the NAT engine\n");
+        return SCPE_IOERR;
+        }
+    if (now - g->progress > BENCH_STALL_MS) {
+        printf ("Transfer stalled\n");
+        return SCPE_IOERR;
+        }
+    if (g->state == GTCP_SYN_SENT) {
+        if (now - sent_syn > 1000) {
+            guest_tcp (g, TH_SYN, g->snd_una, 0);
+            sent_syn = now;
+            }
+        }
+    else {
+        if (start == 0)                                 /* just connected? */
+            start = now;
+        if (SEQ_LT (g->snd_una, g->snd_max) &&
+            (now - g->progress > BENCH_RTO_MS)) {
+            g->snd_nxt = g->snd_una;                    /* go back */
+            g->progress = now;
+            }
+        guest_output (g);
+        }
+    bench_pass (g);
+    if (upload) {
+        pthread_mutex_lock (&h->lock);
+        done = (h->received >= h->total);
+        pthread_mutex_unlock (&h->lock);
+        }
+    else
+        done = (g->received >= h->total);
+    if (h->failed) {
+        printf ("Host side socket error\n");
+        return SCPE_IOERR;
+        }
+    }
+*elapsed = bench_ms () - start;
+guest_tcp (g, TH_RST | TH_ACK, g->snd_nxt, 0);
+g->state = GTCP_CLOSED;
+bench_pass (g);
+return SCPE_OK;
+}
+
+/* Host side: sink the first connection, source the second */
+
+static void *host_side (void *arg)
+{
+HOST *h = (HOST *)arg;
+static char buf[65536];
+SOCKET s;
+t_uint64 sent = 0;
+int n;
+
+s = accept (h->master, NULL, NULL);
+if (s == INVALID_SOCKET) {
+    h->failed = TRUE;
+    return NULL;
+    }
+while ((n = recv (s, buf, sizeof (buf), 0)) > 0) {
+    pthread_mutex_lock (&h->lock);
+    h->received += n;
+    pthread_mutex_unlock (&h->lock);
+    }
+closesocket (s);
+s = accept (h->master, NULL, NULL);
+if (s == INVALID_SOCKET) {
+    h->failed = TRUE;
+    return NULL;
+    }
+while (sent < h->total) {
+    n = (int)(((h->total - sent) < sizeof (buf)) ? (h->total - sent) : sizeof (buf));
+    n = send (s, buf, n, 0);
+    if (n <= 0) {
+        h->failed = TRUE;
+        break;
+        }
+    sent += n;
+    }
+closesocket (s);
+return NULL;
+}
+
+static void bench_report (const char *what, t_uint64 bytes, double ms)
+{
+printf ("  %s: %8.1f MB/s  (%.0f ms)\n", what, (bytes / (1024.0 * 1024.0)) / (ms / 1000.0), ms);
+}
+
+int main (int argc, char *argv[])
+{
+GUEST g;
+HOST h;
+struct sockaddr_in addr;
+pthread_t host_thread;
+double up_ms, down_ms;
+int megabytes = (argc > 1) ? atoi (argv[1]) : 64;
+int port = (argc > 2) ? atoi (argv[2]) : 5201;
+int on = 1;
+double start;
+
+if ((megabytes <= 0) || (megabytes > 4000) || (port <= 0) || (port > 65535)) {
+    fprintf (stderr, "Usage: natbench {megabytes {port}}\n");
+    return 1;
+    }
+#if defined(SIGPIPE)
+signal (SIGPIPE, SIG_IGN);
+#endif
+memset (&g, 0, sizeof (g));
+memset (&h, 0, sizeof (h));
+h.total = (t_uint64)megabytes * 1024 * 1024;
+pthread_mutex_init (&h.lock, NULL);
+g.rport = (uint16)port;
+
+sim_init_sock ();
+h.master = socket (AF_INET, SOCK_STREAM, 0);
+setsockopt (h.master, SOL_SOCKET, SO_REUSEADDR, (char *)&on, sizeof (on));
+memset (&addr, 0, sizeof (addr));
+addr.sin_family = AF_INET;
+addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+addr.sin_port = htons ((uint16)port);
+if ((h.master == INVALID_SOCKET) ||
+    bind (h.master, (struct sockaddr *)&addr, sizeof (addr)) ||
+    listen (h.master, 2)) {
+    fprintf (stderr, "Can't listen on 127.0.0.1:%d\n", port);
+    return 1;
+    }
+g.slirp = sim_slirp_open ("", &g, &guest_receive, NULL, 0);
+if (g.slirp == NULL) {
+    fprintf (stderr, "Can't open the NAT engine\n");
+    return 1;
+    }
+pthread_create (&host_thread, NULL, &host_side, &h);
+
+start = bench_ms ();
+while (!g.gw_known) {                                   /* resolve the gateway */
+    if (bench_ms () - start > BENCH_STALL_MS) {
+        fprintf (stderr, "No ARP reply from the NAT gateway\n");
+        return 1;
+        }
+    guest_arp (&g);
+    bench_pass (&g);
+    }
+printf ("NAT throughput, %d MB each way, guest 10.0.2.15 to 10.0.2.2:%d\n", megabytes, port);
+if (guest_transfer (&g, &h, 40000, TRUE, &up_ms) != SCPE_OK)
+    return 1;
+bench_report ("guest to host", h.total, up_ms);
+if (guest_transfer (&g, &h, 40001, FALSE, &down_ms) != SCPE_OK)
+    return 1;
+bench_report ("host to guest", h.total, down_ms);
+pthread_join (host_thread, NULL);
+sim_slirp_show (g.slirp, stdout);
+sim_slirp_close (g.slirp);
+closesocket (h.master);
+sim_cleanup_sock ();
+return 0;
+}
@@ -155,8 +155,16 @@ struct sim_slirp {
     GArray *gpollfds;
     SOCKET db_chime;            /* write packet doorbell */
     struct slirp_write_request *write_requests;
+    struct slirp_write_request *write_requests_last;
     struct slirp_write_request *write_buffers;
     pthread_mutex_t write_buffer_lock;
+    struct slirp_write_request *output_requests;    /* packets for the guest awaiting batch delivery */
+    struct slirp_write_request *output_requests_last;
+    uint32 input_packets;       /* packets from the guest */
+    uint32 output_packets;      /* packets to the guest */
+    uint32 output_batches;      /* batches delivered to the guest */
+    uint32 output_batch_max;    /* largest batch delivered */
+    uint32 dispatches;          /* event loop passes */
     void *opaque;               /* opaque value passed during packet delivery */
     packet_callback callback;   /* slirp arriving packet delivery callback */
     DEVICE *dptr;
@@ -392,6 +400,10 @@ if (slirp) {
             slirp->write_requests = buffer->next;
             free(buffer);
             }
+        while (NULL != (buffer = slirp->output_requests)) {
+            slirp->output_requests = buffer->next;
+            free(buffer);
+            }
         }
     pthread_mutex_destroy (&slirp->write_buffer_lock);
     if (slirp->slirp)
@@ -468,18 +480,13 @@ memcpy(request->msg, msg, len);
 /* packets make it to the wire in the order they were presented here) */
 pthread_mutex_lock (&slirp->write_buffer_lock);
 request->next = NULL;
-if (slirp->write_requests) {
-    struct slirp_write_request *last_request = slirp->write_requests;
-
-    while (last_request->next) {
-        last_request = last_request->next;
-        }
-    last_request->next = request;
-    }
+if (slirp->write_requests)
+    slirp->write_requests_last->next = request;
 else {
     slirp->write_requests = request;
     wake_needed = 1;
     }
+slirp->write_requests_last = request;
 pthread_mutex_unlock (&slirp->write_buffer_lock);
 
 if (wake_needed)
@@ -487,11 +494,33 @@ if (wake_needed)
 return len;
 }
 
+/* Packets which slirp produces for the guest are collected while the   */
+/* event loop runs and are handed to the device in one batch at the end */
+/* of each pass (see sim_slirp_dispatch)                                */
 void slirp_output (void *opaque, const uint8_t *pkt, int pkt_len)
 {
 SLIRP *slirp = (SLIRP *)opaque;
+struct slirp_write_request *request;
 
-slirp->callback (slirp->opaque, pkt, pkt_len);
+if ((size_t)pkt_len > sizeof (request->msg)) {
+    slirp->callback (slirp->opaque, pkt, pkt_len);
+    ++slirp->output_packets;
+    return;
+    }
+pthread_mutex_lock (&slirp->write_buffer_lock);
+if (NULL != (request = slirp->write_buffers))
+    slirp->write_buffers = request->next;
+pthread_mutex_unlock (&slirp->write_buffer_lock);
+if (NULL == request)
+    request = (struct slirp_write_request *)g_malloc(sizeof(*request));
+request->len = pkt_len;
+memcpy(request->msg, pkt, pkt_len);
+request->next = NULL;
+if (slirp->output_requests)
+    slirp->output_requests_last->next = request;
+else
+    slirp->output_requests = request;
+slirp->output_requests_last = request;
 }
 
 void sim_slirp_show (SLIRP *slirp, FILE *st)
@@ -526,6 +555,14 @@ while (rtmp) {
     fprintf (st, "        redir %3s     =%d:%s:%d\n", tcpudp[rtmp->is_udp], rtmp->lport, inet_ntoa(rtmp->inaddr), rtmp->port);
     rtmp = rtmp->next;
     }
+if (slirp->dispatches) {
+    fprintf (st, "NAT statistics:\n");
+    fprintf (st, "        packets in    =%u\n", slirp->input_packets);
+    fprintf (st, "        packets out   =%u\n", slirp->output_packets);
+    if (slirp->output_batches)
+        fprintf (st, "        batches out   =%u (avg %.1f, max %u packets)\n", slirp->output_batches, (double)slirp->output_packets / slirp->output_batches, slirp->output_batch_max);
+    fprintf (st, "        loop passes   =%u\n", slirp->dispatches);
+    }
 slirp_connection_info (slirp->slirp, (Monitor *)st);
 }
 
@@ -628,28 +665,71 @@ if (select_ret) {
 return select_ret + 1;  /* Force dispatch even on timeout */
 }
 
-void sim_slirp_dispatch (SLIRP *slirp)
+static void _sim_slirp_input (SLIRP *slirp)
 {
-struct slirp_write_request *request;
-
-/* first deliver any transmit packets which are pending */
+struct slirp_write_request *requests, *request, *last = NULL;
 
+/* Take the whole pending transmit list at once */
 pthread_mutex_lock (&slirp->write_buffer_lock);
-while (NULL != (request = slirp->write_requests)) {
-    /* Pull buffer off request list */
-    slirp->write_requests = request->next;
-    pthread_mutex_unlock (&slirp->write_buffer_lock);
+requests = slirp->write_requests;
+slirp->write_requests = slirp->write_requests_last = NULL;
+pthread_mutex_unlock (&slirp->write_buffer_lock);
+if (requests == NULL)
+    return;
 
+for (request = requests; request != NULL; request = request->next) {
     slirp_input (slirp->slirp, (const uint8_t *)request->msg, (int)request->len);
+    ++slirp->input_packets;
+    last = request;
+    }
+
+/* Put buffers on free buffer list */
+pthread_mutex_lock (&slirp->write_buffer_lock);
+last->next = slirp->write_buffers;
+slirp->write_buffers = requests;
+pthread_mutex_unlock (&slirp->write_buffer_lock);
+}
+
+static void _sim_slirp_output (SLIRP *slirp)
+{
+struct slirp_write_request *requests, *request, *last = NULL;
+uint32 count = 0;
+
+requests = slirp->output_requests;
+slirp->output_requests = slirp->output_requests_last = NULL;
+if (requests == NULL)
+    return;
 
-    pthread_mutex_lock (&slirp->write_buffer_lock);
-    /* Put buffer on free buffer list */
-    request->next = slirp->write_buffers;
-    slirp->write_buffers = request;
+for (request = requests; request != NULL; request = request->next) {
+    slirp->callback (slirp->opaque, (const unsigned char *)request->msg, (int)request->len);
+    ++count;
+    last = request;
     }
+slirp->output_packets += count;
+++slirp->output_batches;
+if (count > slirp->output_batch_max)
+    slirp->output_batch_max = count;
+
+/* Put buffers on free buffer list */
+pthread_mutex_lock (&slirp->write_buffer_lock);
+last->next = slirp->write_buffers;
+slirp->write_buffers = requests;
 pthread_mutex_unlock (&slirp->write_buffer_lock);
+}
+
+void sim_slirp_dispatch (SLIRP *slirp)
+{
+++slirp->dispatches;
+
+/* first deliver any transmit packets which are pending */
+_sim_slirp_input (slirp);
 
 slirp_pollfds_poll(slirp->gpollfds, 0);
 
+/* then any which arrived while the host sockets were serviced */
+_sim_slirp_input (slirp);
+
+/* and finally hand everything produced for the guest over as one batch */
+_sim_slirp_output (slirp);
 }
 